@@ -0,0 +1,575 @@
+//
+//! Copyright © 2026
+//! Brandon Kohn
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+#ifndef GEOMETRIX_AABB_TREE_HPP
+#define GEOMETRIX_AABB_TREE_HPP
+#pragma once
+
+#include <geometrix/primitive/axis_aligned_bounding_box.hpp>
+#include <geometrix/algorithm/distance/aabb_aabb_distance.hpp>
+#include <geometrix/algorithm/distance/point_aabb_distance.hpp>
+#include <geometrix/algorithm/intersection/ray_aabb_intersection.hpp>
+#include <geometrix/algorithm/intersection/segment_aabb_intersection.hpp>
+#include <geometrix/utility/assert.hpp>
+#include <geometrix/utility/executor.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace geometrix {
+
+    //! How aabb_tree chooses the partition of the items under a node.
+    enum class aabb_tree_split
+    {
+        median //! Split at the median centroid along the longest axis of the centroid bounds.
+      , sah    //! Split at the best of a set of binned candidates along the longest axis by the surface area heuristic, or at the median when no candidate is cheaper than a leaf.
+    };
+
+    //! \brief A static bounding volume hierarchy over items with axis aligned bounds.
+
+    //! The tree is bulk built top down by median or binned surface area heuristic splits. Nodes are stored depth first in a
+    //! single array: the first child of an internal node follows it and the node stores the index of its second child. Leaves
+    //! refer to contiguous ranges of the items which are stored with their bounds in leaf order.
+    //! The bounds of each item are given by a function bounds(item) returning an axis_aligned_bounding_box<Point>.
+    //! \code
+    //! aabb_tree<segment2, point2> tree(segments, [](const segment2& s){ return make_aabb<point2>(s); });
+    //! tree.search(box, [](const segment2& s){ ... });
+    //! \endcode
+    template <typename T, typename Point>
+    class aabb_tree
+    {
+    public:
+
+        using value_type = T;
+        using point_type = Point;
+        using box_type = axis_aligned_bounding_box<Point>;
+        using length_type = typename arithmetic_type_of<Point>::type;
+
+        BOOST_STATIC_CONSTANT(std::size_t, dimension = dimension_of<Point>::value);
+        BOOST_STATIC_CONSTANT(std::size_t, default_leaf_size = 4);
+        BOOST_STATIC_CONSTANT(std::size_t, default_parallel_threshold = 4096);
+        BOOST_STATIC_CONSTANT(std::size_t, number_of_bins = 16);
+
+        struct node
+        {
+            node(const box_type& box, std::uint32_t first, std::uint32_t count)
+                : box(box)
+                , first(first)
+                , count(count)
+            {}
+
+            box_type      box;
+            std::uint32_t first;//! the first item of a leaf or the index of the second child of an internal node.
+            std::uint32_t count;//! the number of items of a leaf or 0 for an internal node.
+
+            bool is_leaf() const { return count != 0; }
+        };
+
+        template <typename Range, typename BoundsFn>
+        aabb_tree(const Range& items, BoundsFn&& bounds, aabb_tree_split split = aabb_tree_split::sah, std::size_t leafSize = default_leaf_size)
+            : m_split(split)
+            , m_leafSize((std::max)(leafSize, std::size_t(1)))
+        {
+            serial_executor executor;
+            build(items, bounds, executor, (std::numeric_limits<std::size_t>::max)());
+        }
+
+        //! Build the tree using executor to compute the item bounds and to build the subtrees of nodes over more than parallelThreshold items concurrently.
+        //! The resulting tree is identical to the one built by the serial constructor.
+        template <typename Range, typename BoundsFn, typename Executor, typename std::enable_if<is_executor<typename std::decay<Executor>::type>::value, int>::type = 0>
+        aabb_tree(const Range& items, BoundsFn&& bounds, Executor&& executor, aabb_tree_split split = aabb_tree_split::sah, std::size_t leafSize = default_leaf_size, std::size_t parallelThreshold = default_parallel_threshold)
+            : m_split(split)
+            , m_leafSize((std::max)(leafSize, std::size_t(1)))
+        {
+            build(items, bounds, executor, (std::max)(parallelThreshold, std::size_t(1)));
+        }
+
+        std::size_t              size() const { return m_items.size(); }
+        bool                     empty() const { return m_items.empty(); }
+        const std::vector<node>& get_nodes() const { return m_nodes; }
+
+        //! The items and their bounds in leaf order.
+        const std::vector<T>&        get_items() const { return m_items; }
+        const std::vector<box_type>& get_item_bounds() const { return m_boxes; }
+
+        //! Visit each item whose bounds intersect range.
+        template <typename P, typename Visitor>
+        void search(const axis_aligned_bounding_box<P>& range, Visitor&& visitor) const
+        {
+            traverse([&range](const box_type& b) { return b.intersects(range); }, visitor);
+        }
+
+        //! Visit each item whose bounds meet the segment from p0 to p1.
+        template <typename Point1, typename Point2, typename Visitor>
+        void segment_search(const Point1& p0, const Point2& p1, Visitor&& visitor) const
+        {
+            traverse([&p0, &p1](const box_type& b) { return segment_aabb_intersection(p0, p1, b); }, visitor);
+        }
+
+        //! Visit each item whose bounds are hit by the ray from p in the direction d. (2D)
+        template <typename Point1, typename Vector, typename Visitor, typename NumberComparisonPolicy>
+        void ray_search(const Point1& p, const Vector& d, Visitor&& visitor, const NumberComparisonPolicy& cmp) const
+        {
+            traverse([&p, &d, &cmp](const box_type& b)
+            {
+                length_type t;
+                point_type q;
+                return ray_aabb_intersection(p, d, b, t, q, cmp).is_intersecting();
+            }, visitor);
+        }
+
+        //! Find the first item hit by the ray from p in the direction d. (2D)
+        //! The intersector is called as intersect(item, ti) and returns whether the ray hits the item setting ti to the ray parameter of the hit.
+        //! Nodes are visited nearest first and those entered beyond the nearest hit found are skipped.
+        //! On input t limits the search; on output it holds the parameter of the hit. Returns the item hit or nullptr.
+        template <typename Point1, typename Vector, typename Intersector, typename Scalar, typename NumberComparisonPolicy>
+        const T* ray_cast(const Point1& p, const Vector& d, Intersector&& intersect, Scalar& t, const NumberComparisonPolicy& cmp) const
+        {
+            const T* result = nullptr;
+            if (m_nodes.empty())
+                return result;
+
+            auto entrance = [&p, &d, &cmp](const box_type& b, Scalar& tb)
+            {
+                point_type q;
+                return ray_aabb_intersection(p, d, b, tb, q, cmp).is_intersecting();
+            };
+
+            Scalar t0;
+            if (entrance(m_nodes[0].box, t0) && t0 <= t)
+                ray_cast_node(0, entrance, intersect, t, result);
+            return result;
+        }
+
+        //! Find the item nearest to p. distanceSqrd(item) gives the squared distance from p to an item.
+        //! On input d2 limits the search; on output it holds the squared distance to the nearest item. Returns the item or nullptr.
+        template <typename Point1, typename ItemDistanceSqrd, typename Area>
+        const T* nearest(const Point1& p, ItemDistanceSqrd&& distanceSqrd, Area& d2, typename std::enable_if<is_point<Point1>::value>::type* = nullptr) const
+        {
+            return nearest_search([&p](const box_type& b) { return point_aabb_distance_sqrd(p, b); }, distanceSqrd, d2);
+        }
+
+        //! Find the item nearest to the box. distanceSqrd(item) gives the squared distance from the box to an item.
+        template <typename ItemDistanceSqrd, typename Area>
+        const T* nearest(const box_type& box, ItemDistanceSqrd&& distanceSqrd, Area& d2) const
+        {
+            return nearest_search([&box](const box_type& b) { return aabb_aabb_distance_sqrd(box, b); }, distanceSqrd, d2);
+        }
+
+    private:
+
+        using coordinates = std::array<length_type, dimension>;
+
+        template <std::size_t... I>
+        static coordinates to_coordinates(const point_type& p, std::index_sequence<I...>)
+        {
+            return coordinates{ { get<I>(p)... } };
+        }
+
+        static coordinates to_coordinates(const point_type& p)
+        {
+            return to_coordinates(p, std::make_index_sequence<dimension>());
+        }
+
+        //! The surface area (perimeter in 2D) of the box with extents e relative to a unit of length.
+        static double relative_area(const coordinates& e, length_type unit)
+        {
+            std::array<double, dimension> r;
+            for (std::size_t i = 0; i < dimension; ++i)
+                r[i] = static_cast<double>(e[i] / unit);
+
+            double area = 0;
+            if (dimension == 2)
+                return r[0] + r[1];
+            for (std::size_t i = 0; i < dimension; ++i)
+                for (std::size_t j = i + 1; j < dimension; ++j)
+                    area += r[i] * r[j];
+            return area;
+        }
+
+        template <typename NodeTest, typename Visitor>
+        void traverse(NodeTest&& test, Visitor& visitor) const
+        {
+            if (!m_nodes.empty() && test(m_nodes[0].box))
+                traverse_node(0, test, visitor);
+        }
+
+        template <typename NodeTest, typename Visitor>
+        void traverse_node(std::size_t index, NodeTest& test, Visitor& visitor) const
+        {
+            const node& n = m_nodes[index];
+            if (n.is_leaf())
+            {
+                for (std::size_t i = n.first; i < n.first + n.count; ++i)
+                    if (test(m_boxes[i]))
+                        visitor(m_items[i]);
+                return;
+            }
+
+            if (test(m_nodes[index + 1].box))
+                traverse_node(index + 1, test, visitor);
+            if (test(m_nodes[n.first].box))
+                traverse_node(n.first, test, visitor);
+        }
+
+        template <typename Entrance, typename Intersector, typename Scalar>
+        void ray_cast_node(std::size_t index, Entrance& entrance, Intersector& intersect, Scalar& t, const T*& result) const
+        {
+            const node& n = m_nodes[index];
+            if (n.is_leaf())
+            {
+                for (std::size_t i = n.first; i < n.first + n.count; ++i)
+                {
+                    Scalar ti;
+                    if (entrance(m_boxes[i], ti) && ti <= t && intersect(m_items[i], ti) && ti < t)
+                    {
+                        t = ti;
+                        result = &m_items[i];
+                    }
+                }
+                return;
+            }
+
+            std::size_t a = index + 1, b = n.first;
+            Scalar ta, tb;
+            bool hitA = entrance(m_nodes[a].box, ta), hitB = entrance(m_nodes[b].box, tb);
+            if (hitA && hitB && tb < ta)
+            {
+                std::swap(a, b);
+                std::swap(ta, tb);
+            }
+            else if (!hitA)
+            {
+                a = b;
+                ta = tb;
+                hitA = hitB;
+                hitB = false;
+            }
+
+            if (hitA && ta <= t)
+                ray_cast_node(a, entrance, intersect, t, result);
+            if (hitB && tb <= t)
+                ray_cast_node(b, entrance, intersect, t, result);
+        }
+
+        template <typename NodeDistanceSqrd, typename ItemDistanceSqrd, typename Area>
+        const T* nearest_search(NodeDistanceSqrd&& nodeDistanceSqrd, ItemDistanceSqrd& distanceSqrd, Area& d2) const
+        {
+            const T* result = nullptr;
+            if (!m_nodes.empty() && nodeDistanceSqrd(m_nodes[0].box) <= d2)
+                nearest_node(0, nodeDistanceSqrd, distanceSqrd, d2, result);
+            return result;
+        }
+
+        template <typename NodeDistanceSqrd, typename ItemDistanceSqrd, typename Area>
+        void nearest_node(std::size_t index, NodeDistanceSqrd& nodeDistanceSqrd, ItemDistanceSqrd& distanceSqrd, Area& d2, const T*& result) const
+        {
+            const node& n = m_nodes[index];
+            if (n.is_leaf())
+            {
+                for (std::size_t i = n.first; i < n.first + n.count; ++i)
+                {
+                    if (nodeDistanceSqrd(m_boxes[i]) > d2)
+                        continue;
+                    Area di = distanceSqrd(m_items[i]);
+                    if (di < d2 || (result == nullptr && di <= d2))
+                    {
+                        d2 = di;
+                        result = &m_items[i];
+                    }
+                }
+                return;
+            }
+
+            //! Descend into the nearer child first so the farther one is more likely to be pruned.
+            std::size_t a = index + 1, b = n.first;
+            Area da = nodeDistanceSqrd(m_nodes[a].box), db = nodeDistanceSqrd(m_nodes[b].box);
+            if (db < da)
+            {
+                std::swap(a, b);
+                std::swap(da, db);
+            }
+
+            if (da <= d2)
+                nearest_node(a, nodeDistanceSqrd, distanceSqrd, d2, result);
+            if (db <= d2)
+                nearest_node(b, nodeDistanceSqrd, distanceSqrd, d2, result);
+        }
+
+        template <typename Range, typename BoundsFn, typename Executor>
+        void build(const Range& items, BoundsFn& bounds, Executor& executor, std::size_t parallelThreshold)
+        {
+            auto first = std::begin(items);
+            std::size_t n = std::distance(first, std::end(items));
+            GEOMETRIX_ASSERT(n < (std::numeric_limits<std::uint32_t>::max)());
+            if (n == 0)
+                return;
+
+            std::vector<const T*> pItems(n);
+            std::size_t i = 0;
+            for (const auto& item : items)
+                pItems[i++] = &item;
+
+            m_boxes.assign(n, box_type(point_type(), point_type()));
+            m_centroids.resize(n);
+            parallel_for(executor, n, (std::min)(parallelThreshold, default_grain_size(n)), [&](std::size_t j, std::size_t last)
+            {
+                for (; j < last; ++j)
+                {
+                    m_boxes[j] = bounds(*pItems[j]);
+                    coordinates lo = to_coordinates(m_boxes[j].get_lower_bound()), hi = to_coordinates(m_boxes[j].get_upper_bound());
+                    for (std::size_t d = 0; d < dimension; ++d)
+                        m_centroids[j][d] = (lo[d] + hi[d]) / constants::two<length_type>();
+                }
+            });
+
+            m_order.resize(n);
+            std::iota(m_order.begin(), m_order.end(), std::uint32_t(0));
+            m_nodes = build_subtree(executor, 0, n, parallelThreshold);
+
+            //! Store the items and their bounds in leaf order.
+            std::vector<box_type> boxes;
+            boxes.reserve(n);
+            m_items.reserve(n);
+            for (std::uint32_t k : m_order)
+            {
+                m_items.push_back(*pItems[k]);
+                boxes.push_back(m_boxes[k]);
+            }
+            m_boxes.swap(boxes);
+            m_centroids = std::vector<coordinates>();
+            m_order = std::vector<std::uint32_t>();
+        }
+
+        template <typename Executor>
+        std::vector<node> build_subtree(Executor& executor, std::size_t first, std::size_t last, std::size_t parallelThreshold)
+        {
+            std::vector<node> nodes;
+            if (last - first <= parallelThreshold)
+            {
+                build_serial(nodes, first, last);
+                return nodes;
+            }
+
+            box_type box = get_bounds(first, last);
+            std::size_t mid = partition(first, last, box);
+            if (mid == first)
+            {
+                nodes.emplace_back(box, static_cast<std::uint32_t>(first), static_cast<std::uint32_t>(last - first));
+                return nodes;
+            }
+
+            std::vector<node> left, right;
+            fork_join(executor
+              , [&]() { left = build_subtree(executor, first, mid, parallelThreshold); }
+              , [&]() { right = build_subtree(executor, mid, last, parallelThreshold); });
+
+            //! Splice the subtrees after their parent offsetting their child links.
+            std::uint32_t leftOffset = 1, rightOffset = static_cast<std::uint32_t>(1 + left.size());
+            nodes.reserve(1 + left.size() + right.size());
+            nodes.emplace_back(box, rightOffset, 0);
+            for (node n : left)
+            {
+                if (!n.is_leaf())
+                    n.first += leftOffset;
+                nodes.push_back(n);
+            }
+            for (node n : right)
+            {
+                if (!n.is_leaf())
+                    n.first += rightOffset;
+                nodes.push_back(n);
+            }
+            return nodes;
+        }
+
+        void build_serial(std::vector<node>& nodes, std::size_t first, std::size_t last)
+        {
+            std::size_t index = nodes.size();
+            box_type box = get_bounds(first, last);
+            nodes.emplace_back(box, static_cast<std::uint32_t>(first), static_cast<std::uint32_t>(last - first));
+            std::size_t mid = partition(first, last, box);
+            if (mid == first)
+                return;
+
+            nodes[index].count = 0;
+            build_serial(nodes, first, mid);
+            nodes[index].first = static_cast<std::uint32_t>(nodes.size());
+            build_serial(nodes, mid, last);
+        }
+
+        box_type get_bounds(std::size_t first, std::size_t last) const
+        {
+            box_type box = m_boxes[m_order[first]];
+            for (std::size_t i = first + 1; i < last; ++i)
+                box.expand(m_boxes[m_order[i]]);
+            return box;
+        }
+
+        //! Partition m_order[first, last) returning the start of the second part or first when the range should be a leaf.
+        std::size_t partition(std::size_t first, std::size_t last, const box_type& box)
+        {
+            if (last - first <= m_leafSize)
+                return first;
+
+            coordinates clo = m_centroids[m_order[first]], chi = clo;
+            for (std::size_t i = first + 1; i < last; ++i)
+            {
+                const coordinates& c = m_centroids[m_order[i]];
+                for (std::size_t d = 0; d < dimension; ++d)
+                {
+                    clo[d] = (std::min)(clo[d], c[d]);
+                    chi[d] = (std::max)(chi[d], c[d]);
+                }
+            }
+
+            std::size_t axis = 0;
+            for (std::size_t d = 1; d < dimension; ++d)
+                if (chi[axis] - clo[axis] < chi[d] - clo[d])
+                    axis = d;
+
+            //! All centroids coincide.
+            length_type extent = chi[axis] - clo[axis];
+            if (!(constants::zero<length_type>() < extent))
+                return first;
+
+            auto begin = m_order.begin();
+            if (m_split == aabb_tree_split::sah)
+            {
+                std::size_t split = sah_split(first, last, box, axis, clo[axis], extent);
+                if (split != 0)
+                {
+                    auto bin = [&](std::uint32_t k) { return get_bin(m_centroids[k][axis], clo[axis], extent); };
+                    return std::partition(begin + first, begin + last, [&](std::uint32_t k) { return bin(k) < split; }) - begin;
+                }
+            }
+
+            std::size_t mid = (first + last) / 2;
+            const auto& centroids = m_centroids;
+            std::nth_element(begin + first, begin + mid, begin + last, [&centroids, axis](std::uint32_t a, std::uint32_t b)
+            {
+                return centroids[a][axis] < centroids[b][axis] || (!(centroids[b][axis] < centroids[a][axis]) && a < b);
+            });
+            return mid;
+        }
+
+        static std::size_t get_bin(length_type c, length_type lo, length_type extent)
+        {
+            return (std::min)(static_cast<std::size_t>(number_of_bins * static_cast<double>((c - lo) / extent)), std::size_t(number_of_bins - 1));
+        }
+
+        //! The first bin of the second part of the split with the least surface area cost or 0 if no split is cheaper than a leaf.
+        std::size_t sah_split(std::size_t first, std::size_t last, const box_type& box, std::size_t axis, length_type lo, length_type extent) const
+        {
+            struct bin_bounds
+            {
+                std::size_t count = 0;
+                coordinates lo;
+                coordinates hi;
+            };
+
+            std::array<bin_bounds, number_of_bins> bins;
+            for (std::size_t i = first; i < last; ++i)
+            {
+                std::uint32_t k = m_order[i];
+                auto& b = bins[get_bin(m_centroids[k][axis], lo, extent)];
+                coordinates blo = to_coordinates(m_boxes[k].get_lower_bound()), bhi = to_coordinates(m_boxes[k].get_upper_bound());
+                if (b.count++ == 0)
+                {
+                    b.lo = blo;
+                    b.hi = bhi;
+                    continue;
+                }
+                for (std::size_t d = 0; d < dimension; ++d)
+                {
+                    b.lo[d] = (std::min)(b.lo[d], blo[d]);
+                    b.hi[d] = (std::max)(b.hi[d], bhi[d]);
+                }
+            }
+
+            //! Measure areas relative to the largest extent of the node.
+            coordinates nlo = to_coordinates(box.get_lower_bound()), nhi = to_coordinates(box.get_upper_bound()), e;
+            length_type unit = constants::zero<length_type>();
+            for (std::size_t d = 0; d < dimension; ++d)
+                unit = (std::max)(unit, nhi[d] - nlo[d]);
+
+            auto accumulate = [](bin_bounds& acc, const bin_bounds& b)
+            {
+                if (b.count == 0)
+                    return;
+                if (acc.count == 0)
+                {
+                    acc = b;
+                    return;
+                }
+                acc.count += b.count;
+                for (std::size_t d = 0; d < dimension; ++d)
+                {
+                    acc.lo[d] = (std::min)(acc.lo[d], b.lo[d]);
+                    acc.hi[d] = (std::max)(acc.hi[d], b.hi[d]);
+                }
+            };
+
+            auto cost = [&](const bin_bounds& b)
+            {
+                coordinates ext;
+                for (std::size_t d = 0; d < dimension; ++d)
+                    ext[d] = b.hi[d] - b.lo[d];
+                return b.count * relative_area(ext, unit);
+            };
+
+            //! Sweep from the right recording the cost of each suffix of bins then from the left to find the best split.
+            std::array<double, number_of_bins> rightCost;
+            bin_bounds right;
+            for (std::size_t i = number_of_bins - 1; i > 0; --i)
+            {
+                accumulate(right, bins[i]);
+                rightCost[i] = right.count ? cost(right) : -1.0;
+            }
+
+            for (std::size_t d = 0; d < dimension; ++d)
+                e[d] = nhi[d] - nlo[d];
+            double best = (last - first) * relative_area(e, unit);
+            std::size_t split = 0;
+            bin_bounds left;
+            for (std::size_t i = 1; i < number_of_bins; ++i)
+            {
+                accumulate(left, bins[i - 1]);
+                if (left.count == 0 || rightCost[i] < 0)
+                    continue;
+                double c = cost(left) + rightCost[i];
+                if (c < best)
+                {
+                    best = c;
+                    split = i;
+                }
+            }
+
+            return split;
+        }
+
+        aabb_tree_split            m_split;
+        std::size_t                m_leafSize;
+        std::vector<node>          m_nodes;//! the root is first; the first child of a node follows it.
+        std::vector<T>             m_items;
+        std::vector<box_type>      m_boxes;//! the bounds of m_items[i].
+        std::vector<coordinates>   m_centroids;//! build scratch: the centre of the bounds of each input item.
+        std::vector<std::uint32_t> m_order;//! build scratch: the input index of each item in leaf order.
+
+    };
+
+}//namespace geometrix;
+
+#endif //! GEOMETRIX_AABB_TREE_HPP
@@ -16,10 +16,10 @@
 #include <geometrix/primitive/point_traits.hpp>
 
 #include <boost/concept_check.hpp>
-#include <boost/container/flat_map.hpp>
 
-#include <map>
-#include <memory>
+#include <algorithm>
+#include <iterator>
+#include <vector>
 
 namespace geometrix {
  
@@ -204,7 +204,7 @@ namespace geometrix {
         {}
 
         template <typename EventQueue, typename SweepLine>
-		void operator()( EventQueue& eventQueue, SweepLine& sweepLine, const typename SweepLine::sweep_item_type* s1, const typename SweepLine::sweep_item_type* s2 )
+		void operator()( EventQueue& eventQueue, SweepLine& sweepLine, typename SweepLine::sweep_item_type* s1, typename SweepLine::sweep_item_type* s2 )
         {            
 			if( s1 != s2 )
 			{
@@ -221,7 +221,10 @@ namespace geometrix {
 
 					//Add the event if it is to the right of the sweep line.
 					if( m_compare.greater_than( x, positionX ) || (m_compare.equals( x, positionX ) && m_compare.greater_than( y, positionY )) )
-						eventQueue[xPoint[0]];
+					{
+						eventQueue.push( xPoint[0], s1, EventQueue::crossing );
+						eventQueue.push( xPoint[0], s2, EventQueue::crossing );
+					}
 				}
 			}
         }
@@ -243,31 +246,43 @@ namespace geometrix {
         void handle_event( EventQueue& eventQueue, SweepLine& sweepLine, const typename EventQueue::value_type& event )
         {            
             typedef typename SweepLine::iterator sweep_item_iterator;
-            typedef typename SweepLine::sweep_item_type sweep_item_type;
-			const auto& eventGeometry = event.first;
+			const auto& eventGeometry = event.point;
 			sweepLine.set_current_event( eventGeometry );
-            std::set<sweep_item_type*> L;
-            std::set<sweep_item_type*> C;
-            const std::set<sweep_item_type*>& U = event.second;
+            L.clear();
+            C.clear();
             
-            //Sweep the scan line and classify sweep_items as ending with this event (L structure), beginning with the current event (U structure) or overlapping the current event (C structure)
-            sweep_item_iterator sweepIter( sweepLine.begin() );
-            sweep_item_iterator sEnd( sweepLine.end() );
-            while( sweepIter != sEnd )
+            //The sweep_items which end with this event (L structure) or were found to cross it (C structure) are recorded with the event.
+            for( auto* pItem : event.ending )
+                if( sweepLine.contains( pItem ) )
+                    L.push_back( pItem );
+            for( auto* pItem : event.crossing )
+                if( sweepLine.contains( pItem ) )
+                    C.push_back( pItem );
+
+            //Items through the event which were not found by a neighbour test (e.g. those which an item starting at the event touches) 
+            //are adjacent to the event's position in the sweep line.
+            sweep_item_iterator first = lower_bound_for_event( sweepLine, eventGeometry );
+            while( first != sweepLine.begin() && sweep_item_overlaps( **std::prev( first ), eventGeometry ) )
+                --first;
+            for( sweep_item_iterator sweepIter = first; sweepIter != sweepLine.end() && sweep_item_overlaps( **sweepIter, eventGeometry ); ++sweepIter )
             {   
                 if( sweep_item_ends_with( **sweepIter, eventGeometry ) ) //if the sweep item ends in the event.
-                    L.insert( *sweepIter );
-                else if( sweep_item_overlaps( **sweepIter, eventGeometry ) && !sweep_item_starts_with( **sweepIter, eventGeometry ) )
-                    C.insert( *sweepIter );
-                
-                ++sweepIter;
+                    L.push_back( *sweepIter );
+                else if( !sweep_item_starts_with( **sweepIter, eventGeometry ) )
+                    C.push_back( *sweepIter );
             }
-                        
-            std::set<sweep_item_type*> UC;
-            std::set_union( U.begin(), U.end(), C.begin(), C.end(), std::inserter( UC, UC.begin() ) ); 
+            std::sort( L.begin(), L.end() );
+            L.erase( std::unique( L.begin(), L.end() ), L.end() );
+            std::sort( C.begin(), C.end() );
+            C.erase( std::unique( C.begin(), C.end() ), C.end() );
+            C.erase( std::remove_if( C.begin(), C.end(), [this]( sweep_item_type* pItem ){ return std::binary_search( L.begin(), L.end(), pItem ); } ), C.end() );
+
+            const auto& U = event.starting;
+            UC.clear();
+            std::set_union( U.begin(), U.end(), C.begin(), C.end(), std::back_inserter( UC ) ); 
             
-            std::set<sweep_item_type*> LUC;
-            std::set_union( UC.begin(), UC.end(), L.begin(), L.end(), std::inserter( LUC, LUC.begin() ) );
+            LUC.clear();
+            std::set_union( UC.begin(), UC.end(), L.begin(), L.end(), std::back_inserter( LUC ) );
 			            
 			//Report the sweep_items in the event.
 			if ( LUC.size() > 1 )
@@ -275,14 +290,16 @@ namespace geometrix {
             
             //visitor.debug_pre_order( sweepLine.begin(), sweepLine.end(), eventGeometry );
 
-            std::set<sweep_item_type*> LC;
-            std::set_union( L.begin(), L.end(), C.begin(), C.end(), std::inserter( LC, LC.begin() ) );
-			for( sweep_item_type* pItem : LC )
+            //Remove L and C.
+            for( auto* pItem : L )
+                sweepLine.remove( pItem );
+            for( auto* pItem : C )
                 sweepLine.remove( pItem );
             
             //Insert U and C again.
-			for( sweep_item_type* pItem : UC )
-                sweepLine.insert( pItem );
+            sweep_item_iterator inserted = sweepLine.end();
+			for( auto* pItem : UC )
+                inserted = sweepLine.insert( pItem );
 
             //visitor.debug_post_order( sweepLine.begin(), sweepLine.end(), eventGeometry );
             
@@ -301,27 +318,19 @@ namespace geometrix {
             }
             else
             {
-                for ( auto swpIt = sweepLine.begin(); swpIt != sweepLine.end(); ++swpIt )
-                {
-                    if ( UC.find( *swpIt ) != UC.end() && swpIt != sweepLine.begin() )
-                    {
-						auto s1 = swpIt;
-						if( --s1 != sweepLine.end() )
-							process_new_events( eventQueue, sweepLine, *s1, *swpIt );
-                        break;
-                    }
-                }
-                                                
-                for ( auto swpIt = sweepLine.rbegin(); swpIt != sweepLine.rend(); ++swpIt )
-                {
-                    if ( UC.find( *swpIt ) != UC.end() && swpIt != sweepLine.rbegin() )
-                    {
-						auto spp = swpIt;
-                        if( --spp != sweepLine.rend() )
-							process_new_events( eventQueue, sweepLine, *swpIt, *spp );
-                        break;
-                    }
-                }   
+                //The reinserted items are adjacent; test the outermost against their neighbours.
+                auto in_UC = [this]( sweep_item_type* pItem ){ return std::binary_search( UC.begin(), UC.end(), pItem ); };
+                auto lo = inserted;
+                while( lo != sweepLine.begin() && in_UC( *std::prev( lo ) ) )
+                    --lo;
+                if( lo != sweepLine.begin() )
+                    process_new_events( eventQueue, sweepLine, *std::prev( lo ), *lo );
+
+                auto hi = inserted;
+                while( std::next( hi ) != sweepLine.end() && in_UC( *std::next( hi ) ) )
+                    ++hi;
+                if( std::next( hi ) != sweepLine.end() )
+                    process_new_events( eventQueue, sweepLine, *hi, *std::next( hi ) );
             }            
         }//handle_event
 
@@ -358,9 +367,14 @@ namespace geometrix {
 			return sweepLine.lower_bound( &segment );
 		}
 
+        typedef typename NewEventProcessor::segment_type sweep_item_type;
+
         NewEventProcessor      process_new_events;
         Visitor                visitor;
         NumberComparisonPolicy compare;
+
+        //! Scratch buffers reused for each event; each is kept sorted by address.
+        std::vector<sweep_item_type*> L, C, UC, LUC;
     };
     
     template <typename Segment, typename Visitor, typename NumberComparisonPolicy>
@@ -373,8 +387,7 @@ namespace geometrix {
         BOOST_CONCEPT_ASSERT((Point2DConcept<point_type>));
 
 		using lex_comp_type = lexicographical_comparer<NumberComparisonPolicy>;
-        typedef std::set<segment_type*>                                                      segment_ptr_set;
-        typedef boost::container::flat_map<point_type, segment_ptr_set, lex_comp_type>       event_queue;
+        typedef sweep_event_queue<point_type, segment_type, lex_comp_type>                   event_queue;
         typedef sweepline_ordinate_compare<point_type, segment_type, NumberComparisonPolicy> segment_compare;
         typedef sweep_line<point_type, segment_type, segment_compare>                        scan_line;
 
@@ -382,17 +395,13 @@ namespace geometrix {
         lex_comp_type lexi_comp(compare);
         event_queue eventQueue(lexi_comp);
 		eventQueue.reserve(3 * ordered_segs.size());
-        typename std::vector<segment_type>::iterator sIter(ordered_segs.begin());
-        typename std::vector<segment_type>::iterator theEnd(ordered_segs.end());        
-        while(sIter != theEnd)
+        for( segment_type& segment : ordered_segs )
         {
-            segment_type& segment = *sIter;
             if ( !lexi_comp( get_start( segment ), get_end( segment ) ) )
                 segment = construct<segment_type>( get_end( segment ), get_start( segment ) );
 
-            eventQueue[get_start(segment)].insert( &*sIter );
-            eventQueue[get_end(segment)];//simply ensure the latter event exists.. no need to associate the segment.
-            ++sIter;
+            eventQueue.push( get_start( segment ), &segment );
+            eventQueue.push( get_end( segment ), &segment, event_queue::ending );
         }
 
 		point_type eventPoint;
@@ -10,9 +10,15 @@
 #define GEOMETRIX_BENTLEY_OTTMANN_SWEEP_LINE_HPP
 #pragma once
 
+#include <geometrix/utility/assert.hpp>
+
+#include <boost/range/iterator_range.hpp>
+
+#include <algorithm>
 #include <vector>
 #include <set>
 #include <functional>
+#include <unordered_map>
 
 namespace geometrix {
 
@@ -39,28 +45,33 @@ namespace geometrix {
 
         ~sweep_line(){}
 
-        iterator			      insert( sweep_item_type* item ){ return m_set.insert( item ); }
+        iterator			      insert( sweep_item_type* item )
+        {
+            iterator iter = m_set.insert( item );
+            m_positions[item] = iter;
+            return iter;
+        }
 
+        ///Items are located through an index of their positions rather than by searching the set, as the ordering
+        ///may not be consistent with the current event for items which should already have been removed.
         iterator			      remove( sweep_item_type* item )
         {
-            ///A linear search over the set comparing the value of the items (pointers usually) is likely cheaper than 
-            ///the binary search using the comparison operator.
-            
-            iterator iter(m_set.begin());
-            iterator theEnd(m_set.end());
-            while(iter != theEnd)
-            {
-                if(*iter == item)
-                {
-                    m_set.erase(iter++);
-                    return iter;
-                }
-                ++iter;
-            }
-            return theEnd;
+            auto pos = m_positions.find( item );
+            if( pos == m_positions.end() )
+                return m_set.end();
+
+            iterator iter = pos->second;
+            m_positions.erase( pos );
+            return m_set.erase( iter );
         }
 
-        void                   erase( iterator iter ) { m_set.erase(iter); }
+        void                   erase( iterator iter ) { m_positions.erase( *iter ); m_set.erase(iter); }
+        iterator               find( sweep_item_type* item ) 
+        {
+            auto pos = m_positions.find( item );
+            return pos != m_positions.end() ? pos->second : m_set.end();
+        }
+        bool                   contains( sweep_item_type* item ) const { return m_positions.find( item ) != m_positions.end(); }
         iterator               begin() { return m_set.begin(); }
         iterator               end() { return m_set.end(); }
         const_iterator         begin() const { return m_set.begin(); }
@@ -78,21 +89,108 @@ namespace geometrix {
 
     private:
 
-        sweep_events m_set;
+        sweep_events                                    m_set;
+        std::unordered_map<sweep_item_type*, iterator> m_positions;
+
+    };
+
+    //! A binary heap of sweep events ordered by PointCompare.
+    //! Each entry holds an event point and optionally one item which starts, ends or passes through there. Points which compare
+    //! equal are merged when popped, so discovering the same intersection several times only costs a heap push each. The items of
+    //! the popped event are gathered into scratch buffers reused from event to event.
+    template <typename Point, typename SweepItem, typename PointCompare>
+    class sweep_event_queue
+    {
+    public:
+
+        typedef Point                                           point_type;
+        typedef SweepItem                                       sweep_item_type;
+        typedef boost::iterator_range<sweep_item_type* const*> item_range;
+
+        enum item_role { starting, ending, crossing };
+
+        struct value_type
+        {
+            point_type point;
+            item_range starting;//! items whose start is the event point.
+            item_range ending;//! items whose end is the event point.
+            item_range crossing;//! items found to pass through the event point.
+        };
+
+        sweep_event_queue( const PointCompare& compare = PointCompare() )
+            : m_compare( compare )
+        {}
+
+        void reserve( std::size_t n ) { m_heap.reserve( n ); }
+        bool empty() const { return m_heap.empty(); }
+        std::size_t size() const { return m_heap.size(); }
+
+        //! Add an event at p. If item is not null it has the given role at p.
+        void push( const point_type& p, sweep_item_type* item = nullptr, item_role role = starting )
+        {
+            m_heap.push_back( entry{ p, item, role } );
+            std::push_heap( m_heap.begin(), m_heap.end(), heap_compare{ m_compare } );
+        }
+
+        //! Remove the least event and all events equal to it. Returns the event point and the (unique, ordered) items for each role.
+        //! The ranges are valid until the next call to pop.
+        value_type pop()
+        {
+            GEOMETRIX_ASSERT( !empty() );
+            heap_compare hcmp{ m_compare };
+            point_type p = m_heap.front().point;
+            for( auto& items : m_items )
+                items.clear();
+            while( !m_heap.empty() && !m_compare( p, m_heap.front().point ) )
+            {
+                if( m_heap.front().item )
+                    m_items[m_heap.front().role].push_back( m_heap.front().item );
+                std::pop_heap( m_heap.begin(), m_heap.end(), hcmp );
+                m_heap.pop_back();
+            }
+
+            for( auto& items : m_items )
+            {
+                std::sort( items.begin(), items.end() );
+                items.erase( std::unique( items.begin(), items.end() ), items.end() );
+            }
+            return value_type{ p, make_range( m_items[starting] ), make_range( m_items[ending] ), make_range( m_items[crossing] ) };
+        }
+
+    private:
+
+        struct entry
+        {
+            point_type       point;
+            sweep_item_type* item;
+            item_role        role;
+        };
+
+        static item_range make_range( const std::vector<sweep_item_type*>& items ) { return item_range( items.data(), items.data() + items.size() ); }
+
+        //! std::push_heap keeps the greatest element at the front; reverse the order to keep the least.
+        struct heap_compare
+        {
+            bool operator()( const entry& lhs, const entry& rhs ) const { return compare( rhs.point, lhs.point ); }
+            const PointCompare& compare;
+        };
+
+        PointCompare                  m_compare;
+        std::vector<entry>            m_heap;
+        std::vector<sweep_item_type*> m_items[3];
 
     };
 
     //! The Bentley-Ottmann Sweep Line algorithm. 
     //!	
-    //!
+    //! The event queue must provide empty() and pop() as sweep_event_queue.
     template <typename EventQueue, typename SweepLine, typename EventHandler>
     inline void bentley_ottmann_sweep( EventQueue& events, SweepLine& sweepLine, EventHandler& eventHandler )
     {
         while ( !events.empty() )
         {
-            auto iter = events.cbegin();
-            eventHandler.handle_event( events, sweepLine, *iter );
-			events.erase( iter );
+            auto event = events.pop();
+            eventHandler.handle_event( events, sweepLine, event );
         }    
     }
 
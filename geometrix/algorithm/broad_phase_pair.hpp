@@ -0,0 +1,77 @@
+//
+//! Copyright © 2026
+//! Brandon Kohn
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+#ifndef GEOMETRIX_BROAD_PHASE_PAIR_HPP
+#define GEOMETRIX_BROAD_PHASE_PAIR_HPP
+#pragma once
+
+#include <geometrix/utility/executor.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace geometrix {
+
+    //! \brief A candidate pair of broad phase proxies ordered so that first < second.
+    struct broad_phase_pair
+    {
+        broad_phase_pair() = default;
+        broad_phase_pair(std::uint32_t a, std::uint32_t b)
+            : first((std::min)(a, b))
+            , second((std::max)(a, b))
+        {}
+
+        std::uint32_t first{ 0 };
+        std::uint32_t second{ 0 };
+
+        friend bool operator ==(const broad_phase_pair& lhs, const broad_phase_pair& rhs) { return lhs.first == rhs.first && lhs.second == rhs.second; }
+        friend bool operator !=(const broad_phase_pair& lhs, const broad_phase_pair& rhs) { return !(lhs == rhs); }
+        friend bool operator <(const broad_phase_pair& lhs, const broad_phase_pair& rhs) { return lhs.first < rhs.first || (lhs.first == rhs.first && lhs.second < rhs.second); }
+    };
+
+    //! Run the narrow phase test(first, second) on each candidate pair and return the pairs for which it returns true in their input order.
+    template <typename Pairs, typename NarrowPhase>
+    inline std::vector<broad_phase_pair> narrow_phase(const Pairs& candidates, NarrowPhase&& test)
+    {
+        std::vector<broad_phase_pair> result;
+        for (const broad_phase_pair& p : candidates)
+            if (test(p.first, p.second))
+                result.push_back(p);
+        return result;
+    }
+
+    //! Run the narrow phase tests on chunks of grainSize candidates (0 chooses a default) concurrently on the executor.
+    //! test must be safe to call concurrently. The result is the same as that of the serial narrow_phase.
+    template <typename Pairs, typename NarrowPhase, typename Executor, typename std::enable_if<is_executor<typename std::decay<Executor>::type>::value, int>::type = 0>
+    inline std::vector<broad_phase_pair> narrow_phase(const Pairs& candidates, NarrowPhase&& test, Executor&& executor, std::size_t grainSize = 0)
+    {
+        auto first = std::begin(candidates);
+        std::size_t n = std::distance(first, std::end(candidates));
+        if (grainSize == 0)
+            grainSize = default_grain_size(n);
+
+        std::vector<std::uint8_t> hits(n);
+        parallel_for(executor, n, grainSize, [&](std::size_t i, std::size_t last)
+        {
+            for (; i < last; ++i)
+                hits[i] = test(first[i].first, first[i].second) ? 1 : 0;
+        });
+
+        std::vector<broad_phase_pair> result;
+        for (std::size_t i = 0; i < n; ++i)
+            if (hits[i])
+                result.push_back(first[i]);
+        return result;
+    }
+
+}//namespace geometrix;
+
+#endif //! GEOMETRIX_BROAD_PHASE_PAIR_HPP
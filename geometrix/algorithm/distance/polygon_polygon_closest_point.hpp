@@ -14,6 +14,7 @@
 #include <geometrix/algorithm/distance/point_point_distance.hpp>
 #include <geometrix/algorithm/distance/aabb_aabb_distance.hpp>
 #include <geometrix/primitive/point_sequence_utilities.hpp>
+#include <geometrix/algorithm/point_sequence/prepared_point_sequence.hpp>
 
 namespace geometrix {
     namespace result_of {
@@ -27,6 +28,15 @@ namespace geometrix {
 
 			using type = typename result_of::point_point_distance_sqrd<point1_t, point2_t>::type;
         };
+
+        template <typename Polygon1, typename Polygon2>
+        struct polygon_polygon_closest_point<prepared_polygon<Polygon1>, prepared_polygon<Polygon2>>
+        {
+            using type = typename result_of::point_point_distance_sqrd<typename prepared_polygon<Polygon1>::point_type, typename prepared_polygon<Polygon2>::point_type>::type;
+        };
+
+        template <typename Polygon1, typename Polygon2>
+        struct polygon_polygon_closest_point<prepared_point_sequence<Polygon1, true>, prepared_point_sequence<Polygon2, true>> : polygon_polygon_closest_point<prepared_polygon<Polygon1>, prepared_polygon<Polygon2>> {};
     }
 
     template <typename Polygon1, typename Polygon2, typename Dimensionless, typename Point, typename NumberComparisonPolicy>
@@ -92,97 +102,62 @@ namespace geometrix {
         return minDist2;
     }
 
+    //! \brief Compute the closest points between two polygons whose segment hierarchies have been prepared.
     template <typename Polygon1, typename Polygon2, typename Dimensionless, typename Point, typename NumberComparisonPolicy>
-    inline typename result_of::polygon_polygon_closest_point<Polygon1, Polygon2>::type polygon_polygon_closest_point(const Polygon1& p1,  const Polygon2& p2, std::size_t& i1, std::size_t& i2, Dimensionless& s, Dimensionless& t, Point& c1, Point& c2, const NumberComparisonPolicy& cmp)
+    inline typename result_of::polygon_polygon_closest_point<prepared_polygon<Polygon1>, prepared_polygon<Polygon2>>::type polygon_polygon_closest_point(const prepared_point_sequence<Polygon1, true>& p1, const prepared_point_sequence<Polygon2, true>& p2, std::size_t& i1, std::size_t& i2, Dimensionless& s, Dimensionless& t, Point& c1, Point& c2, const NumberComparisonPolicy& cmp)
     {
-        using access1 = point_sequence_traits<Polygon1>;
-        using access2 = point_sequence_traits<Polygon2>;
-        if(access1::size(p1) < 6 || access2::size(p2) < 6)
-            return polygon_polygon_closest_point_brute(p1, p2, i1, i2, s, t, c1, c2, cmp);
-
-        using point_t = typename point_sequence_traits<Polygon1>::point_type;
-        using length_t = typename arithmetic_type_of<point_t>::type;
-        using area_t = decltype(std::declval<length_t>() * std::declval<length_t>());
-        area_t minDist2 = point_point_distance_sqrd(access1::get_point(p1, 0), access2::get_point(p2, 0));
-
-        using index_range = std::tuple<std::size_t, std::size_t>;
-        using work_item = std::tuple<index_range, index_range, area_t>;
-
-        auto split = [](const index_range& r) -> std::tuple<index_range, index_range>
-        {
-            auto m = (std::get<1>(r) + std::get<0>(r)) / 2;
-            return std::tuple<index_range, index_range>{ index_range{std::get<0>(r), m}, index_range{m, std::get<1>(r)} };
-        };
-
-        struct priority_cmp
-        {
-            bool operator()(const work_item& lhs, const work_item& rhs){ return std::get<2>(lhs) > std::get<2>(rhs); }
-        };
-
-        auto Q = std::priority_queue<work_item, std::vector<work_item>, priority_cmp>{};
-        Q.emplace( index_range{ 0, access1::size(p1)-1 }, index_range{ 0, access2::size(p2)-1 }, aabb_aabb_distance_sqrd(make_aabb<point_t>(p1, cmp), make_aabb<point_t>(p2, cmp)) );
-
-        std::size_t rl1, rh1, rl2, rh2;
-        area_t d2;
-        index_range r1, r2;
-        while(!Q.empty())
+        using area_t = typename result_of::polygon_polygon_closest_point<prepared_polygon<Polygon1>, prepared_polygon<Polygon2>>::type;
+        if (p1.empty() || p2.empty())
+            return constants::infinity<area_t>();
+
+        //! The first vertices bound the distance.
+        i1 = i2 = 0;
+        s = t = Dimensionless{};
+        c1 = construct<Point>(p1.get_point(0));
+        c2 = construct<Point>(p2.get_point(0));
+        area_t minDist2 = point_point_distance_sqrd(c1, c2);
+        return detail::prepared_sequence_distance_search(p1, p2, minDist2, [&](const auto& a, const auto& b, area_t bound)
         {
-            std::tie(r1, r2, d2) = Q.top();
-            Q.pop();
-
-            if(d2 >= minDist2)
-                break;
-
-            std::tie(rl1, rh1) = r1;
-            std::tie(rl2, rh2) = r2;
-
-            if ((rh1 - rl1) < 5 || (rh2 -rl2) < 5)
+            for (std::size_t i = a.first; i < a.last; ++i)
             {
-                auto sl = Dimensionless{};
-                auto tl = Dimensionless{};
-                Point c1l, c2l;
-				std::size_t i1l, i2l;
-                auto dl = polygon_polygon_closest_point_brute(r1, p1, r2, p2, i1l, i2l, sl, tl, c1l, c2l, cmp);
-                if(dl < minDist2)
+                for (std::size_t j = b.first; j < b.last; ++j)
                 {
-                    minDist2 = dl;
-					i1 = i1l;
-					i2 = i2l;
-                    s = sl;
-                    t = tl;
-                    c1 = c1l;
-                    c2 = c2l;
+                    auto sl = Dimensionless{};
+                    auto tl = Dimensionless{};
+                    Point c1l, c2l;
+                    auto d2 = segment_segment_closest_point(p1.get_point(i), p1.get_point(i + 1), p2.get_point(j), p2.get_point(j + 1), sl, tl, c1l, c2l, cmp);
+                    if (d2 < bound)
+                    {
+                        bound = d2;
+                        i1 = i;
+                        i2 = j;
+                        s = sl;
+                        t = tl;
+                        c1 = c1l;
+                        c2 = c2l;
+                    }
                 }
-                continue;
             }
+            return bound;
+        });
+    }
 
-            //! Divide and conquer.
-            index_range r1A, r1B, r2A, r2B;
-            std::tie(r1A, r1B) = split(r1);
-            std::tie(r2A, r2B) = split(r2);
-            auto r1Abox = make_aabb<point_t>(p1, r1A, cmp);
-            auto r1Bbox = make_aabb<point_t>(p1, r1B, cmp);
-            auto r2Abox = make_aabb<point_t>(p2, r2A, cmp);
-            auto r2Bbox = make_aabb<point_t>(p2, r2B, cmp);
-
-            d2 = aabb_aabb_distance_sqrd(r1Abox, r2Abox);
-            if( d2 <= minDist2 )
-                Q.emplace(r1A, r2A, d2);
-
-            d2 = aabb_aabb_distance_sqrd(r1Abox, r2Bbox);
-            if( d2 <= minDist2 )
-                Q.emplace(r1A, r2B, d2);
-
-            d2 = aabb_aabb_distance_sqrd(r1Bbox, r2Abox);
-            if( d2 <= minDist2 )
-                Q.emplace(r1B, r2A, d2);
-
-            d2 = aabb_aabb_distance_sqrd(r1Bbox, r2Bbox);
-            if( d2 <= minDist2 )
-                Q.emplace(r1B, r2B, d2);
-        }
+    template <typename Polygon1, typename Polygon2, typename Dimensionless, typename Point, typename NumberComparisonPolicy>
+    inline typename result_of::polygon_polygon_closest_point<prepared_polygon<Polygon1>, prepared_polygon<Polygon2>>::type polygon_polygon_closest_point(const prepared_polygon<Polygon1>& p1, const prepared_polygon<Polygon2>& p2, std::size_t& i1, std::size_t& i2, Dimensionless& s, Dimensionless& t, Point& c1, Point& c2, const NumberComparisonPolicy& cmp)
+    {
+        return polygon_polygon_closest_point(static_cast<const prepared_point_sequence<Polygon1, true>&>(p1), static_cast<const prepared_point_sequence<Polygon2, true>&>(p2), i1, i2, s, t, c1, c2, cmp);
+    }
 
-        return minDist2;
+    template <typename Polygon1, typename Polygon2, typename Dimensionless, typename Point, typename NumberComparisonPolicy>
+    inline typename result_of::polygon_polygon_closest_point<Polygon1, Polygon2>::type polygon_polygon_closest_point(const Polygon1& p1,  const Polygon2& p2, std::size_t& i1, std::size_t& i2, Dimensionless& s, Dimensionless& t, Point& c1, Point& c2, const NumberComparisonPolicy& cmp)
+    {
+        using access1 = point_sequence_traits<Polygon1>;
+        using access2 = point_sequence_traits<Polygon2>;
+        if(access1::size(p1) < 6 || access2::size(p2) < 6)
+            return polygon_polygon_closest_point_brute(p1, p2, i1, i2, s, t, c1, c2, cmp);
+
+        //! Only the segment hierarchies are needed so the row index of a prepared_polygon is not built.
+        return polygon_polygon_closest_point(prepared_point_sequence<Polygon1, true>(p1), prepared_point_sequence<Polygon2, true>(p2), i1, i2, s, t, c1, c2, cmp);
     }
 
 }//namespace geometrix;
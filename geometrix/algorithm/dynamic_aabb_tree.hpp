@@ -0,0 +1,443 @@
+//
+//! Copyright © 2026
+//! Brandon Kohn
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+#ifndef GEOMETRIX_DYNAMIC_AABB_TREE_HPP
+#define GEOMETRIX_DYNAMIC_AABB_TREE_HPP
+#pragma once
+
+#include <geometrix/algorithm/broad_phase_pair.hpp>
+#include <geometrix/primitive/axis_aligned_bounding_box.hpp>
+#include <geometrix/utility/assert.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace geometrix {
+
+    //! \brief A bounding volume hierarchy of axis aligned boxes supporting insertion, removal and update of moving proxies.
+
+    //! Each proxy is stored in a leaf with bounds fattened by a margin so that small motions do not change the tree. When a proxy
+    //! leaves its fat bounds it is reinserted at the sibling which least increases the sum of the extents of the ancestors and
+    //! the tree is rebalanced by rotations on the way to the root. Nodes live in a pool with a free list so proxy ids are stable
+    //! until the proxy is removed.
+    //! \code
+    //! dynamic_aabb_tree<point2> tree(0.1);
+    //! auto id = tree.insert(make_aabb<point2>(s), index);
+    //! tree.update(id, make_aabb<point2>(moved), displacement);
+    //! auto candidates = tree.find_overlapping_pairs();
+    //! \endcode
+    template <typename Point, typename T = std::size_t>
+    class dynamic_aabb_tree
+    {
+    public:
+
+        using value_type = T;
+        using point_type = Point;
+        using box_type = axis_aligned_bounding_box<Point>;
+        using length_type = typename arithmetic_type_of<Point>::type;
+        using proxy_id = std::uint32_t;
+
+        BOOST_STATIC_CONSTANT(std::size_t, dimension = dimension_of<Point>::value);
+        BOOST_STATIC_CONSTANT(proxy_id, null_proxy = 0xFFFFFFFF);
+
+        //! Construct an empty tree whose leaves are fattened by margin on each side.
+        explicit dynamic_aabb_tree(length_type margin = constants::zero<length_type>())
+            : m_margin(margin)
+        {}
+
+        std::size_t size() const { return m_size; }
+        bool        empty() const { return m_size == 0; }
+        length_type get_margin() const { return m_margin; }
+
+        //! The height of the tree; 0 for a single leaf and -1 when empty.
+        int get_height() const { return m_root == null_proxy ? -1 : m_nodes[m_root].height; }
+
+        //! Insert a proxy with bounds box carrying value. Returns the id of the proxy.
+        proxy_id insert(const box_type& box, const T& value)
+        {
+            proxy_id id = allocate_node();
+            node& n = m_nodes[id];
+            n.box = fatten(box);
+            n.value = value;
+            n.height = 0;
+            insert_leaf(id);
+            ++m_size;
+            return id;
+        }
+
+        //! Remove the proxy id.
+        void remove(proxy_id id)
+        {
+            GEOMETRIX_ASSERT(id < m_nodes.size() && m_nodes[id].is_leaf());
+            remove_leaf(id);
+            free_node(id);
+            --m_size;
+        }
+
+        //! Move the proxy id to bounds box. The tree is unchanged if the box is still within the fat bounds of the proxy.
+        //! Returns whether the proxy was reinserted.
+        bool update(proxy_id id, const box_type& box)
+        {
+            GEOMETRIX_ASSERT(id < m_nodes.size() && m_nodes[id].is_leaf());
+            if (m_nodes[id].box.contains(box))
+                return false;
+
+            remove_leaf(id);
+            m_nodes[id].box = fatten(box);
+            insert_leaf(id);
+            return true;
+        }
+
+        //! Move the proxy id to bounds box. When reinserted the fat bounds are also extended along the displacement expected
+        //! over the next step so that coherent motion leaves the tree unchanged for longer.
+        template <typename Vector>
+        bool update(proxy_id id, const box_type& box, const Vector& displacement)
+        {
+            GEOMETRIX_ASSERT(id < m_nodes.size() && m_nodes[id].is_leaf());
+            if (m_nodes[id].box.contains(box))
+                return false;
+
+            remove_leaf(id);
+            m_nodes[id].box = extend(fatten(box), displacement, std::make_index_sequence<dimension>());
+            insert_leaf(id);
+            return true;
+        }
+
+        const box_type& get_fat_bounds(proxy_id id) const { GEOMETRIX_ASSERT(id < m_nodes.size()); return m_nodes[id].box; }
+        const T&        get_value(proxy_id id) const { GEOMETRIX_ASSERT(id < m_nodes.size()); return m_nodes[id].value; }
+        T&              get_value(proxy_id id) { GEOMETRIX_ASSERT(id < m_nodes.size()); return m_nodes[id].value; }
+
+        //! Visit the id of each proxy whose fat bounds intersect range.
+        template <typename P, typename Visitor>
+        void search(const axis_aligned_bounding_box<P>& range, Visitor&& visitor) const
+        {
+            if (m_root == null_proxy)
+                return;
+
+            std::vector<proxy_id> stack(1, m_root);
+            while (!stack.empty())
+            {
+                const node& n = m_nodes[stack.back()];
+                proxy_id id = stack.back();
+                stack.pop_back();
+                if (!n.box.intersects(range))
+                    continue;
+                if (n.is_leaf())
+                    visitor(id);
+                else
+                {
+                    stack.push_back(n.child1);
+                    stack.push_back(n.child2);
+                }
+            }
+        }
+
+        //! Find the pairs of proxies whose fat bounds intersect. The pairs are sorted and each is reported once.
+        void find_overlapping_pairs(std::vector<broad_phase_pair>& pairs) const
+        {
+            pairs.clear();
+            if (m_root != null_proxy)
+                self_overlaps(m_root, pairs);
+            std::sort(pairs.begin(), pairs.end());
+        }
+
+        std::vector<broad_phase_pair> find_overlapping_pairs() const
+        {
+            std::vector<broad_phase_pair> pairs;
+            find_overlapping_pairs(pairs);
+            return pairs;
+        }
+
+    private:
+
+        struct node
+        {
+            node()
+                : box(point_type(), point_type())
+            {}
+
+            box_type box;
+            proxy_id parent{ null_proxy };//! the parent of a node in the tree or the next free node in the pool.
+            proxy_id child1{ null_proxy };
+            proxy_id child2{ null_proxy };
+            int      height{ -1 };//! 0 for leaves and -1 for free nodes.
+            T        value{};
+
+            bool is_leaf() const { return height == 0; }
+        };
+
+        box_type fatten(const box_type& box) const
+        {
+            return fatten(box, std::make_index_sequence<dimension>());
+        }
+
+        template <std::size_t... I>
+        box_type fatten(const box_type& box, std::index_sequence<I...>) const
+        {
+            auto& lo = box.get_lower_bound();
+            auto& hi = box.get_upper_bound();
+            return box_type(construct<point_type>((get<I>(lo) - m_margin)...), construct<point_type>((get<I>(hi) + m_margin)...));
+        }
+
+        template <typename Vector, std::size_t... I>
+        static box_type extend(const box_type& box, const Vector& d, std::index_sequence<I...>)
+        {
+            auto& lo = box.get_lower_bound();
+            auto& hi = box.get_upper_bound();
+            auto zero = constants::zero<length_type>();
+            return box_type(construct<point_type>((get<I>(d) < zero ? get<I>(lo) + get<I>(d) : get<I>(lo))...), construct<point_type>((get<I>(d) > zero ? get<I>(hi) + get<I>(d) : get<I>(hi))...));
+        }
+
+        //! The sum of the extents of a box used as the cost of a node.
+        template <std::size_t... I>
+        static length_type extent_sum(const box_type& box, std::index_sequence<I...>)
+        {
+            auto& lo = box.get_lower_bound();
+            auto& hi = box.get_upper_bound();
+            length_type sum = constants::zero<length_type>();
+            using expander = int[];
+            (void)expander{ 0, (sum += get<I>(hi) - get<I>(lo), 0)... };
+            return sum;
+        }
+
+        static length_type extent_sum(const box_type& box)
+        {
+            return extent_sum(box, std::make_index_sequence<dimension>());
+        }
+
+        static box_type combine(const box_type& a, const box_type& b)
+        {
+            box_type result = a;
+            result.expand(b);
+            return result;
+        }
+
+        proxy_id allocate_node()
+        {
+            if (m_free == null_proxy)
+            {
+                m_nodes.emplace_back();
+                return static_cast<proxy_id>(m_nodes.size() - 1);
+            }
+
+            proxy_id id = m_free;
+            m_free = m_nodes[id].parent;
+            m_nodes[id] = node();
+            return id;
+        }
+
+        void free_node(proxy_id id)
+        {
+            m_nodes[id].parent = m_free;
+            m_nodes[id].height = -1;
+            m_free = id;
+        }
+
+        void insert_leaf(proxy_id leaf)
+        {
+            if (m_root == null_proxy)
+            {
+                m_root = leaf;
+                m_nodes[leaf].parent = null_proxy;
+                return;
+            }
+
+            //! Descend to the sibling whose pairing with the leaf costs least.
+            box_type leafBox = m_nodes[leaf].box;
+            proxy_id index = m_root;
+            while (!m_nodes[index].is_leaf())
+            {
+                const node& n = m_nodes[index];
+                length_type area = extent_sum(n.box);
+                length_type combinedArea = extent_sum(combine(n.box, leafBox));
+
+                //! The cost of creating a new parent for this node and the leaf and the minimum cost pushed down to the children.
+                length_type cost = combinedArea + combinedArea;
+                length_type inheritance = (combinedArea - area) + (combinedArea - area);
+
+                length_type cost1 = child_cost(n.child1, leafBox) + inheritance;
+                length_type cost2 = child_cost(n.child2, leafBox) + inheritance;
+                if (cost < cost1 && cost < cost2)
+                    break;
+
+                index = cost1 < cost2 ? n.child1 : n.child2;
+            }
+
+            proxy_id sibling = index;
+            proxy_id oldParent = m_nodes[sibling].parent;
+            proxy_id newParent = allocate_node();
+            {
+                node& p = m_nodes[newParent];
+                p.parent = oldParent;
+                p.box = combine(leafBox, m_nodes[sibling].box);
+                p.height = m_nodes[sibling].height + 1;
+                p.child1 = sibling;
+                p.child2 = leaf;
+            }
+            m_nodes[sibling].parent = newParent;
+            m_nodes[leaf].parent = newParent;
+            if (oldParent != null_proxy)
+                replace_child(oldParent, sibling, newParent);
+            else
+                m_root = newParent;
+
+            refit(m_nodes[leaf].parent);
+        }
+
+        length_type child_cost(proxy_id child, const box_type& leafBox) const
+        {
+            const node& c = m_nodes[child];
+            length_type combined = extent_sum(combine(c.box, leafBox));
+            return c.is_leaf() ? combined : combined - extent_sum(c.box);
+        }
+
+        void remove_leaf(proxy_id leaf)
+        {
+            if (leaf == m_root)
+            {
+                m_root = null_proxy;
+                return;
+            }
+
+            proxy_id parent = m_nodes[leaf].parent;
+            proxy_id grandParent = m_nodes[parent].parent;
+            proxy_id sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+            if (grandParent != null_proxy)
+            {
+                replace_child(grandParent, parent, sibling);
+                m_nodes[sibling].parent = grandParent;
+                free_node(parent);
+                refit(grandParent);
+            }
+            else
+            {
+                m_root = sibling;
+                m_nodes[sibling].parent = null_proxy;
+                free_node(parent);
+            }
+        }
+
+        void replace_child(proxy_id parent, proxy_id oldChild, proxy_id newChild)
+        {
+            node& p = m_nodes[parent];
+            if (p.child1 == oldChild)
+                p.child1 = newChild;
+            else
+                p.child2 = newChild;
+        }
+
+        //! Rebalance and refit the bounds and heights of the ancestors from index to the root.
+        void refit(proxy_id index)
+        {
+            while (index != null_proxy)
+            {
+                index = balance(index);
+                node& n = m_nodes[index];
+                n.height = 1 + (std::max)(m_nodes[n.child1].height, m_nodes[n.child2].height);
+                n.box = combine(m_nodes[n.child1].box, m_nodes[n.child2].box);
+                index = n.parent;
+            }
+        }
+
+        //! Rotate the taller grandchild of a up if the heights of its children differ by more than one. Returns the index of the root of the subtree.
+        proxy_id balance(proxy_id iA)
+        {
+            node& a = m_nodes[iA];
+            if (a.is_leaf() || a.height < 2)
+                return iA;
+
+            proxy_id iB = a.child1;
+            proxy_id iC = a.child2;
+            int skew = m_nodes[iC].height - m_nodes[iB].height;
+            if (skew > 1)
+                return rotate(iA, iC, iB, false);
+            if (skew < -1)
+                return rotate(iA, iB, iC, true);
+            return iA;
+        }
+
+        //! Rotate the child iUp of iA above it. iOther is the other child of iA; upIsFirst is whether iUp is the first child of iA.
+        proxy_id rotate(proxy_id iA, proxy_id iUp, proxy_id iOther, bool upIsFirst)
+        {
+            node& a = m_nodes[iA];
+            node& up = m_nodes[iUp];
+            proxy_id iF = up.child1;
+            proxy_id iG = up.child2;
+            node& f = m_nodes[iF];
+            node& g = m_nodes[iG];
+
+            up.child1 = iA;
+            up.parent = a.parent;
+            a.parent = iUp;
+            if (up.parent != null_proxy)
+                replace_child(up.parent, iA, iUp);
+            else
+                m_root = iUp;
+
+            //! Keep the taller grandchild under the rotated node and give the shorter one to a.
+            proxy_id iKeep = f.height > g.height ? iF : iG;
+            proxy_id iGive = f.height > g.height ? iG : iF;
+            up.child2 = iKeep;
+            if (upIsFirst)
+                a.child1 = iGive;
+            else
+                a.child2 = iGive;
+            m_nodes[iGive].parent = iA;
+
+            a.box = combine(m_nodes[iOther].box, m_nodes[iGive].box);
+            a.height = 1 + (std::max)(m_nodes[iOther].height, m_nodes[iGive].height);
+            up.box = combine(a.box, m_nodes[iKeep].box);
+            up.height = 1 + (std::max)(a.height, m_nodes[iKeep].height);
+            return iUp;
+        }
+
+        void self_overlaps(proxy_id index, std::vector<broad_phase_pair>& pairs) const
+        {
+            const node& n = m_nodes[index];
+            if (n.is_leaf())
+                return;
+            self_overlaps(n.child1, pairs);
+            self_overlaps(n.child2, pairs);
+            cross_overlaps(n.child1, n.child2, pairs);
+        }
+
+        void cross_overlaps(proxy_id i, proxy_id j, std::vector<broad_phase_pair>& pairs) const
+        {
+            const node& a = m_nodes[i];
+            const node& b = m_nodes[j];
+            if (!a.box.intersects(b.box))
+                return;
+
+            if (a.is_leaf() && b.is_leaf())
+                pairs.emplace_back(i, j);
+            else if (b.is_leaf() || (!a.is_leaf() && a.height >= b.height))
+            {
+                cross_overlaps(a.child1, j, pairs);
+                cross_overlaps(a.child2, j, pairs);
+            }
+            else
+            {
+                cross_overlaps(i, b.child1, pairs);
+                cross_overlaps(i, b.child2, pairs);
+            }
+        }
+
+        std::vector<node> m_nodes;
+        proxy_id          m_root{ null_proxy };
+        proxy_id          m_free{ null_proxy };
+        std::size_t       m_size{ 0 };
+        length_type       m_margin;
+
+    };
+
+}//namespace geometrix;
+
+#endif //! GEOMETRIX_DYNAMIC_AABB_TREE_HPP
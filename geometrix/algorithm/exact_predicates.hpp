@@ -0,0 +1,172 @@
+//
+//! Copyright © 2026
+//! Brandon Kohn
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+#ifndef GEOMETRIX_ALGORITHM_EXACT_PREDICATES_HPP
+#define GEOMETRIX_ALGORITHM_EXACT_PREDICATES_HPP
+#pragma once
+
+#include <geometrix/algorithm/predicates.hpp>
+#include <geometrix/algorithm/orientation/orientation_enum.hpp>
+#include <geometrix/algorithm/point_in_circumcircle.hpp>
+#include <geometrix/numeric/number_comparison_policy.hpp>
+#include <geometrix/primitive/point_traits.hpp>
+#include <geometrix/tensor/vector_traits.hpp>
+
+#include <cstddef>
+#include <utility>
+
+namespace geometrix {
+
+    //! \brief A comparison policy which selects Shewchuk's adaptive precision predicates for orientation and incircle tests.
+
+    //! exact_predicate_comparison_policy implements a model of the NumberComparisonPolicyConcept.\n
+    //! Scalar comparisons are direct comparisons using the corresponding operator (as direct_comparison_policy).\n
+    //! When passed to get_orientation, point_segment_orientation, vector_vector_orientation or point_in_circumcircle
+    //! the sign of the underlying determinant is computed exactly from the double precision input coordinates
+    //! rather than by comparing rounded products. Coordinates must be convertible to double.
+    //!
+    //! For example:
+    //! \code
+    //! orientation_type o = get_orientation( a, b, c, exact_predicate_comparison_policy() );
+    //! \endcode
+    class exact_predicate_comparison_policy : public direct_comparison_policy
+    {
+    public:
+
+        exact_predicate_comparison_policy()
+        {}
+
+    };
+
+    namespace detail {
+        template <typename T, std::size_t... I>
+        inline void to_double_array(const T& p, double* r, std::index_sequence<I...>)
+        {
+            using expand = int[];
+            (void)expand{ 0, (r[I] = static_cast<double>(get<I>(p)), 0)... };
+        }
+
+        template <std::size_t D, typename T>
+        inline void to_double_array(const T& p, double(&r)[D])
+        {
+            to_double_array(p, r, std::make_index_sequence<D>());
+        }
+
+        inline orientation_type orientation_from_determinant(double det)
+        {
+            if (det > 0.0)
+                return oriented_left;
+            else if (det < 0.0)
+                return oriented_right;
+            else
+                return oriented_collinear;
+        }
+    }//! namespace detail;
+
+    //! Return a positive value if a, b and c occur in counterclockwise order, negative if clockwise and zero if collinear.
+    //! The result approximates twice the signed area of the triangle; its sign is exact.
+    template <typename Point1, typename Point2, typename Point3>
+    inline double exact_orient2d(const Point1& a, const Point2& b, const Point3& c)
+    {
+        double pa[2], pb[2], pc[2];
+        detail::to_double_array(a, pa);
+        detail::to_double_array(b, pb);
+        detail::to_double_array(c, pc);
+        return shewchuk::orient2d(pa, pb, pc);
+    }
+
+    //! Return a positive value if d lies below the plane passing through a, b and c (where a, b and c appear in counterclockwise
+    //! order when viewed from above), negative if d lies above and zero if the points are coplanar. The sign is exact.
+    template <typename Point1, typename Point2, typename Point3, typename Point4>
+    inline double exact_orient3d(const Point1& a, const Point2& b, const Point3& c, const Point4& d)
+    {
+        double pa[3], pb[3], pc[3], pd[3];
+        detail::to_double_array(a, pa);
+        detail::to_double_array(b, pb);
+        detail::to_double_array(c, pc);
+        detail::to_double_array(d, pd);
+        return shewchuk::orient3d(pa, pb, pc, pd);
+    }
+
+    //! Return a positive value if d lies inside the circle passing through a, b and c, negative if it lies outside and zero if
+    //! the four points are cocircular. The points a, b and c must be in counterclockwise order or the sign is reversed. The sign is exact.
+    template <typename Point1, typename Point2, typename Point3, typename Point4>
+    inline double exact_incircle(const Point1& a, const Point2& b, const Point3& c, const Point4& d)
+    {
+        double pa[2], pb[2], pc[2], pd[2];
+        detail::to_double_array(a, pa);
+        detail::to_double_array(b, pb);
+        detail::to_double_array(c, pc);
+        detail::to_double_array(d, pd);
+        return shewchuk::incircle(pa, pb, pc, pd);
+    }
+
+    //! Return a positive value if e lies inside the sphere passing through a, b, c and d, negative if it lies outside and zero if
+    //! the five points are cospherical. The points a, b, c and d must be ordered so that exact_orient3d(a, b, c, d) is positive
+    //! or the sign is reversed. The sign is exact.
+    template <typename Point1, typename Point2, typename Point3, typename Point4, typename Point5>
+    inline double exact_insphere(const Point1& a, const Point2& b, const Point3& c, const Point4& d, const Point5& e)
+    {
+        double pa[3], pb[3], pc[3], pd[3], pe[3];
+        detail::to_double_array(a, pa);
+        detail::to_double_array(b, pb);
+        detail::to_double_array(c, pc);
+        detail::to_double_array(d, pd);
+        detail::to_double_array(e, pe);
+        return shewchuk::insphere(pa, pb, pc, pd, pe);
+    }
+
+    //! Orientation test to check if point C is left, collinear, or right of the line formed by A-B using exact arithmetic.
+    template <typename Point1, typename Point2, typename Point3>
+    inline orientation_type get_orientation(const Point1& A, const Point2& B, const Point3& C, const exact_predicate_comparison_policy&)
+    {
+        return detail::orientation_from_determinant(exact_orient2d(A, B, C));
+    }
+
+    //! Orientation test to check if point A is left, collinear, or right of the line formed by B-C using exact arithmetic.
+    template <typename Point1, typename Point2, typename Point3>
+    inline orientation_type point_segment_orientation(const Point1& A, const Point2& B, const Point3& C, const exact_predicate_comparison_policy&)
+    {
+        return detail::orientation_from_determinant(exact_orient2d(B, C, A));
+    }
+
+    //! Orientation test to check the orientation of B relative to A using exact arithmetic.
+    //! @precondition A and B are vectors which share a common origin.
+    template <typename Vector1, typename Vector2>
+    inline orientation_type get_orientation(const Vector1& A, const Vector2& B, const exact_predicate_comparison_policy&)
+    {
+        double pa[2], pb[2];
+        detail::to_double_array(A, pa);
+        detail::to_double_array(B, pb);
+        const double origin[2] = { 0.0, 0.0 };
+        return detail::orientation_from_determinant(shewchuk::orient2d(pa, pb, origin));
+    }
+
+    //! Orientation test to check the orientation of A relative to B using exact arithmetic. - NOTE: This is the reverse of get_orientation.
+    //! @precondition A and B are vectors which share a common origin.
+    template <typename Vector1, typename Vector2>
+    inline orientation_type vector_vector_orientation(const Vector1& A, const Vector2& B, const exact_predicate_comparison_policy& cmp)
+    {
+        return get_orientation(B, A, cmp);
+    }
+
+    //! Classify p against the circumcircle of the counterclockwise triangle a, b, c using exact arithmetic.
+    template <typename Point1, typename Point2, typename Point3, typename Point4>
+    inline point_circle_orientation point_in_circumcircle(const Point1& a, const Point2& b, const Point3& c, const Point4& p, const exact_predicate_comparison_policy&)
+    {
+        double r = exact_incircle(a, b, c, p);
+        if (r > 0.0)
+            return point_circle_orientation::inside;
+        if (r < 0.0)
+            return point_circle_orientation::outside;
+        return point_circle_orientation::cocircular;
+    }
+
+}//! namespace geometrix;
+
+#endif//! GEOMETRIX_ALGORITHM_EXACT_PREDICATES_HPP
@@ -0,0 +1,554 @@
+//
+//! Copyright © 2026
+//! Brandon Kohn
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+#ifndef GEOMETRIX_FLAT_KD_TREE_HPP
+#define GEOMETRIX_FLAT_KD_TREE_HPP
+#pragma once
+
+#include <geometrix/primitive/axis_aligned_bounding_box.hpp>
+#include <geometrix/primitive/point_sequence_utilities.hpp>
+#include <geometrix/algorithm/distance/point_point_distance.hpp>
+#include <geometrix/algorithm/distance/point_aabb_distance.hpp>
+#include <geometrix/utility/assert.hpp>
+#include <geometrix/utility/bounded_max_heap.hpp>
+#include <geometrix/utility/executor.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace geometrix {
+
+    //! \brief The results of a batch of range queries in compressed sparse row form.
+    //! The input indices of the points found by query i are indices[offsets[i]] to indices[offsets[i+1]-1].
+    struct kd_tree_batch_result
+    {
+        std::vector< std::size_t >   offsets;
+        std::vector< std::uint32_t > indices;
+
+        //! The number of queries.
+        std::size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+        std::size_t count( std::size_t query ) const { return offsets[query + 1] - offsets[query]; }
+        const std::uint32_t* begin( std::size_t query ) const { return indices.data() + offsets[query]; }
+        const std::uint32_t* end( std::size_t query ) const { return indices.data() + offsets[query + 1]; }
+    };
+
+    namespace detail {
+
+        //! Branch free closed box containment. Comparisons on all dimensions are combined with bitwise and so a loop over
+        //! a bucket of points has no data dependent branches and can be vectorized.
+        template <typename Point, typename Lower, typename Upper, std::size_t... I>
+        inline std::uint8_t flat_kd_tree_box_contains( const Point& p, const Lower& lo, const Upper& hi, std::index_sequence<I...> )
+        {
+            return static_cast<std::uint8_t>( ( ( (get<I>( lo ) <= get<I>( p )) & (get<I>( p ) <= get<I>( hi )) ) & ... ) );
+        }
+
+    }//! namespace detail;
+
+    //! \brief A kd_tree variant which stores its nodes and points in contiguous arrays.
+
+    //! The flat_kd_tree is built in place over a single copy of the input points paired with their input indices. Each level partitions the sub-ranges of
+    //! its parent with std::nth_element on the level's dimension so no intermediate point vectors are allocated. Nodes are
+    //! laid out breadth first in a single array with the children of a node stored adjacently, and points are stored in
+    //! leaf order so that every subtree covers a contiguous range of the point array. Leaves hold buckets of up to
+    //! bucket_size points which are scanned linearly.
+    //!
+    //! The search interface matches kd_tree so the two may be used interchangeably:
+    //! \code
+    //! flat_kd_tree< point_3D > tree( points, compare );
+    //! axis_aligned_bounding_box< point_3D > range( point_3D( 0.0, 0.0, 0.0 ), point_3D( 5.0, 5.0, 5.0 ) );
+    //! tree.search( range, visitor, compare );
+    //! \endcode
+    //! Unlike kd_tree, points in partially overlapped leaves are tested against the range so that only points inside the
+    //! range are visited.
+    template <typename NumericSequence>
+    class flat_kd_tree
+    {
+    public:
+
+        typedef NumericSequence                                             sequence_type;
+        typedef typename geometric_traits< sequence_type >::dimension_type  dimension_type;
+        typedef typename geometric_traits< sequence_type >::arithmetic_type numeric_type;
+
+        BOOST_STATIC_CONSTANT( std::size_t, default_bucket_size = 8 );
+        BOOST_STATIC_CONSTANT( std::size_t, default_parallel_threshold = 16384 );
+
+        //! The tree is built with exact comparisons so that the region of each node bounds its points exactly. compare is taken
+        //! for compatibility with kd_tree and is applied only by search.
+        template <typename PointSequence, typename NumberComparisonPolicy>
+        flat_kd_tree( const PointSequence& pSequence, const NumberComparisonPolicy& /*compare*/, std::size_t bucketSize = default_bucket_size, typename boost::enable_if< is_point_sequence< PointSequence > >::type* = 0 )
+            : m_region( make_aabb<NumericSequence>( pSequence ) )
+            , m_bucketSize( (std::max)( bucketSize, std::size_t( 1 ) ) )
+        {
+            serial_executor executor;
+            build( pSequence, executor, (std::numeric_limits<std::size_t>::max)() );
+        }
+
+        //! Build the tree using executor to partition the nodes of each level concurrently. Levels with at most parallelThreshold points are partitioned serially.
+        //! The resulting tree is identical to the one built by the serial constructor.
+        template <typename PointSequence, typename NumberComparisonPolicy, typename Executor>
+        flat_kd_tree( const PointSequence& pSequence, const NumberComparisonPolicy& /*compare*/, Executor&& executor, std::size_t bucketSize = default_bucket_size, std::size_t parallelThreshold = default_parallel_threshold, typename std::enable_if< is_point_sequence< PointSequence >::value && is_executor< typename std::decay<Executor>::type >::value >::type* = 0 )
+            : m_region( make_aabb<NumericSequence>( pSequence ) )
+            , m_bucketSize( (std::max)( bucketSize, std::size_t( 1 ) ) )
+        {
+            build( pSequence, executor, parallelThreshold );
+        }
+
+        //! Traverse the tree on a range and visit all points in the specified range.
+        template <typename T, typename Visitor, typename NumberComparisonPolicy>
+        void search( const axis_aligned_bounding_box<T>& range, Visitor&& visitor, const NumberComparisonPolicy& compare ) const
+        {
+            if( m_nodes.empty() )
+                return;
+
+            if( range.contains( m_region, compare ) )
+                visit_range( m_nodes[0], visitor );
+            else if( range.intersects( m_region, compare ) )
+                search<0>( 0, m_region, range, visitor, compare );
+        }
+
+        //! Find the k points nearest to p. The result is sorted by ascending distance.
+        template <typename Point>
+        std::vector< sequence_type > nearest( const Point& p, std::size_t k ) const
+        {
+            using distance_type = typename result_of::point_point_distance_sqrd<Point, sequence_type>::type;
+            bounded_max_heap< distance_type, std::uint32_t > heap( k );
+            if( k > 0 && !m_nodes.empty() )
+                nearest<0>( 0, m_region, p, heap );
+
+            std::vector< sequence_type > result;
+            result.reserve( heap.size() );
+            for( const auto& item : heap.release_sorted() )
+                result.push_back( m_points[item.second] );
+            return result;
+        }
+
+        //! Visit all points whose distance from p is less than or equal to r.
+        template <typename Point, typename Length, typename Visitor>
+        void radius_search( const Point& p, const Length& r, Visitor&& visitor ) const
+        {
+            if( !m_nodes.empty() )
+                radius_search<0>( 0, m_region, p, r * r, visitor );
+        }
+
+        //! Find the points inside each range of a batch and return their input indices in CSR form (see kd_tree_batch_result).
+        //! The ranges must be a random access range of axis_aligned_bounding_box. Ranges are closed and tested with exact comparisons.
+        //! Queries are processed in the order of the leaf holding the centre of each range so consecutive queries visit similar nodes.
+        template <typename BoxRange>
+        kd_tree_batch_result batch_search( const BoxRange& ranges ) const
+        {
+            serial_executor executor;
+            return batch_search_impl( ranges, executor, (std::numeric_limits<std::size_t>::max)() );
+        }
+
+        //! Process a batch of range queries concurrently on executor in chunks of grainSize queries (0 selects a default).
+        //! The result is identical to the serial batch_search.
+        template <typename BoxRange, typename Executor>
+        kd_tree_batch_result batch_search( const BoxRange& ranges, Executor&& executor, std::size_t grainSize = 0, typename std::enable_if< is_executor< typename std::decay<Executor>::type >::value >::type* = 0 ) const
+        {
+            return batch_search_impl( ranges, executor, grainSize );
+        }
+
+        //! Process a batch of range queries under a standard execution policy, e.g. batch_search( std::execution::par, ranges ).
+        template <typename ExecutionPolicy, typename BoxRange>
+        kd_tree_batch_result batch_search( ExecutionPolicy&& policy, const BoxRange& ranges, typename std::enable_if< is_execution_policy< typename std::decay<ExecutionPolicy>::type >::value >::type* = 0 ) const
+        {
+            auto executor = make_policy_executor( policy );
+            return batch_search_impl( ranges, executor, 0 );
+        }
+
+        std::size_t size() const { return m_points.size(); }
+        bool        empty() const { return m_points.empty(); }
+        std::size_t get_bucket_size() const { return m_bucketSize; }
+
+        //! Two trees are equal if they have the same nodes, split values and points in leaf order.
+        friend bool operator ==( const flat_kd_tree& lhs, const flat_kd_tree& rhs )
+        {
+            if( lhs.m_nodes.size() != rhs.m_nodes.size() || lhs.m_points.size() != rhs.m_points.size() )
+                return false;
+
+            for( std::size_t i = 0; i < lhs.m_nodes.size(); ++i )
+            {
+                const node& a = lhs.m_nodes[i];
+                const node& b = rhs.m_nodes[i];
+                if( a.begin != b.begin || a.end != b.end || a.child != b.child || (!a.is_leaf() && a.split != b.split) )
+                    return false;
+            }
+
+            for( std::size_t i = 0; i < lhs.m_points.size(); ++i )
+                if( lhs.m_indices[i] != rhs.m_indices[i] || !numeric_sequence_equals( lhs.m_points[i], rhs.m_points[i], direct_comparison_policy() ) )
+                    return false;
+
+            return true;
+        }
+
+        friend bool operator !=( const flat_kd_tree& lhs, const flat_kd_tree& rhs )
+        {
+            return !(lhs == rhs);
+        }
+
+        //! Access the points in leaf order.
+        const std::vector< sequence_type >& get_points() const { return m_points; }
+
+        //! Access the input index of each point in leaf order.
+        const std::vector< std::uint32_t >& get_indices() const { return m_indices; }
+
+    private:
+
+        struct node
+        {
+            node( std::uint32_t b, std::uint32_t e )
+                : split()
+                , begin( b )
+                , end( e )
+                , child( 0 )
+            {}
+
+            bool is_leaf() const { return child == 0; }
+
+            numeric_type  split; //! coordinate of the splitting plane on the level's dimension.
+            std::uint32_t begin; //! first point of the subtree.
+            std::uint32_t end;   //! one past the last point of the subtree.
+            std::uint32_t child; //! index of the left child (the right child follows it) or 0 for leaves.
+        };
+
+        using entry = std::pair< sequence_type, std::uint32_t >;
+
+        template <typename PointSequence, typename Executor>
+        void build( const PointSequence& pSequence, Executor& executor, std::size_t parallelThreshold )
+        {
+            std::size_t pSize = point_sequence_traits< PointSequence >::size( pSequence );
+            if( pSize == 0 )
+                return;
+
+            GEOMETRIX_ASSERT( pSize < (std::numeric_limits<std::uint32_t>::max)() );
+
+            //! Points are partitioned together with their input index and then split into separate arrays.
+            std::vector< entry > entries;
+            entries.reserve( pSize );
+            std::uint32_t index = 0;
+            for( auto it = point_sequence_traits< PointSequence >::begin( pSequence ), end = point_sequence_traits< PointSequence >::end( pSequence ); it != end; ++it )
+                entries.emplace_back( *it, index++ );
+
+            m_nodes.reserve( 2 * (pSize / m_bucketSize + 1) );
+            m_nodes.emplace_back( std::uint32_t( 0 ), static_cast<std::uint32_t>( pSize ) );
+            build_level<0>( 0, 1, entries, executor, parallelThreshold );
+
+            m_points.reserve( pSize );
+            m_indices.reserve( pSize );
+            for( const auto& e : entries )
+            {
+                m_points.push_back( e.first );
+                m_indices.push_back( e.second );
+            }
+        }
+
+        //! Split each node in [levelBegin, levelEnd) which holds more than a bucket of points. All nodes on a level share the same dimension.
+        //! The children of each split node depend only on its size, so they are allocated first and the nodes are then partitioned independently.
+        //! Points are partitioned exactly so that none in the left child lies above the split and none in the right child below it.
+        template <std::size_t Dimension, typename Executor>
+        void build_level( std::size_t levelBegin, std::size_t levelEnd, std::vector< entry >& entries, Executor& executor, std::size_t parallelThreshold )
+        {
+            for( std::size_t i = levelBegin; i < levelEnd; ++i )
+            {
+                std::uint32_t begin = m_nodes[i].begin;
+                std::uint32_t end = m_nodes[i].end;
+                if( end - begin <= m_bucketSize )
+                    continue;
+
+                std::uint32_t median = begin + (end - begin) / 2;
+                m_nodes[i].child = static_cast<std::uint32_t>( m_nodes.size() );
+                m_nodes.emplace_back( begin, median );
+                m_nodes.emplace_back( median, end );
+            }
+
+            if( m_nodes.size() == levelEnd )
+                return;
+
+            auto dCompare = []( const entry& lhs, const entry& rhs )
+            {
+                return get<Dimension>( lhs.first ) < get<Dimension>( rhs.first );
+            };
+
+            auto partition = [&, this]( std::size_t first, std::size_t last )
+            {
+                for( std::size_t i = levelBegin + first; i < levelBegin + last; ++i )
+                {
+                    node& n = m_nodes[i];
+                    if( n.is_leaf() )
+                        continue;
+
+                    std::uint32_t median = m_nodes[n.child].end;
+                    std::nth_element( entries.begin() + n.begin, entries.begin() + median, entries.begin() + n.end, dCompare );
+                    n.split = get<Dimension>( entries[median].first );
+                }
+            };
+
+            //! Nodes on a level are of nearly equal size; group them so each task partitions about parallelThreshold points.
+            std::size_t nodeSize = m_nodes[levelBegin].end - m_nodes[levelBegin].begin;
+            std::size_t nNodes = levelEnd - levelBegin;
+            if( nodeSize * nNodes > parallelThreshold && nNodes > 1 )
+                parallel_for( executor, nNodes, parallelThreshold / (std::max)( nodeSize, std::size_t( 1 ) ), partition );
+            else
+                partition( 0, nNodes );
+
+            build_level<(Dimension + 1) % dimension_type::value>( levelEnd, m_nodes.size(), entries, executor, parallelThreshold );
+        }
+
+        template <std::size_t Dimension, typename T, typename Visitor, typename NumberComparisonPolicy>
+        void search( std::uint32_t index, const axis_aligned_bounding_box<sequence_type>& region, const axis_aligned_bounding_box<T>& range, Visitor& visitor, const NumberComparisonPolicy& compare ) const
+        {
+            const node& n = m_nodes[index];
+            if( n.is_leaf() )
+            {
+                for( std::uint32_t i = n.begin; i < n.end; ++i )
+                    if( range.intersects( m_points[i], compare ) )
+                        visitor( m_points[i] );
+                return;
+            }
+
+            //! Search the left child.
+            {
+                auto upperBound = construct<sequence_type>( region.get_upper_bound() );
+                set<Dimension>( upperBound, n.split );
+                axis_aligned_bounding_box< sequence_type > left( region.get_lower_bound(), upperBound );
+                if( range.contains( left, compare ) )
+                    visit_range( m_nodes[n.child], visitor );
+                else if( range.intersects( left, compare ) )
+                    search<(Dimension + 1) % dimension_type::value>( n.child, left, range, visitor, compare );
+            }
+
+            //! Search the right child.
+            {
+                auto lowerBound = construct<sequence_type>( region.get_lower_bound() );
+                set<Dimension>( lowerBound, n.split );
+                axis_aligned_bounding_box< sequence_type > right( lowerBound, region.get_upper_bound() );
+                if( range.contains( right, compare ) )
+                    visit_range( m_nodes[n.child + 1], visitor );
+                else if( range.intersects( right, compare ) )
+                    search<(Dimension + 1) % dimension_type::value>( n.child + 1, right, range, visitor, compare );
+            }
+        }
+
+        template <std::size_t Dimension, typename Point, typename Heap>
+        void nearest( std::uint32_t index, const axis_aligned_bounding_box<sequence_type>& region, const Point& p, Heap& heap ) const
+        {
+            const node& n = m_nodes[index];
+            if( n.is_leaf() )
+            {
+                for( std::uint32_t i = n.begin; i < n.end; ++i )
+                    heap.push( point_point_distance_sqrd( p, m_points[i] ), i );
+                return;
+            }
+
+            auto upperBound = construct<sequence_type>( region.get_upper_bound() );
+            set<Dimension>( upperBound, n.split );
+            axis_aligned_bounding_box< sequence_type > left( region.get_lower_bound(), upperBound );
+            auto lowerBound = construct<sequence_type>( region.get_lower_bound() );
+            set<Dimension>( lowerBound, n.split );
+            axis_aligned_bounding_box< sequence_type > right( lowerBound, region.get_upper_bound() );
+
+            auto dLeft = point_aabb_distance_sqrd( p, left );
+            auto dRight = point_aabb_distance_sqrd( p, right );
+
+            //! Visit the closer child first so the bound tightens before the farther child is considered.
+            if( dRight < dLeft )
+            {
+                if( heap.accepts( dRight ) )
+                    nearest<(Dimension + 1) % dimension_type::value>( n.child + 1, right, p, heap );
+                if( heap.accepts( dLeft ) )
+                    nearest<(Dimension + 1) % dimension_type::value>( n.child, left, p, heap );
+            }
+            else
+            {
+                if( heap.accepts( dLeft ) )
+                    nearest<(Dimension + 1) % dimension_type::value>( n.child, left, p, heap );
+                if( heap.accepts( dRight ) )
+                    nearest<(Dimension + 1) % dimension_type::value>( n.child + 1, right, p, heap );
+            }
+        }
+
+        template <std::size_t Dimension, typename Point, typename Length, typename Visitor>
+        void radius_search( std::uint32_t index, const axis_aligned_bounding_box<sequence_type>& region, const Point& p, const Length& r2, Visitor& visitor ) const
+        {
+            const node& n = m_nodes[index];
+            if( n.is_leaf() )
+            {
+                for( std::uint32_t i = n.begin; i < n.end; ++i )
+                    if( !(r2 < point_point_distance_sqrd( p, m_points[i] )) )
+                        visitor( m_points[i] );
+                return;
+            }
+
+            {
+                auto upperBound = construct<sequence_type>( region.get_upper_bound() );
+                set<Dimension>( upperBound, n.split );
+                axis_aligned_bounding_box< sequence_type > left( region.get_lower_bound(), upperBound );
+                if( !(r2 < point_aabb_distance_sqrd( p, left )) )
+                    radius_search<(Dimension + 1) % dimension_type::value>( n.child, left, p, r2, visitor );
+            }
+
+            {
+                auto lowerBound = construct<sequence_type>( region.get_lower_bound() );
+                set<Dimension>( lowerBound, n.split );
+                axis_aligned_bounding_box< sequence_type > right( lowerBound, region.get_upper_bound() );
+                if( !(r2 < point_aabb_distance_sqrd( p, right )) )
+                    radius_search<(Dimension + 1) % dimension_type::value>( n.child + 1, right, p, r2, visitor );
+            }
+        }
+
+        template <typename BoxRange, typename Executor>
+        kd_tree_batch_result batch_search_impl( const BoxRange& ranges, Executor& executor, std::size_t grainSize ) const
+        {
+            using std::begin;
+            using std::end;
+
+            auto first = begin( ranges );
+            std::size_t nQueries = static_cast<std::size_t>( std::distance( first, end( ranges ) ) );
+
+            kd_tree_batch_result result;
+            result.offsets.assign( nQueries + 1, 0 );
+            if( nQueries == 0 || m_nodes.empty() )
+                return result;
+
+            GEOMETRIX_ASSERT( nQueries < (std::numeric_limits<std::uint32_t>::max)() );
+
+            //! Order queries by the position of the leaf containing their centre. Points are stored in leaf order so this sorts queries spatially.
+            std::vector< std::pair< std::uint32_t, std::uint32_t > > order( nQueries );
+            for( std::size_t q = 0; q < nQueries; ++q )
+                order[q] = std::make_pair( locate<0>( 0, first[q] ), static_cast<std::uint32_t>( q ) );
+            std::sort( order.begin(), order.end() );
+
+            if( grainSize == 0 )
+                grainSize = default_grain_size( nQueries );
+            grainSize = (std::min)( grainSize, nQueries );
+
+            //! Each chunk of sorted queries collects its hits in a private buffer. The buffers are then gathered into query order.
+            std::vector< std::vector< std::uint32_t > > chunkHits( (nQueries + grainSize - 1) / grainSize );
+            std::vector< std::size_t > chunkStart( nQueries );
+            parallel_for( executor, nQueries, grainSize, [&, this]( std::size_t firstQuery, std::size_t lastQuery )
+            {
+                auto& hits = chunkHits[firstQuery / grainSize];
+                for( std::size_t i = firstQuery; i < lastQuery; ++i )
+                {
+                    std::uint32_t q = order[i].second;
+                    chunkStart[q] = hits.size();
+                    const auto& range = first[q];
+                    if( range.intersects( m_region ) )
+                        query<0>( 0, m_region, range, hits );
+                    result.offsets[q + 1] = hits.size() - chunkStart[q];
+                }
+            });
+
+            std::vector< std::uint32_t > chunkOf( nQueries );
+            for( std::size_t i = 0; i < nQueries; ++i )
+                chunkOf[order[i].second] = static_cast<std::uint32_t>( i / grainSize );
+
+            for( std::size_t q = 0; q < nQueries; ++q )
+                result.offsets[q + 1] += result.offsets[q];
+
+            result.indices.resize( result.offsets.back() );
+            parallel_for( executor, nQueries, grainSize, [&]( std::size_t firstQuery, std::size_t lastQuery )
+            {
+                for( std::size_t q = firstQuery; q < lastQuery; ++q )
+                {
+                    auto src = chunkHits[chunkOf[q]].begin() + chunkStart[q];
+                    std::copy( src, src + (result.offsets[q + 1] - result.offsets[q]), result.indices.begin() + result.offsets[q] );
+                }
+            });
+
+            return result;
+        }
+
+        //! Find the position of the leaf containing the centre of range.
+        template <std::size_t Dimension, typename T>
+        std::uint32_t locate( std::uint32_t index, const axis_aligned_bounding_box<T>& range ) const
+        {
+            const node& n = m_nodes[index];
+            if( n.is_leaf() )
+                return n.begin;
+
+            auto centre = (get<Dimension>( range.get_lower_bound() ) + get<Dimension>( range.get_upper_bound() )) / 2;
+            return locate<(Dimension + 1) % dimension_type::value>( centre < n.split ? n.child : n.child + 1, range );
+        }
+
+        template <std::size_t Dimension, typename T>
+        void query( std::uint32_t index, const axis_aligned_bounding_box<sequence_type>& region, const axis_aligned_bounding_box<T>& range, std::vector< std::uint32_t >& hits ) const
+        {
+            const node& n = m_nodes[index];
+            if( range.contains( region ) )
+            {
+                hits.insert( hits.end(), m_indices.begin() + n.begin, m_indices.begin() + n.end );
+                return;
+            }
+
+            if( n.is_leaf() )
+            {
+                scan_bucket( n, range, hits );
+                return;
+            }
+
+            {
+                auto upperBound = construct<sequence_type>( region.get_upper_bound() );
+                set<Dimension>( upperBound, n.split );
+                axis_aligned_bounding_box< sequence_type > left( region.get_lower_bound(), upperBound );
+                if( range.intersects( left ) )
+                    query<(Dimension + 1) % dimension_type::value>( n.child, left, range, hits );
+            }
+
+            {
+                auto lowerBound = construct<sequence_type>( region.get_lower_bound() );
+                set<Dimension>( lowerBound, n.split );
+                axis_aligned_bounding_box< sequence_type > right( lowerBound, region.get_upper_bound() );
+                if( range.intersects( right ) )
+                    query<(Dimension + 1) % dimension_type::value>( n.child + 1, right, range, hits );
+            }
+        }
+
+        //! Test the points of a leaf in fixed size blocks: first a branch free containment mask, then compaction of the hits.
+        template <typename T>
+        void scan_bucket( const node& n, const axis_aligned_bounding_box<T>& range, std::vector< std::uint32_t >& hits ) const
+        {
+            const std::uint32_t block_size = 16;
+            const auto& lo = range.get_lower_bound();
+            const auto& hi = range.get_upper_bound();
+            std::uint8_t inside[block_size];
+            for( std::uint32_t i = n.begin; i < n.end; i += block_size )
+            {
+                std::uint32_t count = (std::min)( block_size, n.end - i );
+                const sequence_type* pPoints = m_points.data() + i;
+                for( std::uint32_t j = 0; j < count; ++j )
+                    inside[j] = detail::flat_kd_tree_box_contains( pPoints[j], lo, hi, std::make_index_sequence<dimension_type::value>() );
+                for( std::uint32_t j = 0; j < count; ++j )
+                    if( inside[j] )
+                        hits.push_back( m_indices[i + j] );
+            }
+        }
+
+        //! Subtrees are contiguous in the point array so visiting a whole subtree is a linear scan.
+        template <typename Visitor>
+        void visit_range( const node& n, Visitor& visitor ) const
+        {
+            for( std::uint32_t i = n.begin; i < n.end; ++i )
+                visitor( m_points[i] );
+        }
+
+        std::vector< node >                         m_nodes;
+        std::vector< sequence_type >                m_points;
+        std::vector< std::uint32_t >                m_indices;
+        axis_aligned_bounding_box< sequence_type >  m_region;
+        std::size_t                                 m_bucketSize;
+
+    };
+
+}//namespace geometrix;
+
+#endif //GEOMETRIX_FLAT_KD_TREE_HPP
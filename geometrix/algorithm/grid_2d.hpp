@@ -63,6 +63,18 @@ namespace geometrix
         {            
             return m_grid[i][j];
         }
+
+        //! Every cell of a dense grid exists so these never return null. They match the lookups of hash_grid_2d.
+        template <typename Point>
+        data_type const* find_cell(const Point& point) const
+        {
+            return &get_cell(point);
+        }
+
+        data_type const* find_cell(boost::uint32_t i, boost::uint32_t j) const
+        {
+            return &get_cell(i, j);
+        }
         
         const traits_type& get_traits() const { return m_gridTraits; }
 
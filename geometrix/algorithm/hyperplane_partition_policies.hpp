@@ -14,6 +14,12 @@
 #include <geometrix/primitive/hyperplane_traits.hpp>
 #include <geometrix/algorithm/classify_simplex_to_plane.hpp>
 #include <boost/dynamic_bitset.hpp>
+#include <boost/random/linear_congruential.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
 
 namespace geometrix {
     namespace partition_policies {
@@ -158,6 +164,120 @@ namespace geometrix {
             Extractor m_extract;
             NumberComparisonPolicy m_compare;
         };
+
+        namespace result_of {
+            template <typename T>
+            struct sampled_scored_selector_policy : autopartition_policy<T>
+            {};
+        }//! namespace result_of;
+
+        //! A strategy which scores a random sample of the unused geometries as partitions against a random sample of the geometries
+        //! with the same score as the scored_selector_policy. Selecting a partition costs O(candidates * sample size) rather than O(n^2).
+        //! The samples are drawn from a generator seeded by the seed and the size of the range so that selection is deterministic and
+        //! the policy may be called concurrently.
+        template <typename Extractor, typename NumberComparisonPolicy, typename RNG = boost::random::minstd_rand>
+        struct sampled_scored_selector_policy
+        {
+            BOOST_STATIC_CONSTANT(std::size_t, default_number_of_candidates = 8);
+            BOOST_STATIC_CONSTANT(std::size_t, default_sample_size = 64);
+
+            sampled_scored_selector_policy( const Extractor& extractor, const NumberComparisonPolicy& compare = NumberComparisonPolicy(), std::size_t nCandidates = default_number_of_candidates, std::size_t sampleSize = default_sample_size, std::uint32_t seed = 42 )
+            : m_extract(extractor)
+            , m_compare( compare )
+            , m_candidates( (std::max)(nCandidates, std::size_t(1)) )
+            , m_sample_size( (std::max)(sampleSize, std::size_t(1)) )
+            , m_seed( seed )
+            {}
+
+            template <typename Range>
+            typename result_of::sampled_scored_selector_policy<Range>::type operator()( Range&& r, boost::dynamic_bitset<>& usedBits ) const
+            {
+                // Blend factor for optimizing for balance or splits (same as scored_selector_policy)
+                const double K = 0.8;
+
+                auto first = boost::begin( r );
+                std::size_t n = boost::size( r );
+                std::size_t nUnused = n - usedBits.count();
+                if( nUnused == 0 )
+                    return boost::end( r );
+
+                RNG rng( static_cast<std::uint32_t>(m_seed + n) );
+                auto random_index = [&rng]( std::size_t size ) { return boost::random::uniform_int_distribution<std::size_t>( 0, size - 1 )( rng ); };
+
+                //! Draw distinct unused candidates. When there are few unused take them all.
+                std::vector<std::size_t> candidates;
+                if( nUnused <= m_candidates )
+                {
+                    for( std::size_t i = 0; i < n; ++i )
+                        if( !usedBits[i] )
+                            candidates.push_back( i );
+                }
+                else
+                {
+                    while( candidates.size() < m_candidates )
+                    {
+                        auto i = random_index( n );
+                        if( !usedBits[i] && std::find( candidates.begin(), candidates.end(), i ) == candidates.end() )
+                            candidates.push_back( i );
+                    }
+                }
+
+                //! Score against all geometries when there are few, else against a sample drawn with replacement.
+                std::vector<std::size_t> sample;
+                if( n <= m_sample_size )
+                {
+                    for( std::size_t i = 0; i < n; ++i )
+                        sample.push_back( i );
+                }
+                else
+                {
+                    for( std::size_t i = 0; i < m_sample_size; ++i )
+                        sample.push_back( random_index( n ) );
+                }
+
+                auto bestScore = (std::numeric_limits<double>::max)();
+                auto bestIndex = candidates.front();
+                for( auto c : candidates )
+                {
+                    int numInFront = 0, numBehind = 0, numStraddling = 0;
+                    auto split = make_hyperplane( m_extract( *(first + c) ) );
+                    for( auto j : sample )
+                    {
+                        if( j == c )
+                            continue;
+                        switch( classify_simplex_to_plane( m_extract( *(first + j) ), split, m_compare ) )
+                        {
+                        case plane_orientation::coplanar_with_plane:
+                        case plane_orientation::in_front_of_plane:
+                            ++numInFront;
+                            break;
+                        case plane_orientation::in_back_of_plane:
+                            ++numBehind;
+                            break;
+                        case plane_orientation::straddling_plane:
+                            ++numStraddling;
+                            break;
+                        }
+                    }
+
+                    double score = K * numStraddling + (1.0 - K) * std::abs( numInFront - numBehind );
+                    if( score < bestScore || (score == bestScore && c < bestIndex) )
+                    {
+                        bestScore = score;
+                        bestIndex = c;
+                    }
+                }
+
+                usedBits.set( bestIndex );
+                return first + bestIndex;
+            }
+
+            Extractor m_extract;
+            NumberComparisonPolicy m_compare;
+            std::size_t m_candidates;
+            std::size_t m_sample_size;
+            std::uint32_t m_seed;
+        };
     }
 }//! namespace geometrix;
 
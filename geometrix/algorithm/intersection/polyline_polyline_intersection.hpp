@@ -13,6 +13,14 @@
 #include <geometrix/primitive/point_sequence_traits.hpp>
 #include <geometrix/primitive/point.hpp>
 #include <geometrix/arithmetic/arithmetic_promotion_policy.hpp>
+#include <geometrix/algorithm/point_sequence/monotone_chains.hpp>
+#include <geometrix/utility/executor.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 /////////////////////////////////////////////////////////////////////////////
 //
@@ -57,6 +65,185 @@ inline bool polyline_polyline_intersect( const Polyline1& A, const Polyline2& B,
 	return intersected;
 }
 
+namespace detail {
+
+	template <typename Polylines>
+	using polyline_range_value_t = typename std::decay<decltype(*std::begin(std::declval<const Polylines&>()))>::type;
+
+	//! The segments of a range of polylines numbered one polyline after another and indexed by their monotone chains.
+	template <typename Polylines, typename CoordinateType>
+	class polyline_set_chains
+	{
+	public:
+
+		using access = point_sequence_traits<polyline_range_value_t<Polylines>>;
+
+		polyline_set_chains(const Polylines& polylines)
+			: m_polylines(polylines)
+			, m_chains(count_segments(polylines, m_owners, m_offsets)
+			         , [this](std::size_t k) -> decltype(auto) { return point_at(k, 0); }
+			         , [this](std::size_t k) -> decltype(auto) { return point_at(k, 1); }
+			         , [this](std::size_t k) { return m_owners[k] == m_owners[k - 1]; })
+		{}
+
+		const monotone_chains<CoordinateType>& get_chains() const { return m_chains; }
+
+		//! The polyline holding segment k and the index of its first point within that polyline.
+		std::pair<std::size_t, std::size_t> locate(std::size_t k) const { return std::make_pair(m_owners[k], k - m_offsets[m_owners[k]]); }
+
+		decltype(auto) get_point(std::size_t polyline, std::size_t i) const { return access::get_point(std::begin(m_polylines)[polyline], i); }
+
+	private:
+
+		static std::size_t count_segments(const Polylines& polylines, std::vector<std::size_t>& owners, std::vector<std::size_t>& offsets)
+		{
+			std::size_t index = 0;
+			for (const auto& p : polylines)
+			{
+				offsets.push_back(owners.size());
+				std::size_t size = access::size(p);
+				if (size > 1)
+					owners.insert(owners.end(), size - 1, index);
+				++index;
+			}
+
+			return owners.size();
+		}
+
+		decltype(auto) point_at(std::size_t k, std::size_t end) const
+		{
+			auto loc = locate(k);
+			return get_point(loc.first, loc.second + end);
+		}
+
+		const Polylines&                m_polylines;
+		std::vector<std::size_t>        m_owners;//! the polyline of each segment.
+		std::vector<std::size_t>        m_offsets;//! the first segment of each polyline.
+		monotone_chains<CoordinateType> m_chains;
+
+	};
+
+	template <typename Point>
+	struct polyline_crossing
+	{
+		std::size_t       i;//! segment in the query polyline.
+		std::size_t       b;//! indexed polyline.
+		std::size_t       j;//! segment in the indexed polyline.
+		intersection_type iType;
+		Point             xPoints[2];
+	};
+
+	//! Find the crossings of polyline A with the indexed polylines ordered by segment of A, then indexed polyline and segment.
+	template <typename Polyline, typename PolylineSetChains, typename Point, typename NumberComparisonPolicy>
+	inline void find_polyline_crossings(const Polyline& A, const PolylineSetChains& index, std::vector<polyline_crossing<Point>>& crossings, const NumberComparisonPolicy& cmp)
+	{
+		using access = point_sequence_traits<Polyline>;
+		using coordinate_type = typename geometric_traits<Point>::arithmetic_type;
+		std::size_t size = access::size(A);
+		if (size < 2)
+			return;
+
+		monotone_chains<coordinate_type> chains(size - 1, [&A](std::size_t i) -> decltype(auto) { return access::get_point(A, i); });
+		chains.for_each_candidate(index.get_chains(), cmp, [&](std::size_t i, std::size_t k)
+		{
+			auto loc = index.locate(k);
+			polyline_crossing<Point> x;
+			x.iType = segment_segment_intersection(access::get_point(A, i), access::get_point(A, i + 1), index.get_point(loc.first, loc.second), index.get_point(loc.first, loc.second + 1), x.xPoints, cmp);
+			if (x.iType != e_non_crossing)
+			{
+				x.i = i;
+				x.b = loc.first;
+				x.j = loc.second;
+				crossings.push_back(x);
+			}
+			return false;
+		});
+
+		std::sort(crossings.begin(), crossings.end(), [](const polyline_crossing<Point>& lhs, const polyline_crossing<Point>& rhs)
+		{
+			return std::tie(lhs.i, lhs.b, lhs.j) < std::tie(rhs.i, rhs.b, rhs.j);
+		});
+	}
+
+	template <typename Point, typename Visitor>
+	inline bool visit_polyline_crossings(std::size_t a, const std::vector<polyline_crossing<Point>>& crossings, Visitor& visitor)
+	{
+		for (const auto& x : crossings)
+			if (visitor(a, x.b, x.iType, x.i, x.i + 1, x.j, x.j + 1, x.xPoints[0], x.xPoints[1]))
+				return true;
+		return false;
+	}
+
+	template <typename Polylines1, typename Polylines2>
+	using polyline_sets_point_t = point<typename select_arithmetic_type_from_sequences<typename point_sequence_traits<polyline_range_value_t<Polylines1>>::point_type, typename point_sequence_traits<polyline_range_value_t<Polylines2>>::point_type>::type, 2>;
+
+}//namespace detail;
+
+//! \brief Compute the intersections between each polyline in the range As and each polyline in the range Bs.
+//! The type Visitor must define bool operator()(size_t a, size_t b, intersection_type, size_t i1, size_t j1, size_t i2, size_t j2, point<arithmetic_type_of<PointA,PointB>::type, 2>[2])
+//! which processes an intersection between segment i1-j1 of As[a] and segment i2-j2 of Bs[b] as for polyline_polyline_intersect. The return value is whether the algorithm should cease.
+//! The segments of Bs are indexed by their monotone chains which the chains of each polyline in As query. Intersections are visited in order of a, i1, b and i2.
+//! Bs must be a random access range. Returns whether any intersection was found.
+template <typename Polylines1, typename Polylines2, typename Visitor, typename NumberComparisonPolicy>
+inline bool polyline_sets_intersect( const Polylines1& As, const Polylines2& Bs, Visitor&& visitor, const NumberComparisonPolicy& cmp )
+{
+	BOOST_CONCEPT_ASSERT((PointSequenceConcept<detail::polyline_range_value_t<Polylines1>>));
+	BOOST_CONCEPT_ASSERT((PointSequenceConcept<detail::polyline_range_value_t<Polylines2>>));
+	BOOST_CONCEPT_ASSERT((NumberComparisonPolicyConcept<NumberComparisonPolicy>));
+	using point_type = detail::polyline_sets_point_t<Polylines1, Polylines2>;
+	using coordinate_type = typename geometric_traits<point_type>::arithmetic_type;
+
+	detail::polyline_set_chains<Polylines2, coordinate_type> index(Bs);
+	std::vector<detail::polyline_crossing<point_type>> crossings;
+	bool intersected = false;
+	std::size_t a = 0;
+	for (const auto& A : As)
+	{
+		crossings.clear();
+		detail::find_polyline_crossings(A, index, crossings, cmp);
+		intersected = intersected || !crossings.empty();
+		if (detail::visit_polyline_crossings(a++, crossings, visitor))
+			return true;
+	}
+
+	return intersected;
+}
+
+//! \brief Compute the intersections between each polyline in the random access range As and each polyline in the range Bs.
+//! Chunks of at most grainSize polylines from As are searched in parallel on the executor. The visitor is then called from the calling thread
+//! in the same order as the serial version.
+template <typename Polylines1, typename Polylines2, typename Visitor, typename NumberComparisonPolicy, typename Executor, typename std::enable_if<is_executor<typename std::decay<Executor>::type>::value, int>::type = 0>
+inline bool polyline_sets_intersect( const Polylines1& As, const Polylines2& Bs, Visitor&& visitor, const NumberComparisonPolicy& cmp, Executor&& executor, std::size_t grainSize = 0 )
+{
+	BOOST_CONCEPT_ASSERT((PointSequenceConcept<detail::polyline_range_value_t<Polylines1>>));
+	BOOST_CONCEPT_ASSERT((PointSequenceConcept<detail::polyline_range_value_t<Polylines2>>));
+	BOOST_CONCEPT_ASSERT((NumberComparisonPolicyConcept<NumberComparisonPolicy>));
+	using point_type = detail::polyline_sets_point_t<Polylines1, Polylines2>;
+	using coordinate_type = typename geometric_traits<point_type>::arithmetic_type;
+
+	detail::polyline_set_chains<Polylines2, coordinate_type> index(Bs);
+	std::size_t nA = std::distance(std::begin(As), std::end(As));
+	if (grainSize == 0)
+		grainSize = default_grain_size(nA);
+
+	std::vector<std::vector<detail::polyline_crossing<point_type>>> crossings(nA);
+	parallel_for(executor, nA, grainSize, [&](std::size_t first, std::size_t last)
+	{
+		for (std::size_t a = first; a < last; ++a)
+			detail::find_polyline_crossings(std::begin(As)[a], index, crossings[a], cmp);
+	});
+
+	bool intersected = false;
+	for (std::size_t a = 0; a < nA; ++a)
+	{
+		intersected = intersected || !crossings[a].empty();
+		if (detail::visit_polyline_crossings(a, crossings[a], visitor))
+			return true;
+	}
+
+	return intersected;
+}
+
 }//namespace geometrix;
 
 #endif //GEOMETRIX_POLYLINE_POLYLINE_INTERSECTION_HPP
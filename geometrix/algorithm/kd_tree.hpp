@@ -12,6 +12,11 @@
 
 #include <geometrix/primitive/axis_aligned_bounding_box.hpp>
 #include <geometrix/primitive/point_sequence_utilities.hpp>
+#include <geometrix/algorithm/distance/point_point_distance.hpp>
+#include <geometrix/algorithm/distance/point_aabb_distance.hpp>
+#include <geometrix/utility/bounded_max_heap.hpp>
+#include <geometrix/utility/executor.hpp>
+#include <limits>
 #include <memory>
 
 namespace geometrix {
@@ -55,11 +60,34 @@ namespace geometrix {
         typedef typename geometric_traits< sequence_type >::dimension_type  dimension_type;
         typedef typename geometric_traits< sequence_type >::arithmetic_type numeric_type;
 
+        BOOST_STATIC_CONSTANT( std::size_t, default_parallel_threshold = 16384 );
+
         template <typename PointSequence, typename NumberComparisonPolicy, typename PartitionStrategy>
         kd_tree( const PointSequence& pSequence, const NumberComparisonPolicy& compare, const PartitionStrategy& partitionStrategy, typename boost::enable_if< is_point_sequence< PointSequence > >::type* =0 )
             : m_region( make_aabb<NumericSequence>(pSequence) )
         {
-            build( pSequence, compare, partitionStrategy );
+            serial_executor executor;
+            build( pSequence, compare, partitionStrategy, executor, (std::numeric_limits<std::size_t>::max)() );
+        }
+
+        //! Build the tree using executor to construct subtrees concurrently. Subtrees with at most parallelThreshold points are built serially.
+        //! The resulting tree is identical to the one built by the serial constructor.
+        template <typename PointSequence, typename NumberComparisonPolicy, typename PartitionStrategy, typename Executor>
+        kd_tree( const PointSequence& pSequence, const NumberComparisonPolicy& compare, const PartitionStrategy& partitionStrategy, Executor&& executor, std::size_t parallelThreshold = default_parallel_threshold, typename std::enable_if< is_point_sequence< PointSequence >::value && is_executor< typename std::decay<Executor>::type >::value >::type* = 0 )
+            : m_region( make_aabb<NumericSequence>(pSequence) )
+        {
+            build( pSequence, compare, partitionStrategy, executor, parallelThreshold );
+        }
+
+        //! Two trees are equal if they have the same structure, split values, regions and leaves.
+        friend bool operator ==( const kd_tree& lhs, const kd_tree& rhs )
+        {
+            return equals( &lhs, &rhs );
+        }
+
+        friend bool operator !=( const kd_tree& lhs, const kd_tree& rhs )
+        {
+            return !equals( &lhs, &rhs );
         }
 
         //! Traverse the tree on a range and visit all leaves in the specified range.
@@ -72,6 +100,31 @@ namespace geometrix {
                 search<0>( range, visitor, compare );
         }
 
+        //! Find the k points nearest to p. The result is sorted by ascending distance.
+        //! Subtrees are pruned when the distance from p to their region exceeds the kth best distance found so far.
+        template <typename Point>
+        std::vector< sequence_type > nearest( const Point& p, std::size_t k ) const
+        {
+            using distance_type = typename result_of::point_point_distance_sqrd<Point, sequence_type>::type;
+            bounded_max_heap< distance_type, const sequence_type* > heap( k );
+            if( k > 0 )
+                nearest_impl( p, heap );
+
+            std::vector< sequence_type > result;
+            result.reserve( heap.size() );
+            for( const auto& item : heap.release_sorted() )
+                result.push_back( *item.second );
+            return result;
+        }
+
+        //! Visit all points whose distance from p is less than or equal to r.
+        //! Subtrees are pruned by the distance from p to their region.
+        template <typename Point, typename Length, typename Visitor>
+        void radius_search( const Point& p, const Length& r, Visitor&& visitor ) const
+        {
+            radius_search_impl( p, r * r, visitor );
+        }
+
     private:
 
         kd_tree( const axis_aligned_bounding_box< sequence_type >& region )
@@ -87,75 +140,82 @@ namespace geometrix {
             template <typename U>
             friend class kd_tree;
 
-            template <typename PointSequence, typename NumberComparisonPolicy, typename PartitionStrategy>
-            static void build_tree( std::unique_ptr< kd_tree<T> >& pTree, PointSequence& pSequence, const NumberComparisonPolicy& compare, const PartitionStrategy& partitionStrategy )
+            //! Subtrees holding more than parallelThreshold points build their children concurrently on the executor.
+            template <typename NumberComparisonPolicy, typename PartitionStrategy, typename Executor>
+            static void build_tree( kd_tree<T>& tree, std::vector< sequence_type >& pSequence, const NumberComparisonPolicy& compare, const PartitionStrategy& partitionStrategy, Executor& executor, std::size_t parallelThreshold )
             {
                 std::size_t pSize = pSequence.size();
                 if( pSize == 1 )
                 {
-                    pTree->m_pLeaf.reset( new sequence_type( pSequence[0] ) );
-                }
-                else
-                {
-                    std::size_t medianIndex = partitionStrategy.template partition<Dimension>( pSequence, compare );
-                    pTree->m_median = get<Dimension>( pSequence[ medianIndex ] );
-
-                    //! Split to the left tree those that are on left or collinear of line... and to the right those on the right.
-                    std::vector< sequence_type > left( pSequence.begin(), pSequence.begin() + medianIndex );
-                    std::vector< sequence_type > right( pSequence.begin() + medianIndex, pSequence.end() );
-
-                    if( !left.empty() )
-                    {
-                        auto upperBound = construct<sequence_type>( pTree->m_region.get_upper_bound() );
-                        set<Dimension>(upperBound, pTree->m_median);
-                        pTree->m_pLeftChild.reset( new kd_tree<T>( axis_aligned_bounding_box< sequence_type >( pTree->m_region.get_lower_bound(), upperBound ) ) );
-                        kd_tree_builder<T, (Dimension+1)%D, D>::build_tree( pTree->m_pLeftChild, left, compare, partitionStrategy );
-                    }
-                    if( !right.empty() )
-                    {
-                        auto lowerBound = construct<sequence_type>( pTree->m_region.get_lower_bound() );
-                        set<Dimension>(lowerBound, pTree->m_median);
-                        pTree->m_pRightChild.reset( new kd_tree<T>( axis_aligned_bounding_box< sequence_type >( lowerBound, pTree->m_region.get_upper_bound() ) ) );
-                        kd_tree_builder<T, (Dimension+1)%D, D>::build_tree( pTree->m_pRightChild, right, compare, partitionStrategy );
-                    }
+                    tree.m_pLeaf.reset( new sequence_type( pSequence[0] ) );
+                    return;
                 }
-            }
-        };
-
-        template <typename PointSequence, typename NumberComparisonPolicy, typename PartitionStrategy>
-        void build( const PointSequence& pSequence, const NumberComparisonPolicy& compare, const PartitionStrategy& partitionStrategy )
-        {
-            std::size_t pSize = point_sequence_traits< PointSequence >::size( pSequence );
-            if( pSize == 1 )
-            {
-                m_pLeaf.reset( new sequence_type( point_sequence_traits< PointSequence >::get_point( pSequence, 0 ) ) );
-            }
-            else
-            {
-                std::vector< sequence_type > sortedSequence( point_sequence_traits< PointSequence >::begin( pSequence ), point_sequence_traits< PointSequence >::end( pSequence ) );
 
-                std::size_t medianIndex = partitionStrategy.template partition<0>( sortedSequence, compare );
-                m_median = get<0>( sortedSequence[ medianIndex ] );
+                std::size_t medianIndex = partitionStrategy.template partition<Dimension>( pSequence, compare );
+                tree.m_median = get<Dimension>( pSequence[ medianIndex ] );
 
                 //! Split to the left tree those that are on left or collinear of line... and to the right those on the right.
-                std::vector< sequence_type > left( sortedSequence.begin(), sortedSequence.begin() + medianIndex );
-                std::vector< sequence_type > right( sortedSequence.begin() + medianIndex, sortedSequence.end() );
+                std::vector< sequence_type > left( pSequence.begin(), pSequence.begin() + medianIndex );
+                std::vector< sequence_type > right( pSequence.begin() + medianIndex, pSequence.end() );
+
+                //! The parent's copy is no longer needed.
+                std::vector< sequence_type >().swap( pSequence );
 
                 if( !left.empty() )
                 {
-                    auto upperBound = construct<sequence_type>( m_region.get_upper_bound() );
-                    set<0>(upperBound, m_median);
-                    m_pLeftChild.reset( new kd_tree<NumericSequence>( axis_aligned_bounding_box< sequence_type >( m_region.get_lower_bound(), upperBound ) ) );
-                    kd_tree_builder<NumericSequence, 1, dimension_type::value>::build_tree( m_pLeftChild, left, compare, partitionStrategy );
+                    auto upperBound = construct<sequence_type>( tree.m_region.get_upper_bound() );
+                    set<Dimension>(upperBound, tree.m_median);
+                    tree.m_pLeftChild.reset( new kd_tree<T>( axis_aligned_bounding_box< sequence_type >( tree.m_region.get_lower_bound(), upperBound ) ) );
                 }
                 if( !right.empty() )
                 {
-                    auto lowerBound = construct<sequence_type>( m_region.get_lower_bound() );
-                    set<0>(lowerBound, m_median);
-                    m_pRightChild.reset(new kd_tree<NumericSequence>( axis_aligned_bounding_box< sequence_type >( lowerBound, m_region.get_upper_bound() ) ) );
-                    kd_tree_builder<NumericSequence, 1, dimension_type::value>::build_tree( m_pRightChild, right, compare, partitionStrategy );
+                    auto lowerBound = construct<sequence_type>( tree.m_region.get_lower_bound() );
+                    set<Dimension>(lowerBound, tree.m_median);
+                    tree.m_pRightChild.reset( new kd_tree<T>( axis_aligned_bounding_box< sequence_type >( lowerBound, tree.m_region.get_upper_bound() ) ) );
+                }
+
+                auto buildLeft = [&]()
+                {
+                    if( tree.m_pLeftChild )
+                        kd_tree_builder<T, (Dimension+1)%D, D>::build_tree( *tree.m_pLeftChild, left, compare, partitionStrategy, executor, parallelThreshold );
+                };
+                auto buildRight = [&]()
+                {
+                    if( tree.m_pRightChild )
+                        kd_tree_builder<T, (Dimension+1)%D, D>::build_tree( *tree.m_pRightChild, right, compare, partitionStrategy, executor, parallelThreshold );
+                };
+
+                //! Subtrees are disjoint so building them concurrently produces the same tree as building them in sequence.
+                if( pSize > parallelThreshold && tree.m_pLeftChild && tree.m_pRightChild )
+                    fork_join( executor, buildLeft, buildRight );
+                else
+                {
+                    buildLeft();
+                    buildRight();
                 }
             }
+        };
+
+        template <typename PointSequence, typename NumberComparisonPolicy, typename PartitionStrategy, typename Executor>
+        void build( const PointSequence& pSequence, const NumberComparisonPolicy& compare, const PartitionStrategy& partitionStrategy, Executor& executor, std::size_t parallelThreshold )
+        {
+            std::vector< sequence_type > sortedSequence( point_sequence_traits< PointSequence >::begin( pSequence ), point_sequence_traits< PointSequence >::end( pSequence ) );
+            kd_tree_builder<NumericSequence, 0, dimension_type::value>::build_tree( *this, sortedSequence, compare, partitionStrategy, executor, parallelThreshold );
+        }
+
+        static bool equals( const kd_tree* lhs, const kd_tree* rhs )
+        {
+            if( !lhs || !rhs )
+                return lhs == rhs;
+
+            if( !numeric_sequence_equals( lhs->m_region.get_lower_bound(), rhs->m_region.get_lower_bound(), direct_comparison_policy() ) ||
+                !numeric_sequence_equals( lhs->m_region.get_upper_bound(), rhs->m_region.get_upper_bound(), direct_comparison_policy() ) )
+                return false;
+
+            if( lhs->m_pLeaf || rhs->m_pLeaf )
+                return lhs->m_pLeaf && rhs->m_pLeaf && numeric_sequence_equals( *lhs->m_pLeaf, *rhs->m_pLeaf, direct_comparison_policy() );
+
+            return lhs->m_median == rhs->m_median && equals( lhs->m_pLeftChild.get(), rhs->m_pLeftChild.get() ) && equals( lhs->m_pRightChild.get(), rhs->m_pRightChild.get() );
         }
 
         template <std::size_t Dimension, typename Visitor, typename NumberComparisonPolicy>
@@ -201,6 +261,48 @@ namespace geometrix {
                 m_pRightChild->traverse_subtrees( v );
         }
 
+        template <typename Point, typename Heap>
+        void nearest_impl( const Point& p, Heap& heap ) const
+        {
+            if( m_pLeaf )
+            {
+                heap.push( point_point_distance_sqrd( p, *m_pLeaf ), m_pLeaf.get() );
+                return;
+            }
+
+            const kd_tree* pNear = m_pLeftChild.get();
+            const kd_tree* pFar = m_pRightChild.get();
+            auto dNear = pNear ? point_aabb_distance_sqrd( p, pNear->m_region ) : construct<typename Heap::key_type>( 0 );
+            auto dFar = pFar ? point_aabb_distance_sqrd( p, pFar->m_region ) : construct<typename Heap::key_type>( 0 );
+            if( !pNear || (pFar && dFar < dNear) )
+            {
+                std::swap( pNear, pFar );
+                std::swap( dNear, dFar );
+            }
+
+            //! Visit the closer child first so the bound tightens before the farther child is considered.
+            if( pNear && heap.accepts( dNear ) )
+                pNear->nearest_impl( p, heap );
+            if( pFar && heap.accepts( dFar ) )
+                pFar->nearest_impl( p, heap );
+        }
+
+        template <typename Point, typename Length, typename Visitor>
+        void radius_search_impl( const Point& p, const Length& r2, Visitor& visitor ) const
+        {
+            if( m_pLeaf )
+            {
+                if( !(r2 < point_point_distance_sqrd( p, *m_pLeaf )) )
+                    visitor( *m_pLeaf );
+                return;
+            }
+
+            if( m_pLeftChild && !(r2 < point_aabb_distance_sqrd( p, m_pLeftChild->m_region )) )
+                m_pLeftChild->radius_search_impl( p, r2, visitor );
+            if( m_pRightChild && !(r2 < point_aabb_distance_sqrd( p, m_pRightChild->m_region )) )
+                m_pRightChild->radius_search_impl( p, r2, visitor );
+        }
+
         typedef std::unique_ptr< kd_tree< sequence_type > > dimension_split;
         typedef sequence_type                               leaf;
         typedef std::unique_ptr< sequence_type >            leaf_ptr;
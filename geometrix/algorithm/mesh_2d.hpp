@@ -20,10 +20,16 @@
 #include <geometrix/algorithm/hash_grid_2d.hpp>
 #include <geometrix/algorithm/eberly_triangle_aabb_intersection.hpp>
 #include <geometrix/numeric/constants.hpp>
+#include <geometrix/utility/executor.hpp>
 
 #include <boost/utility/typed_in_place_factory.hpp>
 #include <boost/container/flat_set.hpp>
+#include <boost/range/iterator_range.hpp>
 #include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <boost/limits.hpp>
 
@@ -41,6 +47,122 @@ namespace geometrix
         using type = hash_grid_2d<Data, Traits>;
     };
 
+    namespace detail
+    {
+        //! Grid traits with cells of the given size covering the points' bounds padded by sqrt(2) cells on each side.
+        template <typename CoordinateType, typename Points>
+        inline grid_traits<CoordinateType> make_triangle_grid_traits(const Points& points, const CoordinateType& cellSize)
+        {
+            using coordinate_t = CoordinateType;
+            GEOMETRIX_ASSERT(cellSize > constants::zero<coordinate_t>());
+            auto bounds = get_bounds(points, absolute_tolerance_comparison_policy<coordinate_t>(constants::zero<coordinate_t>()));
+
+            using point_t = point<coordinate_t, 2>;
+            point_t lowerLeft(std::get<e_xmin>(bounds), std::get<e_ymin>(bounds));
+            point_t upperRight(std::get<e_xmax>(bounds), std::get<e_ymax>(bounds));
+            const auto sqrt2 = constants::sqrt_2<coordinate_t>();
+            const auto offset = sqrt2 * cellSize;
+            lowerLeft = lowerLeft + offset * normalize(lowerLeft - upperRight);
+            upperRight = upperRight + offset * normalize(upperRight - lowerLeft);
+            std::get<e_xmin>(bounds) = lowerLeft[0], std::get<e_ymin>(bounds) = lowerLeft[1];
+            std::get<e_xmax>(bounds) = upperRight[0], std::get<e_ymax>(bounds) = upperRight[1];
+
+            return grid_traits<coordinate_t>(bounds, cellSize);
+        }
+
+        //! Call visitor(col, row) for each grid cell which intersects the triangle.
+        template <typename Triangle, typename GridTraits, typename Visitor>
+        inline void rasterize_triangle(const Triangle& trig, const GridTraits& gTraits, Visitor&& visitor)
+        {
+            using coordinate_t = typename GridTraits::coordinate_type;
+            coordinate_t xmin, xmax, ymin, ymax;
+            std::tie(xmin, xmax, ymin, ymax) = get_bounds(trig, absolute_tolerance_comparison_policy<coordinate_t>(constants::zero<coordinate_t>()));
+            auto imin = gTraits.get_x_index(xmin);
+            auto imax = gTraits.get_x_index(xmax);
+            auto jmin = gTraits.get_y_index(ymin);
+            auto jmax = gTraits.get_y_index(ymax);
+            for (auto col = imin; col <= imax; ++col)
+            {
+                for (auto row = jmin; row <= jmax; ++row)
+                {
+                    axis_aligned_bounding_box<point<coordinate_t, 2>> box(gTraits.get_cell_corner0(col, row), gTraits.get_cell_corner2(col, row));
+                    if (eberly_triangle_aabb_intersection_2d(trig[0], trig[1], trig[2], box, absolute_tolerance_comparison_policy<coordinate_t>(construct<coordinate_t>(1e-10))))
+                        visitor(col, row);
+                }
+            }
+        }
+
+        struct triangle_cell_item
+        {
+            std::uint32_t col;
+            std::uint32_t row;
+            std::uint32_t triangle;
+        };
+
+        //! Rasterize the triangles in parallel. Each chunk of consecutive triangles is written to its own bucket, so visiting the
+        //! buckets in order visits the items in ascending triangle order.
+        template <typename Triangles, typename GridTraits, typename Executor>
+        inline std::vector<std::vector<triangle_cell_item>> rasterize_triangles(const Triangles& triangles, const GridTraits& gTraits, Executor& executor, std::size_t grainSize)
+        {
+            GEOMETRIX_ASSERT(triangles.size() < (std::numeric_limits<std::uint32_t>::max)());
+            std::size_t n = triangles.size();
+            if (grainSize == 0)
+                grainSize = default_grain_size(n);
+            std::size_t nChunks = (n + grainSize - 1) / grainSize;
+            std::vector<std::vector<triangle_cell_item>> buckets(nChunks);
+            parallel_for(executor, nChunks, 1, [&](std::size_t cfirst, std::size_t clast)
+            {
+                for (std::size_t c = cfirst; c < clast; ++c)
+                {
+                    auto& bucket = buckets[c];
+                    std::size_t last = (std::min)((c + 1) * grainSize, n);
+                    for (std::size_t i = c * grainSize; i < last; ++i)
+                        rasterize_triangle(triangles[i], gTraits, [&bucket, i](std::uint32_t col, std::uint32_t row) { bucket.push_back(triangle_cell_item{ col, row, static_cast<std::uint32_t>(i) }); });
+                }
+            });
+
+            return buckets;
+        }
+    }//! namespace detail;
+
+    //! Suggest a grid cell size for the triangles so that each cell overlaps roughly trianglesPerCell triangles.
+    //! Assuming the triangles are spread evenly over the bounds of area A, a triangle whose bounds measure w by h overlaps
+    //! about (w + s)(h + s) / s^2 cells of size s. Solving n (w + s)(h + s) = trianglesPerCell * A for the mean w and h gives s.
+    template <typename CoordinateType, typename Points, typename Triangles>
+    inline CoordinateType triangle_grid_cell_size(const Points& points, const Triangles& triangles, double trianglesPerCell = 4.0)
+    {
+        using coordinate_t = CoordinateType;
+        GEOMETRIX_ASSERT(!points.empty());
+        GEOMETRIX_ASSERT(!triangles.empty());
+        GEOMETRIX_ASSERT(trianglesPerCell > 0.0);
+        auto cmp = absolute_tolerance_comparison_policy<coordinate_t>(constants::zero<coordinate_t>());
+        auto bounds = get_bounds(points, cmp);
+        double area = construct<double>(std::get<e_xmax>(bounds) - std::get<e_xmin>(bounds)) * construct<double>(std::get<e_ymax>(bounds) - std::get<e_ymin>(bounds));
+
+        double w = 0.0, h = 0.0;
+        for (const auto& trig : triangles)
+        {
+            auto tbounds = get_bounds(trig, cmp);
+            w += construct<double>(std::get<e_xmax>(tbounds) - std::get<e_xmin>(tbounds));
+            h += construct<double>(std::get<e_ymax>(tbounds) - std::get<e_ymin>(tbounds));
+        }
+        double n = static_cast<double>(triangles.size());
+        w /= n;
+        h /= n;
+
+        using std::sqrt;
+        double a = trianglesPerCell * area / n;
+        double s = 0.5 * (sqrt((w - h) * (w - h) + 4.0 * a) - (w + h));
+        if (!(s > 0.0))
+            s = sqrt(a);//! The triangles are too large to meet the target; fall back to trianglesPerCell triangles' share of the area.
+        if (!(s > 0.0))
+            s = (std::max)(w, h);//! Degenerate bounds.
+        if (!(s > 0.0))
+            s = 1.0;
+
+        return construct<coordinate_t>(s);
+    }
+
     template <typename CoordinateType, typename GridTypeGenerator>
     struct triangle_grid_cache
     {
@@ -51,65 +173,159 @@ namespace geometrix
 
         template <typename Points, typename Triangles>
         triangle_grid_cache(const Points& points, const Triangles& triangles)
+            : triangle_grid_cache(points, triangles, construct<coordinate_t>(1.0))
+        {}
+
+        template <typename Points, typename Triangles>
+        triangle_grid_cache(const Points& points, const Triangles& triangles, const coordinate_t& cellSize)
         {
             GEOMETRIX_ASSERT(!points.empty());
             GEOMETRIX_ASSERT(!triangles.empty());
-            auto bounds = get_bounds(points, absolute_tolerance_comparison_policy<coordinate_t>(constants::zero<coordinate_t>()));
-            coordinate_t xmin, xmax, ymin, ymax;
-
-            using point_t = point<coordinate_t, 2>;
-            point_t lowerLeft(std::get<e_xmin>(bounds), std::get<e_ymin>(bounds));
-            point_t upperRight(std::get<e_xmax>(bounds), std::get<e_ymax>(bounds));
-            const auto sqrt2 = constants::sqrt_2<coordinate_t>();
-            const auto offset = sqrt2;
-            lowerLeft = lowerLeft + offset * normalize(lowerLeft - upperRight);
-            upperRight = upperRight + offset * normalize(upperRight - lowerLeft);
-            std::get<e_xmin>(bounds) = lowerLeft[0], std::get<e_ymin>(bounds) = lowerLeft[1];
-            std::get<e_xmax>(bounds) = upperRight[0], std::get<e_ymax>(bounds) = upperRight[1];
 
-            grid_traits<coordinate_t> gTraits(bounds, construct<coordinate_t>(1.0));
+            auto gTraits = detail::make_triangle_grid_traits(points, cellSize);
             m_grid.emplace(gTraits);
             auto& grid = *m_grid;
 
-            //! add each triangle
+            //! add each triangle; indices ascend so each insert appends.
             for (std::size_t i = 0; i < triangles.size(); ++i)
+                detail::rasterize_triangle(triangles[i], gTraits, [&grid, i](std::uint32_t col, std::uint32_t row) { auto& cell = grid.get_cell(col, row); cell.insert(cell.end(), i); });
+        }
+
+        //! Rasterize the triangles on the executor into per-task buckets and merge them into the grid.
+        template <typename Points, typename Triangles, typename Executor, typename std::enable_if<is_executor<typename std::decay<Executor>::type>::value, int>::type = 0>
+        triangle_grid_cache(const Points& points, const Triangles& triangles, const coordinate_t& cellSize, Executor&& executor, std::size_t grainSize = 0)
+        {
+            GEOMETRIX_ASSERT(!points.empty());
+            GEOMETRIX_ASSERT(!triangles.empty());
+
+            auto gTraits = detail::make_triangle_grid_traits(points, cellSize);
+            m_grid.emplace(gTraits);
+            auto& grid = *m_grid;
+
+            for (const auto& bucket : detail::rasterize_triangles(triangles, gTraits, executor, grainSize))
             {
-                auto const& trig = triangles[i];
-                std::tie(xmin, xmax, ymin, ymax) = get_bounds(trig, absolute_tolerance_comparison_policy<coordinate_t>(constants::zero<coordinate_t>()));
-                auto imin = gTraits.get_x_index(xmin);
-                auto imax = gTraits.get_x_index(xmax);
-                auto jmin = gTraits.get_y_index(ymin);
-                auto jmax = gTraits.get_y_index(ymax);
-                for (auto col = imin; col <= imax; ++col)
+                for (const auto& item : bucket)
                 {
-                    for (auto row = jmin; row <= jmax; ++row)
-                    {
-                        axis_aligned_bounding_box<point<coordinate_t, 2>> box(gTraits.get_cell_corner0(col, row), gTraits.get_cell_corner2(col, row));
-                        if (eberly_triangle_aabb_intersection_2d(trig[0], trig[1], trig[2], box, absolute_tolerance_comparison_policy<coordinate_t>(construct<coordinate_t>(1e-10))))
-                            grid.get_cell(col, row).insert(i);
-                    }
+                    auto& cell = grid.get_cell(item.col, item.row);
+                    cell.insert(cell.end(), item.triangle);
                 }
             }
         }
 
+        //! A const lookup which never inserts cells into a sparse grid, so concurrent queries are safe.
         template <typename Point>
-        data_t find_indices(const Point& p) const
+        const data_t& find_indices(const Point& p) const
         {
-            auto& grid = *m_grid;
+            static const data_t empty;
+            const auto& grid = *m_grid;
             if (grid.is_contained(p))
-                return grid.get_cell(p);
+                if (const data_t* cell = grid.find_cell(p))
+                    return *cell;
 
-            return data_t();
+            return empty;
         }
 
         grid_t const* get_grid() const { return m_grid ? &(*m_grid) : nullptr; }
 
-        mutable std::optional<grid_t> m_grid;
+        std::optional<grid_t> m_grid;
+    };
+
+    //! A frozen triangle grid cache storing the triangles of every cell in compressed sparse row form.
+    //! The triangle indices of cell (i, j) are m_indices[m_offsets[c]] to m_indices[m_offsets[c+1]] where c = j * width + i.
+    //! The cells hold the same triangles in the same (ascending) order as triangle_grid_cache, but lookups return a
+    //! non-owning range and do not allocate.
+    template <typename CoordinateType>
+    class compressed_triangle_grid_cache
+    {
+    public:
+
+        using coordinate_t = CoordinateType;
+        using index_t = std::uint32_t;
+        using grid_traits_t = grid_traits<coordinate_t>;
+        using data_t = boost::iterator_range<const index_t*>;
+
+        template <typename Points, typename Triangles>
+        compressed_triangle_grid_cache(const Points& points, const Triangles& triangles)
+            : compressed_triangle_grid_cache(points, triangles, construct<coordinate_t>(1.0))
+        {}
+
+        template <typename Points, typename Triangles>
+        compressed_triangle_grid_cache(const Points& points, const Triangles& triangles, const coordinate_t& cellSize)
+            : compressed_triangle_grid_cache(points, triangles, cellSize, serial_executor(), triangles.size())
+        {}
+
+        //! Rasterize the triangles on the executor into per-task buckets and merge them with a counting sort.
+        template <typename Points, typename Triangles, typename Executor, typename std::enable_if<is_executor<typename std::decay<Executor>::type>::value, int>::type = 0>
+        compressed_triangle_grid_cache(const Points& points, const Triangles& triangles, const coordinate_t& cellSize, Executor&& executor, std::size_t grainSize = 0)
+            : m_traits(detail::make_triangle_grid_traits(points, cellSize))
+        {
+            GEOMETRIX_ASSERT(!points.empty());
+            GEOMETRIX_ASSERT(!triangles.empty());
+            GEOMETRIX_ASSERT(triangles.size() < (std::numeric_limits<index_t>::max)());
+
+            build(detail::rasterize_triangles(triangles, m_traits, executor, grainSize));
+        }
+
+        template <typename Point>
+        data_t find_indices(const Point& p) const
+        {
+            if (m_traits.is_contained(p))
+                return get_cell(m_traits.get_x_index(get<0>(p)), m_traits.get_y_index(get<1>(p)));
+
+            return data_t(nullptr, nullptr);
+        }
+
+        data_t get_cell(std::uint32_t i, std::uint32_t j) const
+        {
+            auto c = get_cell_index(i, j);
+            const index_t* first = m_indices.data();
+            return data_t(first + m_offsets[c], first + m_offsets[c + 1]);
+        }
+
+        const grid_traits_t& get_traits() const { return m_traits; }
+        const std::vector<index_t>& get_offsets() const { return m_offsets; }
+        const std::vector<index_t>& get_indices() const { return m_indices; }
+
+    private:
+
+        std::size_t get_number_cells() const { return static_cast<std::size_t>(m_traits.get_width()) * m_traits.get_height(); }
+        index_t get_cell_index(std::uint32_t i, std::uint32_t j) const { return static_cast<index_t>(static_cast<std::size_t>(j) * m_traits.get_width() + i); }
+
+        //! Counting sort of the items by cell. The scatter is stable so each cell lists its triangles in ascending order.
+        void build(const std::vector<std::vector<detail::triangle_cell_item>>& buckets)
+        {
+            GEOMETRIX_ASSERT(get_number_cells() < (std::numeric_limits<index_t>::max)());
+            m_offsets.assign(get_number_cells() + 1, 0);
+            std::size_t nItems = 0;
+            for (const auto& bucket : buckets)
+            {
+                nItems += bucket.size();
+                for (const auto& item : bucket)
+                    ++m_offsets[get_cell_index(item.col, item.row) + 1];
+            }
+            GEOMETRIX_ASSERT(nItems < (std::numeric_limits<index_t>::max)());
+            for (std::size_t c = 1; c < m_offsets.size(); ++c)
+                m_offsets[c] += m_offsets[c - 1];
+
+            m_indices.resize(nItems);
+            std::vector<index_t> next(m_offsets.begin(), m_offsets.end() - 1);
+            for (const auto& bucket : buckets)
+                for (const auto& item : bucket)
+                    m_indices[next[get_cell_index(item.col, item.row)]++] = item.triangle;
+        }
+
+        grid_traits_t        m_traits;
+        std::vector<index_t> m_offsets;
+        std::vector<index_t> m_indices;
+
     };
 
     template <typename CoordinateType>
     using default_triangle_cache = triangle_grid_cache<CoordinateType, dense_grid_type_generator>;
 
+    template <typename CoordinateType>
+    using compressed_triangle_cache = compressed_triangle_grid_cache<CoordinateType>;
+
 	template <typename Length>
 	struct triangle_area_weight_policy
 	{
@@ -235,6 +451,107 @@ namespace geometrix
         normalized_weight_container_t m_integral;
     };
 
+    using triangle_adjacency_matrix_t = std::vector<std::array<std::size_t, 3>>;
+
+    namespace detail
+    {
+        inline std::size_t half_edge_hash(std::size_t a, std::size_t b)
+        {
+            std::uint64_t h = (static_cast<std::uint64_t>(a) * 0x9E3779B97F4A7C15ull) ^ (static_cast<std::uint64_t>(b) + 0x632BE59BD9B4E019ull);
+            h ^= h >> 31;
+            h *= 0xBF58476D1CE4E5B9ull;
+            return static_cast<std::size_t>(h ^ (h >> 29));
+        }
+    }//! namespace detail;
+
+    //! Find the triangle adjacent to each side of the triangles given as vertex index triples.
+    //! Side k of triangle i is the edge from indices[i][k] to indices[i][(k+1)%3]. Its entry is the triangle holding the reversed edge or
+    //! std::numeric_limits<std::size_t>::max() if there is none. Where more than one triangle holds the reversed edge the last is chosen.
+    //! Half-edges are paired through an open addressing table keyed on their vertices. The table is filled and queried in parallel on the executor.
+    template <typename Indices, typename Executor>
+    inline triangle_adjacency_matrix_t make_triangle_adjacency_matrix(const Indices& indices, Executor&& executor, std::size_t grainSize = 0)
+    {
+        const std::size_t none = (std::numeric_limits<std::size_t>::max)();
+        const std::size_t nTriangles = indices.size();
+        triangle_adjacency_matrix_t adjMatrix(nTriangles, { { none, none, none } });
+        if (nTriangles == 0)
+            return adjMatrix;
+
+        if (grainSize == 0)
+            grainSize = (std::max)(default_grain_size(nTriangles), std::size_t(1024));
+
+        //! Half-edge h is side h % 3 of triangle h / 3.
+        auto from = [&indices](std::size_t h) { return indices[h / 3][h % 3]; };
+        auto to = [&indices](std::size_t h) { return indices[h / 3][(h % 3 + 1) % 3]; };
+
+        std::size_t capacity = 16;
+        while (capacity < 6 * nTriangles)
+            capacity <<= 1;
+        const std::size_t mask = capacity - 1;
+        std::unique_ptr<std::atomic<std::size_t>[]> table(new std::atomic<std::size_t>[capacity]);
+        parallel_for(executor, capacity, (std::max)(capacity / (nTriangles / grainSize + 1), std::size_t(1)), [&](std::size_t first, std::size_t last)
+        {
+            for (std::size_t i = first; i < last; ++i)
+                table[i].store(none, std::memory_order_relaxed);
+        });
+
+        //! Each slot holds the largest half-edge with its key so the result does not depend on the order of insertion.
+        parallel_for(executor, nTriangles, grainSize, [&](std::size_t first, std::size_t last)
+        {
+            for (std::size_t h = 3 * first; h < 3 * last; ++h)
+            {
+                std::size_t a = from(h), b = to(h);
+                for (std::size_t slot = detail::half_edge_hash(a, b) & mask;; slot = (slot + 1) & mask)
+                {
+                    auto& s = table[slot];
+                    std::size_t cur = s.load(std::memory_order_relaxed);
+                    while (cur == none && !s.compare_exchange_weak(cur, h, std::memory_order_relaxed));
+                    if (cur == none)
+                        break;
+                    if (from(cur) == a && to(cur) == b)
+                    {
+                        while (cur < h && !s.compare_exchange_weak(cur, h, std::memory_order_relaxed));
+                        break;
+                    }
+                }
+            }
+        });
+
+        parallel_for(executor, nTriangles, grainSize, [&](std::size_t first, std::size_t last)
+        {
+            for (std::size_t h = 3 * first; h < 3 * last; ++h)
+            {
+                std::size_t a = from(h), b = to(h);
+                for (std::size_t slot = detail::half_edge_hash(b, a) & mask;; slot = (slot + 1) & mask)
+                {
+                    std::size_t cur = table[slot].load(std::memory_order_relaxed);
+                    if (cur == none)
+                        break;
+                    if (from(cur) == b && to(cur) == a)
+                    {
+                        adjMatrix[h / 3][h % 3] = cur / 3;
+                        break;
+                    }
+                }
+            }
+        });
+
+        return adjMatrix;
+    }
+
+    template <typename Indices>
+    inline triangle_adjacency_matrix_t make_triangle_adjacency_matrix(const Indices& indices)
+    {
+        return make_triangle_adjacency_matrix(indices, serial_executor());
+    }
+
+    //! Specifies when mesh_2d builds its triangle adjacency matrix.
+    enum class mesh_adjacency_construction
+    {
+        eager,   //! Build in the constructor.
+        deferred //! Build on an explicit call to mesh_2d::build_adjacency_matrix (which may be given an executor).
+    };
+
     template <typename Cache, typename Points, typename Triangles>
     inline Cache make_triangle_cache(const Points& pts, const Triangles& trigs)
     {
@@ -248,20 +565,42 @@ namespace geometrix
         using base_t = mesh_2d_base<CoordinateType>;
         using traits_t = Traits;
         using cache_t = typename traits_t::cache_t;
-        using adjacency_matrix_t = std::vector<std::array<std::size_t, 3>>;
+        using adjacency_matrix_t = triangle_adjacency_matrix_t;
         using point_container_t = typename base_t::point_container_t;
         using triangle_container_t = typename base_t::triangle_container_t;
 
         template <typename Points, typename Indices, typename NumberComparisonPolicy, typename WeightPolicy = triangle_area_weight_policy<CoordinateType>>
         mesh_2d(const Points& points, Indices indices, const NumberComparisonPolicy& cmp, const std::function<cache_t(const point_container_t&, const triangle_container_t&)>& cacheBuilder = make_triangle_cache<cache_t, point_container_t, triangle_container_t>, const WeightPolicy& weightPolicy = WeightPolicy())
+            : mesh_2d(points, std::move(indices), cmp, mesh_adjacency_construction::eager, cacheBuilder, weightPolicy)
+        {}
+
+        template <typename Points, typename Indices, typename NumberComparisonPolicy, typename WeightPolicy = triangle_area_weight_policy<CoordinateType>>
+        mesh_2d(const Points& points, Indices indices, const NumberComparisonPolicy& cmp, mesh_adjacency_construction adjacency, const std::function<cache_t(const point_container_t&, const triangle_container_t&)>& cacheBuilder = make_triangle_cache<cache_t, point_container_t, triangle_container_t>, const WeightPolicy& weightPolicy = WeightPolicy())
             : base_t(points, indices, cmp, weightPolicy)
             , m_cache(cacheBuilder(base_t::m_points, base_t::m_triangles))
         {
-            create_adjacency_matrix();
+            if (adjacency == mesh_adjacency_construction::eager)
+                build_adjacency_matrix();
+        }
+
+        //! Build the adjacency matrix of a mesh constructed with mesh_adjacency_construction::deferred.
+        void build_adjacency_matrix()
+        {
+            build_adjacency_matrix(serial_executor());
         }
 
+        template <typename Executor>
+        void build_adjacency_matrix(Executor&& executor)
+        {
+            m_adjMatrix = make_triangle_adjacency_matrix(base_t::m_indices, std::forward<Executor>(executor));
+        }
+
+        bool has_adjacency_matrix() const { return m_adjMatrix.has_value(); }
+
+        //! @precondition has_adjacency_matrix()
         const adjacency_matrix_t& get_adjacency_matrix() const
         {
+            GEOMETRIX_ASSERT(m_adjMatrix);
             return *m_adjMatrix;
         }
 
@@ -290,6 +629,15 @@ namespace geometrix
             typedef typename remove_const_ref<MeshSearch>::type::edge_item edge_item;
             std::vector<edge_item> Q;
             Q.reserve(100);
+            search(std::forward<MeshSearch>(visitor), Q);
+        }
+
+        //! search the mesh graph in a DFS fashion using Q as the stack. Reusing Q across searches avoids allocating it for each.
+        template <typename MeshSearch, typename EdgeItem>
+        void search(MeshSearch&& visitor, std::vector<EdgeItem>& Q) const
+        {
+            typedef EdgeItem edge_item;
+            Q.clear();
             Q.push_back(visitor.get_start());
 
             const adjacency_matrix_t& adjMatrix = get_adjacency_matrix();
@@ -331,44 +679,7 @@ namespace geometrix
 
     private:
 
-        void create_adjacency_matrix() const
-        {
-            std::array<std::size_t, 3> defaultArray = { { (std::numeric_limits<std::size_t>::max)(), (std::numeric_limits<std::size_t>::max)(), (std::numeric_limits<std::size_t>::max)() } };
-            m_adjMatrix = adjacency_matrix_t(base_t::m_triangles.size(), defaultArray);
-            auto& adjMatrix = *m_adjMatrix;
-            enum class trig_side { zero, one, two };
-            struct adj_item { std::size_t index; trig_side side; };
-            std::map<std::pair<std::size_t, std::size_t>, std::vector<adj_item>> adjTriangles;
-
-            for (std::size_t i = 0; i < base_t::m_triangles.size(); ++i)
-            {
-                const auto& indices = base_t::get_triangle_indices(i);
-                adjTriangles[std::make_pair(indices[0], indices[1])].push_back(adj_item{ i, trig_side::zero });
-                adjTriangles[std::make_pair(indices[1], indices[2])].push_back(adj_item{ i, trig_side::one });
-                adjTriangles[std::make_pair(indices[2], indices[0])].push_back(adj_item{ i, trig_side::two });
-            }
-
-            for (const auto& item : adjTriangles)
-            {
-                const auto& key = item.first;
-                const auto& itrigs = item.second;
-                auto it = adjTriangles.find(std::make_pair(key.second, key.first));
-                if (it != adjTriangles.end())
-                {
-                    //! all the trigs in it collection are adjacent to the trigs in itrigs.
-                    for (auto const& i : itrigs)
-                    {
-                        for (auto const& j : it->second)
-                        {
-                            adjMatrix[i.index][static_cast<std::size_t>(i.side)] = j.index;
-                            adjMatrix[j.index][static_cast<std::size_t>(j.side)] = i.index;
-                        }
-                    }
-                }
-            }
-        }
-
-        mutable std::optional<adjacency_matrix_t> m_adjMatrix;
+        std::optional<adjacency_matrix_t> m_adjMatrix;
         cache_t m_cache;
     };
 
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <geometrix/algorithm/mesh_2d.hpp>
+#include <geometrix/algorithm/mesh_search_context.hpp>
 #include <geometrix/tensor/vector.hpp>
 #include <geometrix/primitive/point.hpp>
 #include <geometrix/primitive/segment.hpp>
@@ -78,6 +79,37 @@ namespace geometrix
 
     };
 
+    //! \brief An edge crossed by a mesh_search from triangle from into triangle to with the window [lo, hi] of directions visible through it from the origin.
+    template <typename Point>
+    struct mesh_search_edge_item
+    {
+        using length_t = typename arithmetic_type_of<Point>::type;
+        using vector_t = vector<length_t, 2>;
+
+        mesh_search_edge_item( std::size_t from, std::size_t to, const vector_t& lo, const vector_t& hi )
+            : from(from)
+            , to(to)
+            , lo( lo )
+            , hi( hi )
+        {}
+
+        //! Visitor interface.
+        std::size_t get_triangle_index() const { return to; }
+        std::size_t get_to_triangle() const { return to; }
+        std::size_t get_from_triangle() const { return from; }
+        bool        is_all_around() const { return get<0>( lo ) == constants::infinity<length_t>() && get<0>( hi ) == constants::negative_infinity<length_t>(); }
+
+        bool operator<( const mesh_search_edge_item& rhs ) const
+        {
+            return geometrix::lexicographical_compare( from, rhs.from, to, rhs.to, lo, rhs.lo, hi, rhs.hi );
+        }
+
+        std::size_t from;
+        std::size_t to;
+        vector_t lo;
+        vector_t hi;
+    };
+
     template <typename Point, typename Mesh, typename ... Visitors>
     struct mesh_search
     {
@@ -108,32 +140,25 @@ namespace geometrix
         {}
         
 
-        struct mesh_search_item
+        using mesh_search_item = mesh_search_edge_item<Point>;
+        typedef mesh_search_item edge_item;
+        using context_type = mesh_search_context<edge_item>;
+
+        //! Search using context for the visited set. The context is reset for the search. Pass context.get_queue() to mesh_2d::search
+        //! to reuse its traversal stack as well.
+        mesh_search(const vector_t& lo, const vector_t& hi, std::size_t start, const Point& origin, const Mesh& mesh, context_type& context, Visitors&&... a)
+            : mesh_search(lo, hi, start, origin, mesh, std::forward<Visitors>(a)...)
         {
-            mesh_search_item( std::size_t from, std::size_t to, const vector_t& lo, const vector_t& hi )
-                : from(from)
-                , to(to)
-                , lo( lo )
-                , hi( hi )
-            {}
-
-            //! Visitor interface.
-            std::size_t get_triangle_index() const { return to; }
-            std::size_t get_to_triangle() const { return to; }
-            std::size_t get_from_triangle() const { return from; }
-            bool        is_all_around() const { return get<0>( lo ) == constants::infinity<length_t>() && get<0>( hi ) == constants::negative_infinity<length_t>(); }
-
-            bool operator<( const mesh_search_item& rhs ) const
-            {
-                return geometrix::lexicographical_compare( from, rhs.from, to, rhs.to, lo, rhs.lo, hi, rhs.hi );
-            }
+            m_context = &context;
+            context.reset(mesh.get_number_triangles());
+        }
 
-            std::size_t from;
-            std::size_t to;
-            vector_t lo;
-            vector_t hi;
-        };
-        typedef mesh_search_item edge_item;
+        mesh_search(std::size_t start, const Point& origin, const Mesh& mesh, context_type& context, Visitors&&... a)
+            : mesh_search(start, origin, mesh, std::forward<Visitors>(a)...)
+        {
+            m_context = &context;
+            context.reset(mesh.get_number_triangles());
+        }
 
         edge_item get_start()
         {
@@ -192,6 +217,9 @@ namespace geometrix
             }
 
             auto nItem = edge_item( item.to, next, vecLo, vecHi );
+            if( m_context )
+                return m_context->insert( nItem ) ? boost::make_optional( nItem ) : boost::none;
+
 			if( auto it = m_visited.lower_bound( nItem ); it == m_visited.end() || m_visited.key_comp()( nItem, *it ) ) 
             {
 				m_visited.insert( it, nItem );
@@ -209,6 +237,7 @@ namespace geometrix
 		std::size_t                           m_start;
 		std::tuple<Visitors...>               m_visitors;
 		boost::container::flat_set<edge_item> m_visited;
+		context_type*                         m_context{ nullptr };
 
     };
 
@@ -218,6 +247,12 @@ namespace geometrix
 		return mesh_search<Point, Mesh, Visitors...>( startTrig, origin, mesh, std::forward<Visitors>(vs)... );
     }
     
+    template <typename Point, typename Mesh, typename ... Visitors>
+    inline mesh_search<Point, Mesh, Visitors...> make_mesh_search(std::size_t startTrig, const Point& origin, const Mesh& mesh, mesh_search_context<mesh_search_edge_item<Point>>& context, Visitors&&... vs)
+    {
+		return mesh_search<Point, Mesh, Visitors...>( startTrig, origin, mesh, context, std::forward<Visitors>(vs)... );
+    }
+
     template <typename Vector1, typename Vector2, typename Point, typename Mesh, typename ... Visitors>
     inline mesh_search<Point, Mesh, Visitors...> make_mesh_search(const Vector1& lo, const Vector2& hi, std::size_t startTrig, const Point& origin, const Mesh& mesh, Visitors&&... vs)
     {
@@ -0,0 +1,111 @@
+//
+//! Copyright © 2026
+//! Brandon Kohn
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+#ifndef GEOMETRIX_MESH_SEARCH_CONTEXT_HPP
+#define GEOMETRIX_MESH_SEARCH_CONTEXT_HPP
+#pragma once
+
+#include <boost/config.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace geometrix {
+
+    //! \brief Reusable state for searches over a mesh with edge items of type EdgeItem (having from, to, lo and hi members).
+    //!
+    //! The visited set keeps the items reached at each triangle in a list stamped with the epoch of the search. Starting a new search
+    //! increments the epoch, so the set is cleared in O(1). Once the buffers have grown to the size needed by the searches, repeated
+    //! searches perform no heap allocation. A context should be used by one search at a time.
+    template <typename EdgeItem>
+    class mesh_search_context
+    {
+    public:
+
+        using edge_item = EdgeItem;
+
+        mesh_search_context() = default;
+
+        //! Prepare for a new search over a mesh with numberTriangles triangles.
+        void reset(std::size_t numberTriangles)
+        {
+            if (m_triangles.size() < numberTriangles)
+                m_triangles.resize(numberTriangles, triangle_slot{ 0, no_record });
+            if (++m_epoch == 0)
+            {
+                std::fill(m_triangles.begin(), m_triangles.end(), triangle_slot{ 0, no_record });
+                m_epoch = 1;
+            }
+            m_records.clear();
+            m_queue.clear();
+            m_vertices.clear();
+        }
+
+        //! Mark item as visited and return true if it was not visited before in this search.
+        bool insert(const edge_item& item)
+        {
+            triangle_slot& slot = m_triangles[item.to];
+            if (slot.epoch != m_epoch)
+            {
+                slot.epoch = m_epoch;
+                slot.head = no_record;
+            }
+            else
+            {
+                for (auto r = slot.head; r != no_record; r = m_records[r].next)
+                    if (is_same_item(m_records[r].item, item))
+                        return false;
+            }
+
+            m_records.push_back(record{ item, slot.head });
+            slot.head = static_cast<std::uint32_t>(m_records.size() - 1);
+            return true;
+        }
+
+        //! The traversal stack used by mesh_2d::search.
+        std::vector<edge_item>& get_queue() { return m_queue; }
+
+        //! The vertices found by searches which collect vertices.
+        std::vector<std::size_t>&       get_vertices() { return m_vertices; }
+        const std::vector<std::size_t>& get_vertices() const { return m_vertices; }
+
+    private:
+
+        BOOST_STATIC_CONSTANT(std::uint32_t, no_record = (std::numeric_limits<std::uint32_t>::max)());
+
+        struct triangle_slot
+        {
+            std::uint32_t epoch;
+            std::uint32_t head;
+        };
+
+        struct record
+        {
+            edge_item     item;
+            std::uint32_t next;
+        };
+
+        static bool is_same_item(const edge_item& a, const edge_item& b)
+        {
+            return a.from == b.from && a.lo[0] == b.lo[0] && a.lo[1] == b.lo[1] && a.hi[0] == b.hi[0] && a.hi[1] == b.hi[1];
+        }
+
+        std::vector<triangle_slot> m_triangles;
+        std::vector<record>        m_records;
+        std::vector<edge_item>     m_queue;
+        std::vector<std::size_t>   m_vertices;
+        std::uint32_t              m_epoch{ 0 };
+
+    };
+
+}//! namespace geometrix;
+
+#endif //! GEOMETRIX_MESH_SEARCH_CONTEXT_HPP
@@ -20,6 +20,7 @@
 #include <geometrix/algorithm/intersection/ray_aabb_intersection.hpp>
 #include <geometrix/algorithm/point_location_classification.hpp>
 #include <geometrix/algorithm/orientation/point_segment_orientation.hpp>
+#include <geometrix/algorithm/node_bsp_tree_2d_fwd.hpp>
 
 #include <boost/range.hpp>
 #include <boost/noncopyable.hpp>
@@ -28,6 +29,8 @@
 #include <boost/tuple/tuple.hpp>
 
 #include <algorithm>
+#include <cstdint>
+#include <tuple>
 #include <vector>
 #include <stack>
 #include <set>
@@ -263,6 +266,9 @@ namespace geometrix {
         //! Method to return a negated (edges reversed) copy of the bsp tree.
         boost::scoped_ptr< node_bsp_tree_2d< Segment > > negation() const;
 
+        //! Method to return a copy of the bsp tree stored in contiguous arrays.
+        compact_node_bsp_tree_2d< Segment >          compact() const;
+
         template <typename Range, typename PartitionSelector, typename NumberComparisonPolicy>
         void insert( const Range& range, const PartitionSelector& selector, const NumberComparisonPolicy& compare )
         {
@@ -357,6 +363,9 @@ namespace geometrix {
 */
     private:
 
+        template <typename S>
+        friend class compact_node_bsp_tree_2d;
+
         enum classification
         {
             e_crosses,
@@ -367,11 +376,11 @@ namespace geometrix {
 
         ///Method to classify the characterization of the splitting line and an edge (left,right or split).
         template <typename NumberComparisonPolicy>
-        classification  classify( const Segment& splittingLine,
-                                  const Segment& edge,
-                                  Segment& subPos,
-                                  Segment& subNeg,
-                                  const NumberComparisonPolicy& compare ) const;
+        static classification classify( const Segment& splittingLine,
+                                         const Segment& edge,
+                                         Segment& subPos,
+                                         Segment& subNeg,
+                                         const NumberComparisonPolicy& compare );
 
         //! Method to get a positive partition of a line segment
         template <typename NumberComparisonPolicy>
@@ -452,7 +461,7 @@ namespace geometrix {
                                                                                               const Segment& edge,
                                                                                               Segment& subPos,
                                                                                               Segment& subNeg,
-                                                                                              const NumberComparisonPolicy& compare ) const
+                                                                                              const NumberComparisonPolicy& compare )
     {
         typedef Segment                                              segment_type;
         typedef typename geometric_traits<segment_type>::point_type  point_type;
@@ -579,7 +588,7 @@ namespace geometrix {
     template <typename Point, typename Visitor, typename NumberComparisonPolicy>
     inline void node_bsp_tree_2d< Segment >::painters_traversal( const Point& point, Visitor&& visitor, const NumberComparisonPolicy& compare ) const
     {
-        BOOST_CONCEPT_ASSERT((VisitorConcept<Visitor,Segment>));
+        BOOST_CONCEPT_ASSERT((VisitorConcept<typename std::decay<Visitor>::type,Segment>));
         typedef Segment segment_type;
 
         if( m_negativeChild == 0 && m_positiveChild == 0 )
@@ -781,6 +790,275 @@ namespace geometrix {
             negative.push_back( edge );
     }
 
+    //! \brief A node_bsp_tree_2d stored in contiguous arrays.
+
+    //! The nodes are stored depth first in a single array and refer to their children by index. The coincident edges of all
+    //! nodes are pooled in one array in which each node refers to a contiguous range. The tree may be built directly from a
+    //! range of segments, partitioning within a single scratch buffer rather than copying the lists at each level, or by
+    //! compacting a node_bsp_tree_2d. The queries give the same results as those of the equivalent node_bsp_tree_2d.
+    template <typename Segment>
+    class compact_node_bsp_tree_2d
+    {
+        using point_type = typename point_type_of<Segment>::type;
+        using length_type = typename arithmetic_type_of<Segment>::type;
+
+    public:
+
+        using index_type = std::uint32_t;
+
+        BOOST_STATIC_CONSTANT(index_type, null_node = 0xFFFFFFFF);
+
+        struct node
+        {
+            Segment    splitting_segment;
+            index_type positive_child;
+            index_type negative_child;
+            index_type first_edge;//! the first coincident edge in the pooled edges.
+            index_type edge_count;
+
+            bool is_leaf() const { return positive_child == null_node && negative_child == null_node; }
+        };
+
+        compact_node_bsp_tree_2d()
+            : m_bounds(construct<point_type>(constants::infinity<length_type>(), constants::infinity<length_type>()), construct<point_type>(constants::negative_infinity<length_type>(), constants::negative_infinity<length_type>()))
+        {}
+
+        template <typename Range, typename PartitionSelector, typename NumberComparisonPolicy>
+        compact_node_bsp_tree_2d( const Range& range, const PartitionSelector& selector, const NumberComparisonPolicy& compare );
+
+        explicit compact_node_bsp_tree_2d( const node_bsp_tree_2d< Segment >& tree );
+
+        //! Method to detect if a point is inside, on the boundary our outside the shape represented by the partition. Points are outside an empty tree.
+        template <typename Point, typename NumberComparisonPolicy>
+        point_location_classification               locate_point( const Point& point, const NumberComparisonPolicy& compare ) const;
+
+        //! Method to to a 'painters algorithm' traversal of the BSP for a specified point.
+        template <typename Point, typename Visitor, typename NumberComparisonPolicy>
+        void                                        painters_traversal( const Point& point, Visitor&& visitor, const NumberComparisonPolicy& compare ) const;
+
+        bool                                         empty() const { return m_nodes.empty(); }
+        const std::vector< node >&                   get_nodes() const { return m_nodes; }
+        const std::vector< Segment >&                get_coincident_edges() const { return m_edges; }
+        const axis_aligned_bounding_box<point_type>& get_bounds() const { return m_bounds; }
+
+    private:
+
+        index_type add_node( const Segment& splittingSegment, index_type parent, bool isPositive )
+        {
+            index_type index = static_cast<index_type>( m_nodes.size() );
+            m_nodes.push_back( node{ splittingSegment, null_node, null_node, static_cast<index_type>( m_edges.size() ), 0 } );
+            if( parent != null_node )
+            {
+                if( isPositive )
+                    m_nodes[parent].positive_child = index;
+                else
+                    m_nodes[parent].negative_child = index;
+            }
+            return index;
+        }
+
+        axis_aligned_bounding_box<point_type>        m_bounds;
+        std::vector< node >                          m_nodes;
+        std::vector< Segment >                       m_edges;
+    };
+
+    template <typename Segment>
+    template <typename Range, typename PartitionSelector, typename NumberComparisonPolicy>
+    inline compact_node_bsp_tree_2d< Segment >::compact_node_bsp_tree_2d( const Range& range, const PartitionSelector& selector, const NumberComparisonPolicy& compare )
+        : compact_node_bsp_tree_2d()
+    {
+        using tree_type = node_bsp_tree_2d< Segment >;
+        using iterator = typename std::vector< Segment >::const_iterator;
+
+        //! The segments of the nodes waiting to be built are stacked at the end of the buffer in the order they are built.
+        struct pending
+        {
+            std::size_t first;
+            std::size_t last;
+            index_type  parent;
+            bool        isPositive;
+        };
+
+        std::vector< Segment > buffer( boost::begin( range ), boost::end( range ) );
+        if( buffer.empty() )
+            return;
+
+        for( const Segment& segment : buffer )
+            m_bounds.expand( geometrix::get_bounds( std::array<point_type, 2>{ get_start( segment ), get_end( segment ) }, compare ) );
+
+        std::vector< pending > stack( 1, pending{ 0, buffer.size(), null_node, false } );
+        std::vector< Segment > posList, negList;
+        while( !stack.empty() )
+        {
+            pending p = stack.back();
+            stack.pop_back();
+
+            Segment splittingSegment = selector( boost::make_iterator_range( iterator( buffer.begin() + p.first ), iterator( buffer.begin() + p.last ) ) );
+            index_type index = add_node( splittingSegment, p.parent, p.isPositive );
+
+            posList.clear();
+            negList.clear();
+            for( std::size_t i = p.first; i != p.last; ++i )
+            {
+                const Segment& segment = buffer[i];
+                Segment subNeg, subPos;
+                typename tree_type::classification type = tree_type::classify( splittingSegment, segment, subPos, subNeg, compare );
+                if( type == tree_type::e_crosses )
+                {
+                    posList.push_back( subPos );
+                    negList.push_back( subNeg );
+                }
+                else if( type == tree_type::e_positive )
+                    posList.push_back( segment );
+                else if( type == tree_type::e_negative )
+                    negList.push_back( segment );
+                else
+                    m_edges.push_back( segment );
+            }
+            m_nodes[index].edge_count = static_cast<index_type>( m_edges.size() - m_nodes[index].first_edge );
+
+            //! The positive list is pushed last so that it is built first as in node_bsp_tree_2d.
+            buffer.resize( p.first );
+            if( !negList.empty() )
+            {
+                stack.push_back( pending{ buffer.size(), buffer.size() + negList.size(), index, false } );
+                buffer.insert( buffer.end(), negList.begin(), negList.end() );
+            }
+            if( !posList.empty() )
+            {
+                stack.push_back( pending{ buffer.size(), buffer.size() + posList.size(), index, true } );
+                buffer.insert( buffer.end(), posList.begin(), posList.end() );
+            }
+        }
+    }
+
+    template <typename Segment>
+    inline compact_node_bsp_tree_2d< Segment >::compact_node_bsp_tree_2d( const node_bsp_tree_2d< Segment >& tree )
+        : m_bounds( tree.m_bounds )
+    {
+        using tree_type = node_bsp_tree_2d< Segment >;
+        std::vector< std::tuple< const tree_type*, index_type, bool > > stack( 1, std::make_tuple( &tree, index_type( null_node ), false ) );
+        while( !stack.empty() )
+        {
+            const tree_type* pNode;
+            index_type parent;
+            bool isPositive;
+            std::tie( pNode, parent, isPositive ) = stack.back();
+            stack.pop_back();
+
+            index_type index = add_node( pNode->m_splittingSegment, parent, isPositive );
+            m_edges.insert( m_edges.end(), pNode->m_coincidentEdges.begin(), pNode->m_coincidentEdges.end() );
+            m_nodes[index].edge_count = static_cast<index_type>( pNode->m_coincidentEdges.size() );
+
+            if( pNode->m_negativeChild )
+                stack.emplace_back( pNode->m_negativeChild.get(), index, false );
+            if( pNode->m_positiveChild )
+                stack.emplace_back( pNode->m_positiveChild.get(), index, true );
+        }
+    }
+
+    template <typename Segment>
+    template <typename Point, typename NumberComparisonPolicy>
+    inline point_location_classification compact_node_bsp_tree_2d< Segment >::locate_point( const Point& point, const NumberComparisonPolicy& compare ) const
+    {
+        if( m_nodes.empty() )
+            return e_outside;
+
+        index_type index = 0;
+        while( true )
+        {
+            const node& n = m_nodes[index];
+            orientation_type orientation_point = get_orientation( get_start( n.splitting_segment ), get_end( n.splitting_segment ), point, compare );
+
+            if( orientation_point == oriented_left )
+            {
+                if( n.positive_child == null_node )
+                    return e_inside;
+                index = n.positive_child;
+            }
+            else if( orientation_point == oriented_right )
+            {
+                if( n.negative_child == null_node )
+                    return e_outside;
+                index = n.negative_child;
+            }
+            else
+            {
+                for( index_type i = n.first_edge, last = n.first_edge + n.edge_count; i != last; ++i )
+                {
+                    if( is_between( get_start( m_edges[i] ), get_end( m_edges[i] ), point, true, compare ) )
+                        return e_boundary;
+                }
+
+                if( n.positive_child != null_node )
+                    index = n.positive_child;
+                else if( n.negative_child != null_node )
+                    index = n.negative_child;
+                else
+                    return e_boundary;//! see node_bsp_tree_2d::locate_point.
+            }
+        }
+    }
+
+    template <typename Segment>
+    template <typename Point, typename Visitor, typename NumberComparisonPolicy>
+    inline void compact_node_bsp_tree_2d< Segment >::painters_traversal( const Point& point, Visitor&& visitor, const NumberComparisonPolicy& compare ) const
+    {
+        BOOST_CONCEPT_ASSERT((VisitorConcept<typename std::decay<Visitor>::type,Segment>));
+
+        if( m_nodes.empty() )
+            return;
+
+        //! Each entry is a node to traverse or a node whose coincident edges are to be visited.
+        std::vector< std::pair< index_type, bool > > stack( 1, std::make_pair( index_type( 0 ), false ) );
+        while( !stack.empty() )
+        {
+            index_type index = stack.back().first;
+            bool visitEdges = stack.back().second;
+            stack.pop_back();
+
+            const node& n = m_nodes[index];
+            if( visitEdges || n.is_leaf() )
+            {
+                for( index_type i = n.first_edge, last = n.first_edge + n.edge_count; i != last; ++i )
+                    visitor( m_edges[i] );
+                continue;
+            }
+
+            //! Push in the reverse of the visiting order.
+            orientation_type orientation_point = get_orientation( get_start( n.splitting_segment ), get_end( n.splitting_segment ), point, compare );
+            if( orientation_point == oriented_left )
+            {
+                if( n.positive_child != null_node )
+                    stack.emplace_back( n.positive_child, false );
+                stack.emplace_back( index, true );
+                if( n.negative_child != null_node )
+                    stack.emplace_back( n.negative_child, false );
+            }
+            else if( orientation_point == oriented_right )
+            {
+                if( n.negative_child != null_node )
+                    stack.emplace_back( n.negative_child, false );
+                stack.emplace_back( index, true );
+                if( n.positive_child != null_node )
+                    stack.emplace_back( n.positive_child, false );
+            }
+            else
+            {
+                if( n.negative_child != null_node )
+                    stack.emplace_back( n.negative_child, false );
+                if( n.positive_child != null_node )
+                    stack.emplace_back( n.positive_child, false );
+            }
+        }
+    }
+
+    template <typename Segment>
+    inline compact_node_bsp_tree_2d< Segment > node_bsp_tree_2d< Segment >::compact() const
+    {
+        return compact_node_bsp_tree_2d< Segment >( *this );
+    }
+
 }//namespace geometrix;
 
 #endif //GEOMETRIX_BSPTREE2D_HPP
@@ -15,6 +15,9 @@ namespace geometrix {
     template <typename Segment>
     class node_bsp_tree_2d;
 
+    template <typename Segment>
+    class compact_node_bsp_tree_2d;
+
 }//namespace geometrix;
 
 #endif //GEOMETRIX_BSPTREE2DFWD_HPP
\ No newline at end of file
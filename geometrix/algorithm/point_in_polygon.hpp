@@ -11,6 +11,7 @@
 #pragma once
 
 #include <geometrix/primitive/point_sequence_traits.hpp>
+#include <geometrix/primitive/polygon_with_holes.hpp>
 #include <geometrix/algebra/dot_product.hpp>
 #include <geometrix/algebra/cross_product.hpp>
 #include <geometrix/tensor/vector.hpp>
@@ -24,6 +25,30 @@ namespace geometrix {
     //! Function to test if a point is inside a polygon. (From Geometric Tools for Computer Graphics.)
     namespace detail {
 
+        //! Whether the edge from u1 to u0 crosses the horizontal ray to the right of A.
+        template <typename Point, typename Point0, typename Point1>
+        inline bool edge_crosses_ray( const Point& A, const Point0& u0, const Point1& u1 )
+        {
+            if( get<1>( A ) < get<1>( u1 ) )
+            {
+                // u1 above ray
+                if( get<1>( u0 ) <= get<1>( A ) )
+                {
+                    //u0 on or below ray
+                    return ( get<1>( A ) - get<1>( u0 ) ) * ( get<0>( u1 ) - get<0>( u0 ) ) >
+                           ( get<0>( A ) - get<0>( u0 ) ) * ( get<1>( u1 ) - get<1>( u0 ) );
+                }
+            }
+            else if( get<1>( A ) < get<1>( u0 ) )
+            {
+                // u1 on or below ray, u0 above ray
+                return ( get<1>( A ) - get<1>( u0 ) ) * ( get<0>( u1 ) - get<0>( u0 ) ) <
+                       ( get<0>( A ) - get<0>( u0 ) ) * ( get<1>( u1 ) - get<1>( u0 ) );
+            }
+
+            return false;
+        }
+
         template <typename Point, typename Polygon>
         inline bool point_in_polygon( const Point& A
                                     , const Polygon& pgon
@@ -43,28 +68,8 @@ namespace geometrix {
                 const sequence_point_type& u0 = point_sequence_traits< Polygon >::get_point( pgon, i );
                 const sequence_point_type& u1 = point_sequence_traits< Polygon >::get_point( pgon, j );
 
-                if( get<1>( A ) < get<1>( u1 ) )
-                {
-                    // u1 above ray
-                    if( get<1>( u0 ) <= get<1>( A ) )
-                    {
-                        //u0 on or below ray
-                        if( ( get<1>( A ) - get<1>( u0 ) ) * ( get<0>( u1 ) - get<0>( u0 ) ) >
-                            ( get<0>( A ) - get<0>( u0 ) ) * ( get<1>( u1 ) - get<1>( u0 ) ) )
-                        {
-                            inside = !inside;
-                        }
-                    }
-                }
-                else if( get<1>( A ) < get<1>( u0 ) )
-                {
-                    // u1 on or below ray, u0 above ray
-                    if( ( get<1>( A ) - get<1>( u0 ) ) * ( get<0>( u1 ) - get<0>( u0 ) ) <
-                        ( get<0>( A ) - get<0>( u0 ) ) * ( get<1>( u1 ) - get<1>( u0 ) ) )
-                    {
-                        inside = !inside;
-                    }
-                }
+                if( edge_crosses_ray( A, u0, u1 ) )
+                    inside = !inside;
             }
 
             return inside;
@@ -84,6 +89,20 @@ namespace geometrix {
         return detail::point_in_polygon(A, pgon, typename dimension_of<typename point_sequence_traits<Polygon>::point_type>::type() );
     }
 
+    //! A point is in a polygon with holes when it is in the outer polygon and in none of the holes.
+    template <typename Point, typename PolygonPoint>
+    inline bool point_in_polygon( const Point& A, const polygon_with_holes<PolygonPoint>& pgon )
+    {
+        if( !point_in_polygon( A, pgon.get_outer() ) )
+            return false;
+
+        for( const auto& hole : pgon.get_holes() )
+            if( point_in_polygon( A, hole ) )
+                return false;
+
+        return true;
+    }
+
     template <typename Point, typename Polygon, typename NumberComparisonPolicy>
     inline bool point_in_subpolygon( const Point& p, const Polygon& pgon, int i0, int i1, const NumberComparisonPolicy& compare )
     {
@@ -254,21 +273,57 @@ namespace geometrix {
       , vertex = 3
     };
 
+    namespace detail {
+
+        //! Count the crossings of the edge from pointh to pointi with the horizontal rays to the right and left of p.
+        template <typename Point, typename PointH, typename PointI, typename NumberComparisonPolicy>
+        inline void count_edge_crossings( const Point& p, const PointH& pointh, const PointI& pointi, std::size_t& rcross, std::size_t& lcross, const NumberComparisonPolicy& cmp )
+        {
+            typedef typename geometric_traits<PointI>::arithmetic_type arithmetic_type;
+            using dimensionless_type = typename geometric_traits<PointI>::dimensionless_type;
+
+            bool rstrad = cmp.greater_than(get<1>(pointi), get<1>(p)) != cmp.greater_than(get<1>(pointh), get<1>(p));
+            bool lstrad = cmp.less_than(get<1>(pointi), get<1>(p)) != cmp.less_than(get<1>(pointh), get<1>(p));
+
+            if (rstrad || lstrad)
+            {
+                arithmetic_type ydiff = get<1>(pointh) - get<1>(pointi);
+                arithmetic_type denom = (ydiff == constants::zero<arithmetic_type>()) ? std::numeric_limits<arithmetic_type>::epsilon() : ydiff;
+                dimensionless_type slopeInverse = (get<0>(pointh) - get<0>(pointi)) / denom;
+
+                arithmetic_type x = slopeInverse * (get<1>(p) - get<1>(pointi)) + get<0>(pointi);
+                if (rstrad && cmp.greater_than(x, get<0>(p)))
+                    ++rcross;
+                if (lstrad && cmp.less_than(x, get<0>(p)))
+                    ++lcross;
+            }
+        }
+
+        inline polygon_containment classify_crossings( std::size_t rcross, std::size_t lcross )
+        {
+            if ((rcross % 2) != (lcross % 2))
+                return polygon_containment::border;
+
+            if ((rcross % 2) == 1)
+                return polygon_containment::interior;
+
+            return polygon_containment::exterior;
+        }
+
+    }//! namespace detail;
+
     //! Check if a point is contained in a polygon or on its border (From O'Rourke Computational Geometry in C.)
     template <typename Point, typename Polygon, typename NumberComparisonPolicy>
     inline polygon_containment point_polygon_containment_or_on_border(const Point& p, const Polygon& poly, const NumberComparisonPolicy& cmp )
     {
         typedef point_sequence_traits<Polygon> access;
         typedef typename access::point_type point_type;
-        typedef typename geometric_traits<point_type>::arithmetic_type arithmetic_type;
-        using dimensionless_type = typename geometric_traits<point_type>::dimensionless_type;
 
         std::size_t size = access::size(poly);
         GEOMETRIX_ASSERT(size > 2);
 
         std::size_t rcross = 0;
         std::size_t lcross = 0;
-        bool rstrad, lstrad;
         for (std::size_t i = 0; i < size; ++i)
         {
             point_type pointi = access::get_point(poly, i);
@@ -278,31 +333,30 @@ namespace geometrix {
 
             std::size_t h = (i + size - 1) % size;
             point_type pointh = access::get_point(poly, h);
+            detail::count_edge_crossings(p, pointh, pointi, rcross, lcross, cmp);
+        }
 
-            rstrad = cmp.greater_than(get<1>(pointi), get<1>(p)) != cmp.greater_than(get<1>(pointh), get<1>(p));
-            lstrad = cmp.less_than(get<1>(pointi), get<1>(p)) != cmp.less_than(get<1>(pointh), get<1>(p));
+        return detail::classify_crossings(rcross, lcross);
+    }
 
-            if (rstrad || lstrad)
-            {
-                arithmetic_type ydiff = get<1>(pointh) - get<1>(pointi);
-                arithmetic_type denom = (ydiff == constants::zero<arithmetic_type>()) ? std::numeric_limits<arithmetic_type>::epsilon() : ydiff;
-                dimensionless_type slopeInverse = (get<0>(pointh) - get<0>(pointi)) / denom;
+    //! Check if a point is contained in a polygon with holes or on its border. Points in the interior of a hole are exterior and points on the border of a hole are on the border.
+    template <typename Point, typename PolygonPoint, typename NumberComparisonPolicy>
+    inline polygon_containment point_polygon_containment_or_on_border(const Point& p, const polygon_with_holes<PolygonPoint>& pgon, const NumberComparisonPolicy& cmp)
+    {
+        polygon_containment result = point_polygon_containment_or_on_border(p, pgon.get_outer(), cmp);
+        if (result != polygon_containment::interior)
+            return result;
 
-                arithmetic_type x = slopeInverse * (get<1>(p) - get<1>(pointi)) + get<0>(pointi);
-                if (rstrad && cmp.greater_than(x, get<0>(p)))
-                    ++rcross;
-                if (lstrad && cmp.less_than(x, get<0>(p)))
-                    ++lcross;
-            }
+        for (const auto& hole : pgon.get_holes())
+        {
+            polygon_containment holeResult = point_polygon_containment_or_on_border(p, hole, cmp);
+            if (holeResult == polygon_containment::interior)
+                return polygon_containment::exterior;
+            if (holeResult != polygon_containment::exterior)
+                return holeResult;
         }
 
-        if ((rcross % 2) != (lcross % 2))
-            return polygon_containment::border;
-
-        if ((rcross % 2) == 1)
-            return polygon_containment::interior;
-
-        return polygon_containment::exterior;
+        return polygon_containment::interior;
     }
 
 
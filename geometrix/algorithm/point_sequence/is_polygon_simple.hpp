@@ -12,6 +12,7 @@
 
 #include <geometrix/primitive/point_sequence_traits.hpp>
 #include <geometrix/algorithm/segment_intersection.hpp>
+#include <geometrix/algorithm/point_sequence/monotone_chains.hpp>
 #include <geometrix/algorithm/intersection/polyline_polyline_intersection.hpp>
 #include <geometrix/utility/memoize.hpp>
 #include <geometrix/primitive/polyline.hpp>
@@ -43,36 +44,15 @@ namespace geometrix {
 
 	}
 	
-	template <typename Polygon, typename NumberComparisonPolicy>
-	inline bool is_polygon_simple_memoized( const Polygon& poly, const NumberComparisonPolicy& cmp )
-	{
-		using namespace is_polygon_simple_detail;
-		typedef point_sequence_traits<Polygon> access;
-		typedef typename access::point_type point_type;
-		std::map<intersection_key, bool> cache;
-		auto is_intersecting = memoize( cache, [&poly, &cmp]( std::size_t i, std::size_t j, std::size_t k, std::size_t l ) -> bool
-		{
-			auto iType = segment_segment_intersection( access::get_point( poly, i ), access::get_point( poly, j ), access::get_point( poly, k ), access::get_point( poly, l ), (point_type*)nullptr, cmp );
-			return iType != e_non_crossing;
-		} );
-		std::size_t size = access::size( poly );
-		auto next = [size]( std::size_t i ){ return (i + 1) % size; };
-		for( std::size_t i = size - 1, j = 0; j < size; i = j++ ){
-			for( std::size_t k = next( j ), l = next( k ); l != i; k = l, l = next( l ) ){
-				if( is_intersecting(i,j,k,l) )
-					return false;				
-			}
-		}
-
-		return true;
-	}
-
+	//! Return whether no two non-adjacent edges of the polygon intersect.
+	//! Candidate pairs are found with a monotone chain sweep, stopping at the first intersection found.
 	template <typename Polygon, typename NumberComparisonPolicy>
 	inline bool is_polygon_simple( const Polygon& poly, const NumberComparisonPolicy& cmp )
 	{
 		using namespace is_polygon_simple_detail;
 		typedef point_sequence_traits<Polygon> access;
 		typedef typename access::point_type point_type;
+		typedef typename geometric_traits<point_type>::arithmetic_type coordinate_type;
 		std::size_t size = access::size( poly );
 		GEOMETRIX_ASSERT( size > 2 );
 
@@ -83,13 +63,19 @@ namespace geometrix {
 			auto iType = segment_segment_intersection( access::get_point( poly, i ), access::get_point( poly, next(i) ), access::get_point( poly, j ), access::get_point( poly, next(j) ), (point_type*)nullptr, cmp );
 			return iType != e_non_crossing;
 		};
-		
-		for( std::size_t i = 0; i < size - 2; ++i )
-			for( std::size_t j = i + 2; j < size; ++j )
-				if( is_intersecting( i, j ) && !adjacent(i,j) )
-					return false;
-			
-		return true;
+
+		monotone_chains<coordinate_type> chains( size, [&poly, size]( std::size_t i ) -> decltype(auto) { return access::get_point( poly, i % size ); } );
+		return !chains.for_each_candidate( cmp, [&]( std::size_t i, std::size_t j ) -> bool
+		{
+			return !adjacent(i, j) && is_intersecting( i, j );
+		} );
+	}
+
+	//! Retained for compatibility; is_polygon_simple no longer tests each pair twice so there is nothing to memoize.
+	template <typename Polygon, typename NumberComparisonPolicy>
+	inline bool is_polygon_simple_memoized( const Polygon& poly, const NumberComparisonPolicy& cmp )
+	{
+		return is_polygon_simple( poly, cmp );
 	}
 
     namespace detail{
@@ -0,0 +1,315 @@
+//
+//! Copyright © 2026
+//! Brandon Kohn
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+#ifndef GEOMETRIX_MONOTONE_CHAINS_HPP
+#define GEOMETRIX_MONOTONE_CHAINS_HPP
+#pragma once
+
+#include <geometrix/primitive/point_traits.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace geometrix {
+
+    //! \brief The segments of a point sequence split into maximal runs which are strictly monotone in lexicographic (x, y) order.
+
+    //! Two non-adjacent segments of a monotone chain cannot intersect as their x extents meet at most at a shared vertex.
+    //! The chain bounds are packed into a sort-tile-recursive tree; candidate pairs of segments whose bounds overlap are found by
+    //! querying the tree with each chain and walking the segments of overlapping chains in step. The cost is O(n log n) plus
+    //! the number of overlapping segment bounds.
+    //! Bounds are compared with the comparison policy so that pairs which only touch within tolerance are still reported.
+    template <typename CoordinateType>
+    class monotone_chains
+    {
+    public:
+
+        using coordinate_type = CoordinateType;
+
+        struct bounds
+        {
+            coordinate_type xmin, xmax, ymin, ymax;
+        };
+
+        struct chain
+        {
+            std::size_t first;//! range in get_segment_order().
+            std::size_t last;
+            bounds      box;
+        };
+
+        //! Segment k runs from pointAt(k) to pointAt(k+1).
+        template <typename PointAt>
+        monotone_chains(std::size_t nSegments, PointAt&& pointAt)
+            : monotone_chains(nSegments, pointAt, [&pointAt](std::size_t k) -> decltype(auto) { return pointAt(k + 1); }, [](std::size_t) { return true; })
+        {}
+
+        //! Segment k runs from startAt(k) to endAt(k). A chain may only run on from segment k - 1 to segment k when continues(k) is true
+        //! (e.g. segments from several point sequences numbered one sequence after another).
+        template <typename StartAt, typename EndAt, typename Continues>
+        monotone_chains(std::size_t nSegments, StartAt&& startAt, EndAt&& endAt, Continues&& continues)
+        {
+            m_bounds.reserve(nSegments);
+            m_order.reserve(nSegments);
+            std::size_t k = 0;
+            while (k < nSegments)
+            {
+                //! A chain runs while successive segments keep the same lexicographic direction.
+                int dir = direction(startAt(k), endAt(k));
+                std::size_t last = k + 1;
+                while (dir != 0 && last < nSegments && continues(last) && direction(startAt(last), endAt(last)) == dir)
+                    ++last;
+
+                chain c{ m_order.size(), m_order.size() + (last - k), bounds{} };
+                if (dir >= 0)
+                {
+                    for (std::size_t s = k; s < last; ++s)
+                        m_order.push_back(s);
+                }
+                else
+                {
+                    for (std::size_t s = last; s-- > k;)
+                        m_order.push_back(s);
+                }
+
+                for (std::size_t s = k; s < last; ++s)
+                    m_bounds.push_back(make_bounds(startAt(s), endAt(s)));
+                c.box = m_bounds[m_order[c.first]];
+                for (std::size_t i = c.first + 1; i < c.last; ++i)
+                    expand(c.box, m_bounds[m_order[i]]);
+                m_chains.push_back(c);
+                k = last;
+            }
+
+            build_tree();
+        }
+
+        std::size_t               size() const { return m_bounds.size(); }
+        const std::vector<chain>& get_chains() const { return m_chains; }
+        const std::vector<std::size_t>& get_segment_order() const { return m_order; }
+        const bounds&             get_bounds(std::size_t segment) const { return m_bounds[segment]; }
+
+        //! Call visitor(i, j) with i < j for each pair of segments whose bounds overlap. Adjacent segments are always included.
+        //! The visitor returns whether the search should cease. Returns true if the visitor stopped the search.
+        template <typename NumberComparisonPolicy, typename Visitor>
+        bool for_each_candidate(const NumberComparisonPolicy& cmp, Visitor&& visitor) const
+        {
+            auto visit = [&visitor](std::size_t i, std::size_t j) { return i < j ? visitor(i, j) : visitor(j, i); };
+
+            //! Within a chain only segments whose x extents meet (within tolerance) are candidates; usually just the next one.
+            for (const chain& c : m_chains)
+            {
+                for (std::size_t p = c.first; p < c.last; ++p)
+                {
+                    const bounds& a = get_bounds(m_order[p]);
+                    for (std::size_t q = p + 1; q < c.last; ++q)
+                    {
+                        const bounds& b = get_bounds(m_order[q]);
+                        if (cmp.less_than(a.xmax, b.xmin))
+                            break;
+                        if ((q == p + 1 || overlaps_y(a, b, cmp)) && visit(m_order[p], m_order[q]))
+                            return true;
+                    }
+                }
+            }
+
+            //! Between chains each pair of distinct chains is walked once.
+            std::vector<std::size_t> stack;
+            for (std::size_t ia = 0; ia < m_chains.size(); ++ia)
+            {
+                const chain& ca = m_chains[ia];
+                bool stop = query(ca.box, stack, cmp, [&](std::size_t ib)
+                {
+                    return ia < ib && walk(ca, *this, m_chains[ib], *this, cmp, visit);
+                });
+                if (stop)
+                    return true;
+            }
+
+            return false;
+        }
+
+        //! Call visitor(i, j) for each segment i of this decomposition and segment j of other whose bounds overlap.
+        //! The visitor returns whether the search should cease. Returns true if the visitor stopped the search.
+        template <typename NumberComparisonPolicy, typename Visitor>
+        bool for_each_candidate(const monotone_chains& other, const NumberComparisonPolicy& cmp, Visitor&& visitor) const
+        {
+            std::vector<std::size_t> stack;
+            for (const chain& ca : m_chains)
+            {
+                bool stop = other.query(ca.box, stack, cmp, [&](std::size_t ib)
+                {
+                    return walk(ca, *this, other.m_chains[ib], other, cmp, visitor);
+                });
+                if (stop)
+                    return true;
+            }
+
+            return false;
+        }
+
+    private:
+
+        template <typename Point1, typename Point2>
+        static int direction(const Point1& a, const Point2& b)
+        {
+            if (get<0>(a) < get<0>(b) || (get<0>(a) == get<0>(b) && get<1>(a) < get<1>(b)))
+                return 1;
+            if (get<0>(b) < get<0>(a) || (get<0>(a) == get<0>(b) && get<1>(b) < get<1>(a)))
+                return -1;
+            return 0;
+        }
+
+        template <typename Point1, typename Point2>
+        static bounds make_bounds(const Point1& a, const Point2& b)
+        {
+            coordinate_type ax = get<0>(a), ay = get<1>(a), bx = get<0>(b), by = get<1>(b);
+            return bounds{ (std::min)(ax, bx), (std::max)(ax, bx), (std::min)(ay, by), (std::max)(ay, by) };
+        }
+
+        static void expand(bounds& a, const bounds& b)
+        {
+            a.xmin = (std::min)(a.xmin, b.xmin);
+            a.xmax = (std::max)(a.xmax, b.xmax);
+            a.ymin = (std::min)(a.ymin, b.ymin);
+            a.ymax = (std::max)(a.ymax, b.ymax);
+        }
+
+        template <typename NumberComparisonPolicy>
+        static bool overlaps_y(const bounds& a, const bounds& b, const NumberComparisonPolicy& cmp)
+        {
+            return !cmp.less_than(a.ymax, b.ymin) && !cmp.less_than(b.ymax, a.ymin);
+        }
+
+        //! Walk the segments of two chains in x order visiting the pairs whose bounds overlap.
+        template <typename NumberComparisonPolicy, typename Visitor>
+        static bool walk(const chain& ca, const monotone_chains& a, const chain& cb, const monotone_chains& b, const NumberComparisonPolicy& cmp, Visitor&& visitor)
+        {
+            std::size_t start = cb.first;
+            for (std::size_t p = ca.first; p < ca.last; ++p)
+            {
+                std::size_t i = a.m_order[p];
+                const bounds& sa = a.get_bounds(i);
+                while (start < cb.last && cmp.less_than(b.get_bounds(b.m_order[start]).xmax, sa.xmin))
+                    ++start;
+                for (std::size_t q = start; q < cb.last; ++q)
+                {
+                    std::size_t j = b.m_order[q];
+                    const bounds& sb = b.get_bounds(j);
+                    if (cmp.less_than(sa.xmax, sb.xmin))
+                        break;
+                    if (overlaps_y(sa, sb, cmp) && visitor(i, j))
+                        return true;
+                }
+            }
+
+            return false;
+        }
+
+        //! Order the chains by sort-tile-recursive packing and build the node levels bottom up; the root is the last node.
+        void build_tree()
+        {
+            auto center_x = [](const chain& c) { return c.box.xmin + (c.box.xmax - c.box.xmin) / 2; };
+            auto center_y = [](const chain& c) { return c.box.ymin + (c.box.ymax - c.box.ymin) / 2; };
+            std::size_t n = m_chains.size();
+            std::size_t nLeaves = (n + node_capacity - 1) / node_capacity;
+            std::size_t nSlices = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(nLeaves))));
+            std::size_t sliceSize = (std::max)(nSlices, std::size_t(1)) * node_capacity;
+            std::sort(m_chains.begin(), m_chains.end(), [&](const chain& a, const chain& b) { return center_x(a) < center_x(b); });
+            for (std::size_t first = 0; first < n; first += sliceSize)
+            {
+                auto last = m_chains.begin() + (std::min)(first + sliceSize, n);
+                std::sort(m_chains.begin() + first, last, [&](const chain& a, const chain& b) { return center_y(a) < center_y(b); });
+            }
+
+            m_nodes.clear();
+            for (std::size_t first = 0; first < n; first += node_capacity)
+            {
+                node nd{ m_chains[first].box, first, (std::min)(first + node_capacity, n) };
+                for (std::size_t i = first + 1; i < nd.last; ++i)
+                    expand(nd.box, m_chains[i].box);
+                m_nodes.push_back(nd);
+            }
+            m_leaves = m_nodes.size();
+
+            std::size_t levelFirst = 0;
+            while (m_nodes.size() - levelFirst > 1)
+            {
+                std::size_t levelLast = m_nodes.size();
+                for (std::size_t first = levelFirst; first < levelLast; first += node_capacity)
+                {
+                    node nd{ m_nodes[first].box, first, (std::min)(first + node_capacity, levelLast) };
+                    for (std::size_t i = first + 1; i < nd.last; ++i)
+                        expand(nd.box, m_nodes[i].box);
+                    m_nodes.push_back(nd);
+                }
+                levelFirst = levelLast;
+            }
+        }
+
+        template <typename NumberComparisonPolicy>
+        static bool overlaps(const bounds& a, const bounds& b, const NumberComparisonPolicy& cmp)
+        {
+            return !cmp.less_than(a.xmax, b.xmin) && !cmp.less_than(b.xmax, a.xmin) && overlaps_y(a, b, cmp);
+        }
+
+        //! Call visitor(c) for each chain c whose bounds overlap box. The visitor returns whether the query should cease.
+        template <typename NumberComparisonPolicy, typename Visitor>
+        bool query(const bounds& box, std::vector<std::size_t>& stack, const NumberComparisonPolicy& cmp, Visitor&& visitor) const
+        {
+            if (m_nodes.empty())
+                return false;
+
+            stack.clear();
+            stack.push_back(m_nodes.size() - 1);
+            while (!stack.empty())
+            {
+                const node& nd = m_nodes[stack.back()];
+                bool isLeaf = stack.back() < m_leaves;
+                stack.pop_back();
+                if (!overlaps(nd.box, box, cmp))
+                    continue;
+                if (isLeaf)
+                {
+                    for (std::size_t i = nd.first; i < nd.last; ++i)
+                        if (overlaps(m_chains[i].box, box, cmp) && visitor(i))
+                            return true;
+                }
+                else
+                {
+                    for (std::size_t i = nd.first; i < nd.last; ++i)
+                        stack.push_back(i);
+                }
+            }
+
+            return false;
+        }
+
+        struct node
+        {
+            bounds      box;
+            std::size_t first;//! children in the level below, or chains for a leaf.
+            std::size_t last;
+        };
+
+        static constexpr std::size_t node_capacity = 16;
+
+        std::vector<bounds>      m_bounds;//! indexed by segment.
+        std::vector<std::size_t> m_order;//! segments grouped by chain in increasing x.
+        std::vector<chain>       m_chains;
+        std::vector<node>        m_nodes;
+        std::size_t              m_leaves = 0;
+
+    };
+
+}//namespace geometrix;
+
+#endif //! GEOMETRIX_MONOTONE_CHAINS_HPP
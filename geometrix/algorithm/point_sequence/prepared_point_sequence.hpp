@@ -0,0 +1,407 @@
+//
+//! Copyright © 2026
+//! Brandon Kohn
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+#ifndef GEOMETRIX_PREPARED_POINT_SEQUENCE_HPP
+#define GEOMETRIX_PREPARED_POINT_SEQUENCE_HPP
+#pragma once
+
+#include <geometrix/primitive/axis_aligned_bounding_box.hpp>
+#include <geometrix/primitive/point_sequence_traits.hpp>
+#include <geometrix/algorithm/distance/aabb_aabb_distance.hpp>
+#include <geometrix/algorithm/point_in_polygon.hpp>
+#include <geometrix/utility/executor.hpp>
+
+#include <boost/range/iterator_range.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <queue>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace geometrix {
+
+    //! \brief A point sequence with a cached hierarchy of the bounds of its segments.
+
+    //! Segment ranges are split at their midpoints down to leaves of fewer than leaf_size segments and the bounds of each range
+    //! are computed once, so repeated queries against the same sequence do not rescan its vertices.
+    //! When IsClosed the sequence is a polygon and the segment from the last vertex back to the first is included.
+    //! The hierarchy refers to the sequence which must outlive it and must not be modified.
+    template <typename PointSequence, bool IsClosed>
+    class prepared_point_sequence
+    {
+        using access = point_sequence_traits<PointSequence>;
+
+    public:
+
+        using sequence_type = PointSequence;
+        using point_type = typename access::point_type;
+        using length_type = typename arithmetic_type_of<point_type>::type;
+        using box_type = axis_aligned_bounding_box<point<length_type, dimension_of<point_type>::value>>;
+
+        static const std::size_t leaf_size = 5;
+
+        struct node
+        {
+            box_type    box;
+            std::size_t first;//! segments [first, last).
+            std::size_t last;
+            std::size_t children;//! index of the first of two children or 0 for a leaf.
+
+            bool is_leaf() const { return children == 0; }
+        };
+
+        prepared_point_sequence(const PointSequence& sequence)
+            : m_sequence(&sequence)
+            , m_size(access::size(sequence))
+        {
+            if (m_size == 0)
+                return;
+
+            auto p = construct<typename box_type::point_type>(get_point(0));
+            m_nodes.reserve(2 * (number_of_segments() / leaf_size) + 1);
+            m_nodes.push_back(node{ box_type(p, p), 0, number_of_segments(), 0 });
+            build(0);
+        }
+
+        const PointSequence&     get_sequence() const { return *m_sequence; }
+        const std::vector<node>& get_nodes() const { return m_nodes; }
+        bool                     empty() const { return m_size == 0; }
+
+        std::size_t number_of_segments() const
+        {
+            return IsClosed ? m_size : (m_size > 0 ? m_size - 1 : 0);
+        }
+
+        //! Segment i runs from get_point(i) to get_point(i + 1); for a polygon get_point(number_of_segments()) is the first vertex.
+        decltype(auto) get_point(std::size_t i) const
+        {
+            return access::get_point(*m_sequence, (IsClosed && i == m_size) ? 0 : i);
+        }
+
+    private:
+
+        void build(std::size_t index)
+        {
+            std::size_t first = m_nodes[index].first, last = m_nodes[index].last;
+            if (last - first < leaf_size)
+            {
+                auto lo = construct<typename box_type::point_type>(get_point(first));
+                auto hi = lo;
+                for (std::size_t i = first + 1; i <= last; ++i)
+                {
+                    bounding_box::detail::update_lo_bound(lo, get_point(i));
+                    bounding_box::detail::update_hi_bound(hi, get_point(i));
+                }
+                m_nodes[index].box = box_type(lo, hi);
+                return;
+            }
+
+            std::size_t mid = (first + last) / 2;
+            std::size_t children = m_nodes.size();
+            m_nodes[index].children = children;
+            m_nodes.push_back(node{ m_nodes[index].box, first, mid, 0 });
+            m_nodes.push_back(node{ m_nodes[index].box, mid, last, 0 });
+            build(children);
+            build(children + 1);
+            box_type box = m_nodes[children].box;
+            box.expand(m_nodes[children + 1].box);
+            m_nodes[index].box = box;
+        }
+
+        const PointSequence* m_sequence;
+        std::size_t          m_size;
+        std::vector<node>    m_nodes;//! the root is first; the children of a node are adjacent.
+
+    };
+
+    //! \brief A polygon with cached segment bounds and an index of its edges by horizontal rows for containment queries.
+
+    //! Each edge is stored in the rows spanned by its y extent. Only edges in the row of a query point can cross the horizontal ray
+    //! through it, so a containment query costs the number of edges in one row rather than the number of vertices. The row height
+    //! is chosen so that each edge is stored in a few rows on average.
+    //! Queries evaluate the same edge tests as point_in_polygon and point_polygon_containment_or_on_border and give the same results.
+    template <typename Polygon>
+    class prepared_polygon : public prepared_point_sequence<Polygon, true>
+    {
+        using base_type = prepared_point_sequence<Polygon, true>;
+
+    public:
+
+        using point_type = typename base_type::point_type;
+        using length_type = typename base_type::length_type;
+        using dimensionless_type = typename geometric_traits<point_type>::dimensionless_type;
+        using inverse_length_type = decltype(std::declval<dimensionless_type>() / std::declval<length_type>());
+        using edge_range = boost::iterator_range<const std::uint32_t*>;
+
+        prepared_polygon(const Polygon& pgon)
+            : base_type(pgon)
+        {
+            build_rows();
+        }
+
+        std::size_t number_of_rows() const { return m_rowOffsets.empty() ? 0 : m_rowOffsets.size() - 1; }
+
+        //! The edges (as indices of their first vertex) whose y extent meets row r, in increasing order.
+        edge_range get_row(std::size_t r) const
+        {
+            return edge_range(m_rowEdges.data() + m_rowOffsets[r], m_rowEdges.data() + m_rowOffsets[r + 1]);
+        }
+
+        //! Equivalent to point_in_polygon(p, get_sequence()).
+        template <typename Point>
+        bool contains(const Point& p) const
+        {
+            if (this->number_of_segments() < 3 || get<1>(p) < m_ymin || m_ymax < get<1>(p))
+                return false;
+
+            bool inside = false;
+            for (std::uint32_t k : get_row(get_row_index(get<1>(p))))
+            {
+                if (detail::edge_crosses_ray(p, this->get_point(k + 1), this->get_point(k)))
+                    inside = !inside;
+            }
+
+            return inside;
+        }
+
+        //! Equivalent to point_polygon_containment_or_on_border(p, get_sequence(), cmp).
+        template <typename Point, typename NumberComparisonPolicy>
+        polygon_containment containment(const Point& p, const NumberComparisonPolicy& cmp) const
+        {
+            GEOMETRIX_ASSERT(this->number_of_segments() > 2);
+            if (cmp.less_than(get<1>(p), m_ymin) || cmp.greater_than(get<1>(p), m_ymax))
+                return polygon_containment::exterior;
+
+            //! Edges in the neighbouring rows may still meet p.y within tolerance when it lies near a row boundary.
+            length_type y = (std::min)((std::max)(static_cast<length_type>(get<1>(p)), m_ymin), m_ymax);
+            std::size_t r = get_row_index(y);
+            std::size_t rlo = r, rhi = r;
+            while (rlo > 0 && cmp.equals(get<1>(p), get_row_start(rlo)))
+                --rlo;
+            while (rhi + 1 < number_of_rows() && cmp.equals(get<1>(p), get_row_start(rhi + 1)))
+                ++rhi;
+
+            std::size_t rcross = 0;
+            std::size_t lcross = 0;
+            auto visit = [&](std::uint32_t k)
+            {
+                decltype(auto) pointh = this->get_point(k);
+                decltype(auto) pointi = this->get_point(k + 1);
+                if (numeric_sequence_equals(p, pointh, cmp) || numeric_sequence_equals(p, pointi, cmp))
+                    return true;
+                detail::count_edge_crossings(p, pointh, pointi, rcross, lcross, cmp);
+                return false;
+            };
+
+            //! An edge spans contiguous rows so it is visited only in the first of them at or above rlo.
+            for (std::size_t row = rlo; row <= rhi; ++row)
+            {
+                for (std::uint32_t k : get_row(row))
+                    if ((row == rlo || row_span(k).first == row) && visit(k))
+                        return polygon_containment::vertex;
+            }
+
+            return detail::classify_crossings(rcross, lcross);
+        }
+
+        //! Classify each point in points writing the results to out.
+        template <typename Points, typename OutputIterator, typename NumberComparisonPolicy>
+        OutputIterator containment(const Points& points, OutputIterator out, const NumberComparisonPolicy& cmp) const
+        {
+            for (const auto& p : points)
+                *out++ = containment(p, cmp);
+            return out;
+        }
+
+        //! Classify each point in the random access range points writing the result for points[i] to out[i]. Chunks of grainSize
+        //! points (0 chooses a default) are classified concurrently on the executor.
+        template <typename Points, typename RandomAccessIterator, typename NumberComparisonPolicy, typename Executor, typename std::enable_if<is_executor<typename std::decay<Executor>::type>::value, int>::type = 0>
+        void containment(const Points& points, RandomAccessIterator out, const NumberComparisonPolicy& cmp, Executor&& executor, std::size_t grainSize = 0) const
+        {
+            auto first = std::begin(points);
+            std::size_t n = std::distance(first, std::end(points));
+            if (grainSize == 0)
+                grainSize = default_grain_size(n);
+            parallel_for(executor, n, grainSize, [&](std::size_t i, std::size_t last)
+            {
+                for (; i < last; ++i)
+                    out[i] = containment(first[i], cmp);
+            });
+        }
+
+    private:
+
+        std::size_t get_row_index(length_type y) const
+        {
+            return (std::min)(static_cast<std::size_t>((y - m_ymin) * m_rowHeightDivisor), number_of_rows() - 1);
+        }
+
+        length_type get_row_start(std::size_t r) const
+        {
+            return m_ymin + construct<dimensionless_type>(r) * m_rowHeight;
+        }
+
+        //! The first and last rows met by edge k.
+        std::pair<std::size_t, std::size_t> row_span(std::size_t k) const
+        {
+            length_type y0 = get<1>(this->get_point(k)), y1 = get<1>(this->get_point(k + 1));
+            return std::make_pair(get_row_index((std::min)(y0, y1)), get_row_index((std::max)(y0, y1)));
+        }
+
+        void build_rows()
+        {
+            std::size_t n = this->number_of_segments();
+            if (n == 0)
+                return;
+
+            const auto& root = this->get_nodes().front().box;
+            m_ymin = get<1>(root.get_lower_bound());
+            m_ymax = get<1>(root.get_upper_bound());
+
+            //! Choose the number of rows so that the rows hold about 3n edges in total (n for the rows holding each edge's end points).
+            length_type extent = m_ymax - m_ymin;
+            length_type sumExtents = constants::zero<length_type>();
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                length_type y0 = get<1>(this->get_point(k)), y1 = get<1>(this->get_point(k + 1));
+                sumExtents += y0 < y1 ? y1 - y0 : y0 - y1;
+            }
+
+            std::size_t nRows = 1;
+            if (sumExtents > constants::zero<length_type>())
+            {
+                double rows = 2.0 * n * static_cast<double>(extent / sumExtents);
+                nRows = static_cast<std::size_t>((std::min)((std::max)(rows, 1.0), static_cast<double>(n)));
+                m_rowHeight = extent / construct<dimensionless_type>(nRows);
+                m_rowHeightDivisor = construct<dimensionless_type>(nRows) / extent;
+            }
+            else
+            {
+                m_rowHeight = constants::zero<length_type>();
+                m_rowHeightDivisor = constants::zero<dimensionless_type>() / constants::one<length_type>();
+            }
+
+            //! Count the edges in each row then place them by prefix sums.
+            m_rowOffsets.assign(nRows + 1, 0);
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                auto span = row_span(k);
+                for (std::size_t r = span.first; r <= span.second; ++r)
+                    ++m_rowOffsets[r + 1];
+            }
+
+            for (std::size_t r = 0; r < nRows; ++r)
+                m_rowOffsets[r + 1] += m_rowOffsets[r];
+
+            m_rowEdges.resize(m_rowOffsets.back());
+            std::vector<std::uint32_t> next(m_rowOffsets.begin(), m_rowOffsets.end() - 1);
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                auto span = row_span(k);
+                for (std::size_t r = span.first; r <= span.second; ++r)
+                    m_rowEdges[next[r]++] = static_cast<std::uint32_t>(k);
+            }
+        }
+
+        length_type                m_ymin;
+        length_type                m_ymax;
+        length_type                m_rowHeight;
+        inverse_length_type        m_rowHeightDivisor;
+        std::vector<std::uint32_t> m_rowOffsets;//! edges of row r are m_rowEdges[m_rowOffsets[r], m_rowOffsets[r + 1]).
+        std::vector<std::uint32_t> m_rowEdges;
+
+    };
+
+    template <typename Polyline>
+    using prepared_polyline = prepared_point_sequence<Polyline, false>;
+
+    template <typename Polygon>
+    inline prepared_polygon<Polygon> make_prepared_polygon(const Polygon& poly)
+    {
+        return prepared_polygon<Polygon>(poly);
+    }
+
+    template <typename Polyline>
+    inline prepared_polyline<Polyline> make_prepared_polyline(const Polyline& poly)
+    {
+        return prepared_polyline<Polyline>(poly);
+    }
+
+    template <typename Point, typename Polygon>
+    inline bool point_in_polygon(const Point& p, const prepared_polygon<Polygon>& pgon)
+    {
+        return pgon.contains(p);
+    }
+
+    template <typename Point, typename Polygon, typename NumberComparisonPolicy>
+    inline polygon_containment point_polygon_containment_or_on_border(const Point& p, const prepared_polygon<Polygon>& pgon, const NumberComparisonPolicy& cmp)
+    {
+        return pgon.containment(p, cmp);
+    }
+
+    namespace detail {
+
+        //! Best-first search over pairs of nodes from two prepared sequences in order of the distance between their bounds.
+        //! Pairs where either node is a leaf are passed to visitLeaves(node1, node2, minDist2) which returns the least squared distance
+        //! between their segments. Pairs whose bounds are no closer than the least distance found are pruned. Returns the least distance.
+        template <typename Prepared1, typename Prepared2, typename Area, typename LeafVisitor>
+        inline Area prepared_sequence_distance_search(const Prepared1& p1, const Prepared2& p2, Area minDist2, LeafVisitor&& visitLeaves)
+        {
+            using work_item = std::tuple<std::size_t, std::size_t, Area>;
+
+            struct priority_cmp
+            {
+                bool operator()(const work_item& lhs, const work_item& rhs) const { return std::get<2>(lhs) > std::get<2>(rhs); }
+            };
+
+            const auto& nodes1 = p1.get_nodes();
+            const auto& nodes2 = p2.get_nodes();
+            auto Q = std::priority_queue<work_item, std::vector<work_item>, priority_cmp>{};
+            Q.emplace(0, 0, aabb_aabb_distance_sqrd(nodes1[0].box, nodes2[0].box));
+
+            std::size_t n1, n2;
+            Area d2;
+            while (!Q.empty())
+            {
+                std::tie(n1, n2, d2) = Q.top();
+                Q.pop();
+
+                if (d2 >= minDist2)
+                    break;
+
+                const auto& a = nodes1[n1];
+                const auto& b = nodes2[n2];
+                if (a.is_leaf() || b.is_leaf())
+                {
+                    minDist2 = (std::min)(minDist2, visitLeaves(a, b, minDist2));
+                    continue;
+                }
+
+                //! Divide and conquer.
+                for (std::size_t i = a.children; i < a.children + 2; ++i)
+                {
+                    for (std::size_t j = b.children; j < b.children + 2; ++j)
+                    {
+                        d2 = aabb_aabb_distance_sqrd(nodes1[i].box, nodes2[j].box);
+                        if (d2 <= minDist2)
+                            Q.emplace(i, j, d2);
+                    }
+                }
+            }
+
+            return minDist2;
+        }
+
+    }//! namespace detail;
+
+}//namespace geometrix;
+
+#endif //! GEOMETRIX_PREPARED_POINT_SEQUENCE_HPP
@@ -12,14 +12,22 @@
 
 #include <geometrix/primitive/point_sequence_traits.hpp>
 #include <geometrix/algorithm/segment_intersection.hpp>
+#include <geometrix/algorithm/point_sequence/monotone_chains.hpp>
+
+#include <algorithm>
+#include <vector>
 
 namespace geometrix {
 	
+	//! Visit each pair of segments i < j of the polyline which intersect, excluding adjacent segments which only share their common vertex.
+	//! The visitor is called as visit(i, j, iType, x0, x1) in increasing (i, j) order.
+	//! Candidate pairs are found with a monotone chain sweep so the cost is O((n + k) log n) for k candidate pairs rather than O(n^2).
 	template <typename Polyline, typename Visitor, typename NumberComparisonPolicy>
 	inline bool polyline_self_intersection( const Polyline& poly, Visitor&& visit, const NumberComparisonPolicy& cmp )
 	{
 		typedef point_sequence_traits<Polyline> access;
 		typedef typename access::point_type point_type;
+		typedef typename geometric_traits<point_type>::arithmetic_type coordinate_type;
 		std::size_t size = access::size( poly );
 
 		if (size < 3)
@@ -27,27 +35,54 @@ namespace geometrix {
 
 		auto next = []( std::size_t i ){ return i + 1; };
 		auto adjacent = [&next](std::size_t i, std::size_t j) { return next(i) == j || next(j) == i; };
-		point_type xPoints[2];
-		intersection_type iType;
-		auto is_intersecting = [&]( std::size_t i, std::size_t j ) -> bool
+
+		struct intersection
 		{
-			iType = segment_segment_intersection( access::get_point( poly, i ), access::get_point( poly, next(i) ), access::get_point( poly, j ), access::get_point( poly, next(j) ), xPoints, cmp );
-			return iType != e_non_crossing;
+			std::size_t       i, j;
+			intersection_type iType;
+			point_type        xPoints[2];
 		};
+		std::vector<intersection> results;
 
-		bool isIntersecting = false;
-		for (std::size_t i = 0; i < size - 2; ++i)
+		monotone_chains<coordinate_type> chains( size - 1, [&poly]( std::size_t i ) -> decltype(auto) { return access::get_point( poly, i ); } );
+		chains.for_each_candidate( cmp, [&]( std::size_t i, std::size_t j ) -> bool
 		{
-			for (std::size_t j = i + 1; (j + 1) < size; ++j)
+			intersection x;
+			x.iType = segment_segment_intersection( access::get_point( poly, i ), access::get_point( poly, next(i) ), access::get_point( poly, j ), access::get_point( poly, next(j) ), x.xPoints, cmp );
+			if (x.iType != e_non_crossing && (!adjacent(i, j) || x.iType == e_overlapping))
 			{
-				if (is_intersecting(i, j) && (!adjacent(i, j) || iType == e_overlapping))
-				{
-					isIntersecting = true;
-					visit(i, j, iType, xPoints[0], xPoints[1]);
-				}
+				x.i = i;
+				x.j = j;
+				results.push_back( x );
 			}
-		}
-		return isIntersecting;
+			return false;
+		} );
+
+		std::sort( results.begin(), results.end(), []( const intersection& lhs, const intersection& rhs ) { return lhs.i < rhs.i || (lhs.i == rhs.i && lhs.j < rhs.j); } );
+		for (const auto& x : results)
+			visit(x.i, x.j, x.iType, x.xPoints[0], x.xPoints[1]);
+
+		return !results.empty();
+	}
+
+	//! Return whether the polyline has no self intersections (in the sense of polyline_self_intersection). Stops at the first intersection found.
+	template <typename Polyline, typename NumberComparisonPolicy>
+	inline bool is_polyline_simple( const Polyline& poly, const NumberComparisonPolicy& cmp )
+	{
+		typedef point_sequence_traits<Polyline> access;
+		typedef typename access::point_type point_type;
+		typedef typename geometric_traits<point_type>::arithmetic_type coordinate_type;
+		std::size_t size = access::size( poly );
+
+		if (size < 3)
+			return true;
+
+		monotone_chains<coordinate_type> chains( size - 1, [&poly]( std::size_t i ) -> decltype(auto) { return access::get_point( poly, i ); } );
+		return !chains.for_each_candidate( cmp, [&]( std::size_t i, std::size_t j ) -> bool
+		{
+			auto iType = segment_segment_intersection( access::get_point( poly, i ), access::get_point( poly, i + 1 ), access::get_point( poly, j ), access::get_point( poly, j + 1 ), (point_type*)nullptr, cmp );
+			return iType != e_non_crossing && (j != i + 1 || iType == e_overlapping);
+		} );
 	}
 
 }//namespace geometrix;
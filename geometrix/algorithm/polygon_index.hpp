@@ -0,0 +1,376 @@
+//
+//! Copyright © 2026
+//! Brandon Kohn
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+#ifndef GEOMETRIX_POLYGON_INDEX_HPP
+#define GEOMETRIX_POLYGON_INDEX_HPP
+#pragma once
+
+#include <geometrix/primitive/axis_aligned_bounding_box.hpp>
+#include <geometrix/primitive/point_sequence_traits.hpp>
+#include <geometrix/primitive/polygon_with_holes.hpp>
+#include <geometrix/algorithm/point_in_polygon.hpp>
+#include <geometrix/algorithm/intersection/polygon_aabb_intersection.hpp>
+#include <geometrix/algorithm/intersection/segment_aabb_intersection.hpp>
+#include <geometrix/algorithm/intersection/segment_polygon_intersection.hpp>
+#include <geometrix/utility/assert.hpp>
+#include <geometrix/utility/executor.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+namespace geometrix {
+
+    namespace detail {
+
+        //! The distance along a Hilbert curve filling a 2^16 x 2^16 grid of the cell (x, y).
+        inline std::uint32_t hilbert_index_2d(std::uint32_t x, std::uint32_t y)
+        {
+            std::uint32_t d = 0;
+            for (std::uint32_t s = 1u << 15; s > 0; s >>= 1)
+            {
+                std::uint32_t rx = (x & s) > 0;
+                std::uint32_t ry = (y & s) > 0;
+                d += s * s * ((3 * rx) ^ ry);
+                if (ry == 0)
+                {
+                    if (rx == 1)
+                    {
+                        x = 0xFFFF - x;
+                        y = 0xFFFF - y;
+                    }
+                    std::swap(x, y);
+                }
+            }
+            return d;
+        }
+
+        template <typename Polygon>
+        inline const Polygon& get_outer_polygon(const Polygon& pgon, typename std::enable_if<!is_polygon_with_holes<Polygon>::value>::type* = nullptr)
+        {
+            return pgon;
+        }
+
+        template <typename Polygon>
+        inline decltype(auto) get_outer_polygon(const Polygon& pgon, typename std::enable_if<is_polygon_with_holes<Polygon>::value>::type* = nullptr)
+        {
+            return pgon.get_outer();
+        }
+
+        //! Call fn on the outer polygon and then on each hole until fn returns true. Returns whether fn returned true.
+        template <typename Polygon, typename Fn>
+        inline bool any_polygon_ring(const Polygon& pgon, Fn&& fn, typename std::enable_if<!is_polygon_with_holes<Polygon>::value>::type* = nullptr)
+        {
+            return fn(pgon);
+        }
+
+        template <typename Polygon, typename Fn>
+        inline bool any_polygon_ring(const Polygon& pgon, Fn&& fn, typename std::enable_if<is_polygon_with_holes<Polygon>::value>::type* = nullptr)
+        {
+            if (fn(pgon.get_outer()))
+                return true;
+            for (const auto& hole : pgon.get_holes())
+                if (fn(hole))
+                    return true;
+            return false;
+        }
+
+        template <typename Polygon, typename AABB>
+        inline bool polygon_index_box_intersection(const Polygon& pgon, const AABB& b, typename std::enable_if<!is_polygon_with_holes<Polygon>::value>::type* = nullptr)
+        {
+            return polygon_aabb_intersection(pgon, b);
+        }
+
+        //! A box misses a polygon with holes when it misses the outer polygon or lies inside a hole without meeting its border.
+        template <typename Polygon, typename AABB>
+        inline bool polygon_index_box_intersection(const Polygon& pgon, const AABB& b, typename std::enable_if<is_polygon_with_holes<Polygon>::value>::type* = nullptr)
+        {
+            if (!polygon_aabb_intersection(pgon.get_outer(), b))
+                return false;
+
+            for (const auto& hole : pgon.get_holes())
+            {
+                if (!point_in_polygon(b[0], hole))
+                    continue;
+
+                using access = point_sequence_traits<typename std::decay<decltype(hole)>::type>;
+                bool meetsBorder = false;
+                std::size_t size = access::size(hole);
+                for (std::size_t i = 0, j = 1; i < size && !meetsBorder; ++i, j = (j + 1) % size)
+                    meetsBorder = segment_aabb_intersection(access::get_point(hole, i), access::get_point(hole, j), b);
+                if (!meetsBorder)
+                    return false;
+            }
+
+            return true;
+        }
+
+    }//! namespace detail;
+
+    //! \brief A packed Hilbert R-tree over the bounds of a set of polygons for stabbing, box and segment queries.
+
+    //! The polygons are sorted by the Hilbert index of their bounds' centres and packed bottom up into nodes of node_size
+    //! entries, so the tree is a contiguous array of boxes built in O(n log n) with no per-node allocation. The children of
+    //! node j on a level are entries [j * node_size, (j + 1) * node_size) of the level below, so nodes need store only their bounds.
+    //! Candidates found through the bounds are refined with the exact tests for the polygon type, so a query costs the
+    //! number of polygons whose bounds it meets rather than the number of polygons.
+    //! Polygons may be point sequences or polygon_with_holes. The index refers to the polygons, which must outlive it and must not be modified.
+    //! \code
+    //! polygon_index<std::vector<polygon2>> index(zones);
+    //! index.stab(p, [&](std::size_t i){ ... }, cmp);//! visits each zone containing p or with p on its border.
+    //! \endcode
+    template <typename Polygons>
+    class polygon_index
+    {
+    public:
+
+        using polygon_type = typename std::decay<decltype(*std::begin(std::declval<const Polygons&>()))>::type;
+        using outer_polygon_type = typename std::decay<decltype(detail::get_outer_polygon(std::declval<const polygon_type&>()))>::type;
+        using point_type = typename point_sequence_traits<outer_polygon_type>::point_type;
+        using length_type = typename arithmetic_type_of<point_type>::type;
+        using box_type = axis_aligned_bounding_box<point<length_type, 2>>;
+
+        BOOST_STATIC_CONSTANT(std::size_t, default_node_size = 16);
+
+        //! Bulk load the index. Each polygon must have at least one vertex.
+        polygon_index(const Polygons& polygons, std::size_t nodeSize = default_node_size)
+            : m_polygons(&polygons)
+            , m_nodeSize((std::max)(nodeSize, std::size_t(2)))
+        {
+            serial_executor executor;
+            build(executor, (std::numeric_limits<std::size_t>::max)());
+        }
+
+        //! Bulk load the index computing the bounds of chunks of grainSize polygons (0 chooses a default) concurrently on the executor.
+        //! The resulting index is identical to the one built by the serial constructor.
+        template <typename Executor, typename std::enable_if<is_executor<typename std::decay<Executor>::type>::value, int>::type = 0>
+        polygon_index(const Polygons& polygons, Executor&& executor, std::size_t nodeSize = default_node_size, std::size_t grainSize = 0)
+            : m_polygons(&polygons)
+            , m_nodeSize((std::max)(nodeSize, std::size_t(2)))
+        {
+            build(executor, grainSize);
+        }
+
+        const Polygons& get_polygons() const { return *m_polygons; }
+        const polygon_type& get_polygon(std::size_t i) const { return (*m_polygons)[i]; }
+
+        std::size_t size() const { return m_items.size(); }
+        bool        empty() const { return m_items.empty(); }
+        std::size_t node_size() const { return m_nodeSize; }
+
+        //! The number of levels including the level of polygon bounds. The root is the single node of the last level.
+        std::size_t number_of_levels() const { return m_levels.empty() ? 0 : m_levels.size() - 1; }
+
+        //! The bounds of the polygons with index i.
+        const box_type& get_bounds(std::size_t i) const { return m_boxes[m_positions[i]]; }
+
+        //! Visit the index of each polygon whose bounds intersect box.
+        template <typename Box, typename Visitor>
+        void for_each_candidate(const Box& box, Visitor&& visitor) const
+        {
+            traverse([&box](const box_type& b) { return b.intersects(box); }, [&visitor](std::size_t i) { visitor(i); });
+        }
+
+        //! Visit the index of each polygon containing p as determined by point_in_polygon.
+        template <typename Point, typename Visitor>
+        void stab(const Point& p, Visitor&& visitor) const
+        {
+            traverse([&p](const box_type& b) { return b.intersects(p); }, [this, &p, &visitor](std::size_t i)
+            {
+                if (point_in_polygon(p, get_polygon(i)))
+                    visitor(i);
+            });
+        }
+
+        //! Visit the index of each polygon containing p or with p on its border as determined by point_polygon_containment_or_on_border.
+        template <typename Point, typename Visitor, typename NumberComparisonPolicy>
+        void stab(const Point& p, Visitor&& visitor, const NumberComparisonPolicy& cmp) const
+        {
+            traverse([&p, &cmp](const box_type& b) { return b.intersects(p, cmp); }, [this, &p, &visitor, &cmp](std::size_t i)
+            {
+                if (point_polygon_containment_or_on_border(p, get_polygon(i), cmp) != polygon_containment::exterior)
+                    visitor(i);
+            });
+        }
+
+        //! Visit the index of each polygon which intersects the box.
+        template <typename Point, typename Visitor>
+        void search(const axis_aligned_bounding_box<Point>& box, Visitor&& visitor) const
+        {
+            traverse([&box](const box_type& b) { return b.intersects(box); }, [this, &box, &visitor](std::size_t i)
+            {
+                if (detail::polygon_index_box_intersection(get_polygon(i), box))
+                    visitor(i);
+            });
+        }
+
+        //! Visit the index of each polygon which the segment from a to b meets. A segment meets a polygon when it crosses or touches
+        //! a border of the polygon or starts in it.
+        template <typename PointA, typename PointB, typename Visitor, typename NumberComparisonPolicy>
+        void search(const PointA& a, const PointB& b, Visitor&& visitor, const NumberComparisonPolicy& cmp) const
+        {
+            traverse([&a, &b](const box_type& box) { return segment_aabb_intersection(a, b, box); }, [this, &a, &b, &visitor, &cmp](std::size_t i)
+            {
+                const auto& pgon = get_polygon(i);
+                bool meets = detail::any_polygon_ring(pgon, [&a, &b, &cmp](const auto& ring)
+                {
+                    return segment_polygon_border_intersect(a, b, ring, [](intersection_type, std::size_t, std::size_t, const auto&, const auto&) { return true; }, cmp);
+                });
+                if (meets || point_polygon_containment_or_on_border(a, pgon, cmp) != polygon_containment::exterior)
+                    visitor(i);
+            });
+        }
+
+        template <typename Segment, typename Visitor, typename NumberComparisonPolicy>
+        void search(const Segment& s, Visitor&& visitor, const NumberComparisonPolicy& cmp, typename std::enable_if<is_segment<Segment>::value>::type* = nullptr) const
+        {
+            search(get_start(s), get_end(s), std::forward<Visitor>(visitor), cmp);
+        }
+
+        //! Find the indices of the polygons containing p or with p on its border in increasing order.
+        template <typename Point, typename NumberComparisonPolicy>
+        std::vector<std::size_t> find_containing(const Point& p, const NumberComparisonPolicy& cmp) const
+        {
+            std::vector<std::size_t> result;
+            stab(p, [&result](std::size_t i) { result.push_back(i); }, cmp);
+            std::sort(result.begin(), result.end());
+            return result;
+        }
+
+    private:
+
+        //! Visit the items under the nodes for which test(box) holds.
+        template <typename NodeTest, typename ItemVisitor>
+        void traverse(NodeTest&& test, ItemVisitor&& visit) const
+        {
+            if (m_items.empty())
+                return;
+
+            std::size_t root = number_of_levels() - 1;
+            if (test(m_boxes[m_levels[root]]))
+                traverse(root, 0, test, visit);
+        }
+
+        template <typename NodeTest, typename ItemVisitor>
+        void traverse(std::size_t level, std::size_t j, NodeTest& test, ItemVisitor& visit) const
+        {
+            if (level == 0)
+            {
+                visit(m_items[j]);
+                return;
+            }
+
+            std::size_t first = m_levels[level - 1] + j * m_nodeSize;
+            std::size_t last = (std::min)(first + m_nodeSize, m_levels[level]);
+            for (std::size_t k = first; k < last; ++k)
+                if (test(m_boxes[k]))
+                    traverse(level - 1, k - m_levels[level - 1], test, visit);
+        }
+
+        template <typename Executor>
+        void build(Executor& executor, std::size_t grainSize)
+        {
+            std::size_t n = std::distance(std::begin(*m_polygons), std::end(*m_polygons));
+            GEOMETRIX_ASSERT(n <= (std::numeric_limits<std::uint32_t>::max)());
+            if (n == 0)
+                return;
+
+            using bounds_point = typename box_type::point_type;
+            auto origin = construct<bounds_point>(constants::zero<length_type>(), constants::zero<length_type>());
+            std::vector<box_type> boxes(n, box_type(origin, origin));
+            if (grainSize == 0)
+                grainSize = default_grain_size(n);
+            parallel_for(executor, n, grainSize, [this, &boxes](std::size_t i, std::size_t last)
+            {
+                for (; i < last; ++i)
+                    boxes[i] = make_aabb<bounds_point>(detail::get_outer_polygon(get_polygon(i)));
+            });
+
+            //! Order the polygons along a Hilbert curve through the centres of their bounds.
+            box_type extent = boxes[0];
+            for (std::size_t i = 1; i < n; ++i)
+                extent.expand(boxes[i]);
+
+            auto scale = [](length_type v, length_type lo, length_type hi) -> std::uint32_t
+            {
+                if (!(lo < hi))
+                    return 0;
+                double t = static_cast<double>((v - lo) / (hi - lo));
+                return static_cast<std::uint32_t>((std::min)((std::max)(t, 0.0), 1.0) * 65535.0);
+            };
+
+            std::vector<std::uint32_t> keys(n);
+            parallel_for(executor, n, grainSize, [&](std::size_t i, std::size_t last)
+            {
+                for (; i < last; ++i)
+                {
+                    length_type two = constants::two<length_type>();
+                    length_type cx = (get<0>(boxes[i].get_lower_bound()) + get<0>(boxes[i].get_upper_bound())) / two;
+                    length_type cy = (get<1>(boxes[i].get_lower_bound()) + get<1>(boxes[i].get_upper_bound())) / two;
+                    keys[i] = detail::hilbert_index_2d(scale(cx, get<0>(extent.get_lower_bound()), get<0>(extent.get_upper_bound())), scale(cy, get<1>(extent.get_lower_bound()), get<1>(extent.get_upper_bound())));
+                }
+            });
+
+            m_items.resize(n);
+            std::iota(m_items.begin(), m_items.end(), std::uint32_t(0));
+            std::sort(m_items.begin(), m_items.end(), [&keys](std::uint32_t a, std::uint32_t b) { return keys[a] < keys[b] || (keys[a] == keys[b] && a < b); });
+
+            //! Count the nodes on each level.
+            m_levels.assign(1, 0);
+            std::size_t count = n;
+            m_levels.push_back(count);
+            while (count > 1)
+            {
+                count = (count + m_nodeSize - 1) / m_nodeSize;
+                m_levels.push_back(m_levels.back() + count);
+            }
+
+            m_boxes.clear();
+            m_boxes.reserve(m_levels.back());
+            m_positions.resize(n);
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                m_boxes.push_back(boxes[m_items[k]]);
+                m_positions[m_items[k]] = static_cast<std::uint32_t>(k);
+            }
+
+            for (std::size_t level = 1; level + 1 < m_levels.size(); ++level)
+            {
+                for (std::size_t first = m_levels[level - 1]; first < m_levels[level]; first += m_nodeSize)
+                {
+                    std::size_t last = (std::min)(first + m_nodeSize, m_levels[level]);
+                    box_type box = m_boxes[first];
+                    for (std::size_t k = first + 1; k < last; ++k)
+                        box.expand(m_boxes[k]);
+                    m_boxes.push_back(box);
+                }
+            }
+        }
+
+        const Polygons*            m_polygons;
+        std::size_t                m_nodeSize;
+        std::vector<box_type>      m_boxes;//! the boxes of each level from the polygon bounds up to the root.
+        std::vector<std::size_t>   m_levels;//! the boxes of level l are m_boxes[m_levels[l], m_levels[l + 1]).
+        std::vector<std::uint32_t> m_items;//! the polygon index of each entry of level 0.
+        std::vector<std::uint32_t> m_positions;//! the level 0 entry of each polygon.
+
+    };
+
+    template <typename Polygons>
+    inline polygon_index<Polygons> make_polygon_index(const Polygons& polygons, std::size_t nodeSize = polygon_index<Polygons>::default_node_size)
+    {
+        return polygon_index<Polygons>(polygons, nodeSize);
+    }
+
+}//namespace geometrix;
+
+#endif //! GEOMETRIX_POLYGON_INDEX_HPP
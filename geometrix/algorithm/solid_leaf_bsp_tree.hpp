@@ -14,6 +14,8 @@
 #include <geometrix/utility/unique_ptr.hpp>
 #include <geometrix/algorithm/classify_simplex_to_plane.hpp>
 #include <geometrix/algorithm/intersection/segment_plane_intersection.hpp>
+#include <geometrix/algorithm/distance/aabb_aabb_distance.hpp>
+#include <geometrix/algorithm/distance/point_aabb_distance.hpp>
 #include <geometrix/algorithm/distance/point_segment_distance.hpp>
 #include <geometrix/algorithm/distance/segment_segment_distance.hpp>
 #include <geometrix/algorithm/distance/segment_plane_distance.hpp>
@@ -22,13 +24,15 @@
 #include <geometrix/algorithm/intersection/ray_segment_intersection.hpp>
 #include <geometrix/algorithm/point_in_solid_classification.hpp>
 #include <geometrix/utility/ignore_unused_warnings.hpp>
+#include <geometrix/utility/executor.hpp>
 
 #include <boost/range/concepts.hpp>
 #include <boost/range/algorithm_ext/iota.hpp>
 #include <boost/dynamic_bitset.hpp>
 #include <boost/mpl/inherit.hpp>
 #include <boost/mpl/empty_base.hpp>
-#include <stack>
+#include <numeric>
+#include <vector>
 #include <type_traits>
 
 namespace geometrix {
@@ -230,6 +234,21 @@ namespace geometrix {
         {
             return  segment_segment_distance_sqrd(s, smplx, cmp);
         }
+
+        //! The bounds of the vertices of a simplex.
+        template <typename Box, typename Simplex>
+        inline Box simplex_bounds(const Simplex& smplx)
+        {
+            using point_t = typename Box::point_type;
+            auto p = construct<point_t>(get_vertex(smplx, 0));
+            Box box(p, p);
+            for (std::size_t i = 1, n = number_vertices(smplx); i < n; ++i)
+            {
+                p = construct<point_t>(get_vertex(smplx, i));
+                box.expand(Box(p, p));
+            }
+            return box;
+        }
     }//! namespace bsp_detail;
 
     struct identity_simplex_extractor
@@ -290,21 +309,58 @@ namespace geometrix {
             return std::move(r);
         }
 
+        //! An entry of the stack of far subtrees of a ray query: the subtree, the ray parameter at which it is left and the node whose plane bounds it there.
+        struct ray_stack_item
+        {
+            index_type  node;
+            length_type tmax;
+            index_type  plane_node;
+        };
+
+        //! An entry of the stack of a packet traversal: the subtree and the range of the index buffer holding the packet's points which lie in it.
+        struct packet_stack_item
+        {
+            index_type  node;
+            std::size_t first;
+            std::size_t last;
+            std::size_t buffer;
+        };
+
     public:
 
+        //! \brief Scratch space for queries which may be reused to avoid allocating in each query.
+        //! A context should be used by one query at a time.
+        class query_context
+        {
+            friend class solid_leaf_bsp_tree;
+
+            std::vector<index_type>     m_nodes;
+            std::vector<ray_stack_item> m_rays;
+            std::vector<std::size_t>       m_points;
+            std::vector<packet_stack_item> m_packets;
+        };
+
+        //! The number of points which the batched point_in_solid_space traverses through the tree together.
+        BOOST_STATIC_CONSTANT(std::size_t, default_packet_size = 256);
+
+        //! The number of simplices above which the parallel build splits the construction of a node's subtrees.
+        BOOST_STATIC_CONSTANT(std::size_t, default_parallel_threshold = 4096);
+
         solid_leaf_bsp_tree() = default;
 
         template <typename Simplices, typename SimplexSelector, typename NumberComparisonPolicy, typename SimplexExtractor>
         solid_leaf_bsp_tree(const Simplices& pgons, const SimplexSelector& selector, const NumberComparisonPolicy& cmp, SimplexExtractor&& extract)
         {
-            for (const auto& pgon : pgons)
-            {
-                auto smplx = extract(pgon);
-                m_simplices.emplace_back(smplx);
-                m_planes.emplace_back(make_hyperplane(smplx));
-            }
+            serial_executor executor;
+            build(pgons, selector, cmp, extract, executor, (std::numeric_limits<std::size_t>::max)());
+        }
 
-            m_root = build_root(pgons, boost::dynamic_bitset<>(boost::size(pgons)), make_index_range(index_vector(boost::size(pgons))), selector, extract, cmp);
+        //! Build the tree using executor to build the subtrees of nodes over more than parallelThreshold simplices concurrently.
+        //! The selector must be safe to call concurrently. The resulting tree is identical to the one built by the serial constructor.
+        template <typename Simplices, typename SimplexSelector, typename NumberComparisonPolicy, typename SimplexExtractor, typename Executor, typename std::enable_if<is_executor<typename std::decay<Executor>::type>::value, int>::type = 0>
+        solid_leaf_bsp_tree(const Simplices& pgons, const SimplexSelector& selector, const NumberComparisonPolicy& cmp, SimplexExtractor&& extract, Executor&& executor, std::size_t parallelThreshold = default_parallel_threshold)
+        {
+            build(pgons, selector, cmp, extract, executor, (std::max)(parallelThreshold, std::size_t(1)));
         }
 
         template <typename Simplices, typename SimplexSelector, typename NumberComparisonPolicy>
@@ -322,6 +378,7 @@ namespace geometrix {
             , m_indices(std::move(rhs.m_indices))
             , m_simplices(std::move(rhs.m_simplices))
             , m_planes(std::move(rhs.m_planes))
+            , m_bounds(std::move(rhs.m_bounds))
             , m_root(rhs.m_root)
         {}
 
@@ -334,6 +391,7 @@ namespace geometrix {
             m_indices = std::move(rhs.m_indices);
             m_simplices = std::move(rhs.m_simplices);
             m_planes = std::move(rhs.m_planes);
+            m_bounds = std::move(rhs.m_bounds);
             m_root = rhs.m_root;
             return *this;
         }
@@ -344,87 +402,215 @@ namespace geometrix {
             return point_in_solid_space(m_root, p, cmp);
         }
 
+        //! Classify each point in the random access range points writing the result for points[i] to out[i].
+        //! Incoherent points are traversed through the tree in packets. The results are the same as those of the scalar overload.
+        template <typename Points, typename RandomAccessIterator, typename NumberComparisonPolicy>
+        void point_in_solid_space(const Points& points, RandomAccessIterator out, const NumberComparisonPolicy& cmp) const
+        {
+            auto first = std::begin(points);
+            std::size_t n = std::distance(first, std::end(points));
+            query_context context;
+            point_in_solid_space_range(first, 0, n, out, cmp, context);
+        }
+
+        //! Classify each point in the random access range points writing the result for points[i] to out[i]. Chunks of grainSize
+        //! points (0 chooses a default) are classified concurrently on the executor.
+        template <typename Points, typename RandomAccessIterator, typename NumberComparisonPolicy, typename Executor, typename std::enable_if<is_executor<typename std::decay<Executor>::type>::value, int>::type = 0>
+        void point_in_solid_space(const Points& points, RandomAccessIterator out, const NumberComparisonPolicy& cmp, Executor&& executor, std::size_t grainSize = 0) const
+        {
+            auto first = std::begin(points);
+            std::size_t n = std::distance(first, std::end(points));
+            if (grainSize == 0)
+                grainSize = default_grain_size(n);
+            parallel_for(executor, n, grainSize, [&](std::size_t i, std::size_t last)
+            {
+                query_context context;
+                point_in_solid_space_range(first, i, last, out, cmp, context);
+            });
+        }
+
         template <typename Point, typename Vector, typename NumberComparisonPolicy>
         solid_bsp_ray_tracing_result<typename arithmetic_type_of<Point>::type> ray_intersection(const Point& p, const Vector& d, const NumberComparisonPolicy& cmp) const
         {
-            return ray_intersection_impl(p, d, false, cmp);
+            query_context context;
+            return ray_intersection_impl(p, d, false, cmp, context);
+        }
+
+        template <typename Point, typename Vector, typename NumberComparisonPolicy>
+        solid_bsp_ray_tracing_result<typename arithmetic_type_of<Point>::type> ray_intersection(const Point& p, const Vector& d, const NumberComparisonPolicy& cmp, query_context& context) const
+        {
+            return ray_intersection_impl(p, d, false, cmp, context);
         }
 
         template <typename Point, typename Vector, typename NumberComparisonPolicy>
         solid_bsp_ray_tracing_result<typename arithmetic_type_of<Point>::type> ray_intersection_only_border(const Point& p, const Vector& d, const NumberComparisonPolicy& cmp) const
         {
-            return ray_intersection_impl(p, d, true, cmp);
+            query_context context;
+            return ray_intersection_impl(p, d, true, cmp, context);
+        }
+
+        template <typename Point, typename Vector, typename NumberComparisonPolicy>
+        solid_bsp_ray_tracing_result<typename arithmetic_type_of<Point>::type> ray_intersection_only_border(const Point& p, const Vector& d, const NumberComparisonPolicy& cmp, query_context& context) const
+        {
+            return ray_intersection_impl(p, d, true, cmp, context);
         }
 
         template <typename Point, typename NumberComparisonPolicy>
         typename bsp_detail::square_type<typename arithmetic_type_of<Point>::type>::type get_min_distance_sqrd_to_solid(const Point& p, std::size_t& simplexIndex, const NumberComparisonPolicy& cmp) const
         {
-            return get_min_distance_sqrd_to_solid_impl(p, simplexIndex, cmp);
+            query_context context;
+            return get_min_distance_sqrd_to_solid_impl(p, simplexIndex, cmp, context);
+        }
+
+        template <typename Point, typename NumberComparisonPolicy>
+        typename bsp_detail::square_type<typename arithmetic_type_of<Point>::type>::type get_min_distance_sqrd_to_solid(const Point& p, std::size_t& simplexIndex, const NumberComparisonPolicy& cmp, query_context& context) const
+        {
+            return get_min_distance_sqrd_to_solid_impl(p, simplexIndex, cmp, context);
         }
 
         //! Currently supports points and segments.
         template <typename T, typename NumberComparisonPolicy>
         typename arithmetic_type_of<T>::type get_min_distance_to_solid(const T& p, std::size_t& simplexIndex, const NumberComparisonPolicy& cmp) const
+        {
+            query_context context;
+            return get_min_distance_to_solid(p, simplexIndex, cmp, context);
+        }
+
+        template <typename T, typename NumberComparisonPolicy>
+        typename arithmetic_type_of<T>::type get_min_distance_to_solid(const T& p, std::size_t& simplexIndex, const NumberComparisonPolicy& cmp, query_context& context) const
         {
 			static_assert( is_point<T>::value || is_segment<T>::value, "solid_leaf_bsp_tree::get_min_distance_to_solid supports points or segments." );
             using std::sqrt;
-            return sqrt(get_min_distance_sqrd_to_solid_impl(p, simplexIndex, cmp));
+            return sqrt(get_min_distance_sqrd_to_solid_impl(p, simplexIndex, cmp, context));
         }
 
     private:
 
-        index_type create_leaf(bool isSolid)
+        //! The nodes of a tree or of a subtree built concurrently with its sibling. Children precede their parents.
+        struct subtree_nodes
         {
-            index_type id = static_cast<index_type>(m_front.size());
-            m_front.push_back(undefined_index::value);
-            m_back.push_back(undefined_index::value);
-            m_node_planes.push_back(undefined_index::value);
-            m_in_solid.push_back(isSolid ? point_in_solid_classification::in_solid : point_in_solid_classification::in_empty_space);
-            m_indices.resize(m_indices.size() + 1);
-            return id;
-        }
+            index_type create_leaf(index_vector&& sIndices, bool isSolid)
+            {
+                index_type id = static_cast<index_type>(front.size());
+                front.push_back(undefined_index::value);
+                back.push_back(undefined_index::value);
+                node_planes.push_back(undefined_index::value);
+                in_solid.push_back(isSolid ? point_in_solid_classification::in_solid : point_in_solid_classification::in_empty_space);
+                indices.emplace_back(std::move(sIndices));
+                return id;
+            }
 
-        index_type create_leaf(index_vector&& sIndices, bool isSolid)
-        {
-            index_type id = static_cast<index_type>(m_front.size());
-            m_front.push_back(undefined_index::value);
-            m_back.push_back(undefined_index::value);
-            m_node_planes.push_back(undefined_index::value);
-            m_in_solid.push_back(isSolid ? point_in_solid_classification::in_solid : point_in_solid_classification::in_empty_space);
-            m_indices.emplace_back(std::forward<index_vector>(sIndices));
-            return id;
-        }
+            index_type create_node(index_type sIndex, index_vector&& sIndices, index_type f, index_type b)
+            {
+                index_type id = static_cast<index_type>(front.size());
+                front.push_back(f);
+                back.push_back(b);
+                node_planes.push_back(sIndex);
+                in_solid.push_back(point_in_solid_classification::in_empty_space);
+                indices.emplace_back(std::move(sIndices));
+                return id;
+            }
 
-        index_type create_node(index_type sIndex, index_vector&& sIndices, index_type f, index_type b)
+            //! Append the nodes of other offsetting their child links and return the offset root of other.
+            index_type splice(subtree_nodes&& other, index_type root)
+            {
+                auto offset = static_cast<index_type>(front.size());
+                auto link = [offset](index_type n) { return n != undefined_index::value ? n + offset : n; };
+                for (std::size_t i = 0; i < other.front.size(); ++i)
+                {
+                    front.push_back(link(other.front[i]));
+                    back.push_back(link(other.back[i]));
+                }
+                node_planes.insert(node_planes.end(), other.node_planes.begin(), other.node_planes.end());
+                in_solid.insert(in_solid.end(), other.in_solid.begin(), other.in_solid.end());
+                std::move(other.indices.begin(), other.indices.end(), std::back_inserter(indices));
+                return link(root);
+            }
+
+            index_vector                               front;
+            index_vector                               back;
+            index_vector                               node_planes;
+            std::vector<point_in_solid_classification> in_solid;
+            std::vector<index_vector>                  indices;
+        };
+
+        //! Buffers released by finished levels of the build for reuse by the levels below them.
+        template <typename Item>
+        struct build_scratch
         {
-            index_type id = static_cast<index_type>(m_front.size());
-            m_front.push_back(f);
-            m_back.push_back(b);
-            m_node_planes.push_back(sIndex);
-            m_in_solid.push_back(point_in_solid_classification::in_empty_space);
-            m_indices.emplace_back(std::forward<index_vector>(sIndices));
-            return id;
-        }
+            template <typename T>
+            static T acquire(std::vector<T>& pool)
+            {
+                if (pool.empty())
+                    return T();
+                T r = std::move(pool.back());
+                pool.pop_back();
+                r.clear();
+                return r;
+            }
+
+            std::vector<std::vector<Item>>       items;
+            std::vector<boost::dynamic_bitset<>> bits;
+            std::vector<index_vector>            indices;
+        };
 
-        template <typename Simplices, typename SimplexSelector, typename SimplexExtractor, typename NumberComparisonPolicy>
-        BOOST_FORCEINLINE index_type build_root(const Simplices& simplices, boost::dynamic_bitset<>&& usedBits, index_vector&& sIndices, const SimplexSelector& selector, const SimplexExtractor& extract, const NumberComparisonPolicy& cmp)
+        //! Compute the bounds of the simplices under each node. Children are created before their parents so one pass in order suffices.
+        void compute_bounds()
         {
-            return build_tree<node_orientation::root>(simplices, std::forward<boost::dynamic_bitset<>>(usedBits), std::forward<index_vector>(sIndices), selector, extract, cmp);
+            point_type lo, hi;
+            for (std::size_t i = 0; i < dimension_of<point_type>::value; ++i)
+            {
+                lo[i] = constants::infinity<length_type>();
+                hi[i] = -constants::infinity<length_type>();
+            }
+            m_bounds.assign(m_front.size(), aabb_type(lo, hi));
+            for (index_type node = 0; node < m_front.size(); ++node)
+            {
+                aabb_type& box = m_bounds[node];
+                for (auto idx : m_indices[node])
+                    box.expand(bsp_detail::simplex_bounds<aabb_type>(m_simplices[idx]));
+                if (m_front[node] != undefined_index::value)
+                    box.expand(m_bounds[m_front[node]]);
+                if (m_back[node] != undefined_index::value)
+                    box.expand(m_bounds[m_back[node]]);
+            }
         }
 
-        //! Constructs BSP tree from an input vector of simplices.
-        template <node_orientation Side, typename Simplices, typename SimplexSelector, typename SimplexExtractor, typename NumberComparisonPolicy>
-        index_type build_tree(const Simplices& simplices, boost::dynamic_bitset<>&& usedBits, index_vector&& sIndices, const SimplexSelector& selector, const SimplexExtractor& extract, const NumberComparisonPolicy& cmp)
+        template <typename Simplices, typename SimplexSelector, typename SimplexExtractor, typename NumberComparisonPolicy, typename Executor>
+        void build(const Simplices& pgons, const SimplexSelector& selector, const NumberComparisonPolicy& cmp, const SimplexExtractor& extract, Executor& executor, std::size_t parallelThreshold)
         {
             BOOST_CONCEPT_ASSERT((boost::RandomAccessRangeConcept<Simplices>));
             using item_t = typename boost::range_value<Simplices>::type;
 
-            //! Return empty node if there are no simplices
-            if (boost::empty(simplices))
-                return create_leaf(Side == traits_type::solid_side);
+            for (const auto& pgon : pgons)
+            {
+                auto smplx = extract(pgon);
+                m_simplices.emplace_back(smplx);
+                m_planes.emplace_back(make_hyperplane(smplx));
+            }
+
+            subtree_nodes nodes;
+            build_scratch<item_t> scratch;
+            m_root = build_tree<node_orientation::root>(std::vector<item_t>(boost::begin(pgons), boost::end(pgons)), boost::dynamic_bitset<>(boost::size(pgons)), make_index_range(index_vector(boost::size(pgons))), selector, extract, cmp, nodes, scratch, executor, parallelThreshold);
+            m_front = std::move(nodes.front);
+            m_back = std::move(nodes.back);
+            m_node_planes = std::move(nodes.node_planes);
+            m_in_solid = std::move(nodes.in_solid);
+            m_indices = std::move(nodes.indices);
+            compute_bounds();
+        }
 
-            // Get number of simplices in the input vector
-            //auto nSimplices = boost::size(simplices);
+        //! Constructs BSP tree from an input vector of simplices.
+        //! The subtrees of nodes over more than parallelThreshold simplices are built concurrently and spliced so that the result is the same as the serial build.
+        template <node_orientation Side, typename Item, typename SimplexSelector, typename SimplexExtractor, typename NumberComparisonPolicy, typename Executor>
+        index_type build_tree(std::vector<Item>&& simplices, boost::dynamic_bitset<>&& usedBits, index_vector&& sIndices, const SimplexSelector& selector, const SimplexExtractor& extract, const NumberComparisonPolicy& cmp, subtree_nodes& nodes, build_scratch<Item>& scratch, Executor& executor, std::size_t parallelThreshold)
+        {
+            //! Return empty node if there are no simplices
+            if (simplices.empty())
+            {
+                scratch.items.push_back(std::move(simplices));
+                return nodes.create_leaf(index_vector(), Side == traits_type::solid_side);
+            }
 
             //! Select best possible partitioning plane based on the input geometry
             auto selected = selector(simplices, usedBits);
@@ -433,21 +619,24 @@ namespace geometrix {
             //! to the front list, back list, or both, as appropriate
             if (selected == simplices.end())
             {
-                return create_leaf(std::move(sIndices), Side == traits_type::solid_side);
+                scratch.items.push_back(std::move(simplices));
+                scratch.bits.push_back(std::move(usedBits));
+                return nodes.create_leaf(std::move(sIndices), Side == traits_type::solid_side);
             }
 
-            auto sIndex = sIndices[std::distance(boost::begin(simplices), selected)];
+            auto sIndex = sIndices[std::distance(simplices.begin(), selected)];
             auto splitPlane = m_planes[sIndex];
-            std::vector<item_t> frontList, backList;
-            boost::dynamic_bitset<> frontBits, backBits;
-            index_vector frontIndices, backIndices, coplanarIndices;
+            auto frontList = scratch.acquire(scratch.items), backList = scratch.acquire(scratch.items);
+            auto frontBits = scratch.acquire(scratch.bits), backBits = scratch.acquire(scratch.bits);
+            auto frontIndices = scratch.acquire(scratch.indices), backIndices = scratch.acquire(scratch.indices);
+            index_vector coplanarIndices;
             std::size_t i = 0;
-            auto add_to_front = [&i, &frontList, &frontBits, &usedBits, &frontIndices, &sIndices](const item_t& item) -> void {
+            auto add_to_front = [&i, &frontList, &frontBits, &usedBits, &frontIndices, &sIndices](const Item& item) -> void {
                 frontList.push_back(item);
                 frontBits.push_back(usedBits[i]);
                 frontIndices.push_back(sIndices[i]);
             };
-            auto add_to_back = [&i, &backList, &backBits, &usedBits, &backIndices, &sIndices](const item_t& item) -> void {
+            auto add_to_back = [&i, &backList, &backBits, &usedBits, &backIndices, &sIndices](const Item& item) -> void {
                 backList.push_back(item);
                 backBits.push_back(usedBits[i]);
                 backIndices.push_back(sIndices[i]);
@@ -503,11 +692,33 @@ namespace geometrix {
                 ++i;
             }
 
+            //! This level's buffers are no longer needed and may be reused by the levels below.
+            std::size_t n = simplices.size();
+            scratch.items.push_back(std::move(simplices));
+            scratch.bits.push_back(std::move(usedBits));
+            scratch.indices.push_back(std::move(sIndices));
+
             //! Recursively build child subtrees and return new tree root combining them
-            auto fNode = build_tree<node_orientation::front>(frontList, std::move(frontBits), std::move(frontIndices), selector, extract, cmp);
-            auto bNode = build_tree<node_orientation::back>(backList, std::move(backBits), std::move(backIndices), selector, extract, cmp);
+            index_type fNode, bNode;
+            if (n > parallelThreshold)
+            {
+                subtree_nodes backNodes;
+                fork_join(executor
+                  , [&]() 
+                    {
+                        build_scratch<Item> backScratch;
+                        bNode = build_tree<node_orientation::back>(std::move(backList), std::move(backBits), std::move(backIndices), selector, extract, cmp, backNodes, backScratch, executor, parallelThreshold);
+                    }
+                  , [&]() { fNode = build_tree<node_orientation::front>(std::move(frontList), std::move(frontBits), std::move(frontIndices), selector, extract, cmp, nodes, scratch, executor, parallelThreshold); });
+                bNode = nodes.splice(std::move(backNodes), bNode);
+            }
+            else
+            {
+                fNode = build_tree<node_orientation::front>(std::move(frontList), std::move(frontBits), std::move(frontIndices), selector, extract, cmp, nodes, scratch, executor, parallelThreshold);
+                bNode = build_tree<node_orientation::back>(std::move(backList), std::move(backBits), std::move(backIndices), selector, extract, cmp, nodes, scratch, executor, parallelThreshold);
+            }
 
-            return create_node(sIndex, /*std::move(coplanar),*/ std::move(coplanarIndices), fNode, bNode);
+            return nodes.create_node(sIndex, std::move(coplanarIndices), fNode, bNode);
         }
 
         const plane_type& get_plane(index_type node) const 
@@ -563,8 +774,20 @@ namespace geometrix {
             return in_solid_classification(node);
         }
 
+        template <typename Point, typename std::enable_if<is_point<Point>::value, int>::type = 0>
+        typename bsp_detail::square_type<length_type>::type bounds_distance_sqrd(const Point& p, index_type node) const
+        {
+            return point_aabb_distance_sqrd(p, m_bounds[node]);
+        }
+
+        template <typename Segment, typename std::enable_if<is_segment<Segment>::value, int>::type = 0>
+        typename bsp_detail::square_type<length_type>::type bounds_distance_sqrd(const Segment& s, index_type node) const
+        {
+            return aabb_aabb_distance_sqrd(bsp_detail::simplex_bounds<aabb_type>(s), m_bounds[node]);
+        }
+
         template <typename T, typename NumberComparisonPolicy>
-        typename bsp_detail::square_type<typename arithmetic_type_of<T>::type>::type get_min_distance_sqrd_to_solid_impl(const T& p, std::size_t& closestSimplex, const NumberComparisonPolicy& cmp) const
+        typename bsp_detail::square_type<typename arithmetic_type_of<T>::type>::type get_min_distance_sqrd_to_solid_impl(const T& p, std::size_t& closestSimplex, const NumberComparisonPolicy& cmp, query_context& context) const
         {
             using length_t = typename arithmetic_type_of<T>::type;
             using area_t = decltype(std::declval<length_t>()*std::declval<length_t>());
@@ -580,33 +803,35 @@ namespace geometrix {
                 return plane_orientation::straddling_plane;
             };
 
-            std::stack<index_type> nodeStack;
-            nodeStack.push(m_root);
+            //! Ties are broken by the lower simplex index so that the result does not depend on the order of traversal.
+            auto update_closest = [&minDist2, &closestSimplex](area_t d2, index_type idx)
+            {
+                if (d2 < minDist2 || (d2 == minDist2 && idx < closestSimplex))
+                {
+                    closestSimplex = idx;
+                    minDist2 = d2;
+                }
+            };
+
+            auto& nodeStack = context.m_nodes;
+            nodeStack.clear();
+            if (m_root != undefined_index::value)
+                nodeStack.push_back(m_root);
             while (!nodeStack.empty())
             {
-                auto node = nodeStack.top();
-                nodeStack.pop();
+                auto node = nodeStack.back();
+                nodeStack.pop_back();
+
+                //! Skip subtrees whose simplices all lie farther than the closest found so far.
+                if (bounds_distance_sqrd(p, node) > minDist2)
+                    continue;
 
                 for(auto idx : m_indices[node])
                 {
 					if constexpr( is_point<T>::value )
-					{
-						auto d2 = bsp_detail::point_simplex_distance_squared( p, m_simplices[idx], cmp );
-						if( d2 < minDist2 )
-						{
-							closestSimplex = idx;
-							minDist2 = d2;
-						}
-					}
+						update_closest( bsp_detail::point_simplex_distance_squared( p, m_simplices[idx], cmp ), idx );
 					if constexpr( is_segment<T>::value )
-					{
-						auto d2 = bsp_detail::segment_simplex_distance_squared( p, m_simplices[idx], cmp );
-						if( d2 < minDist2 )
-						{
-							closestSimplex = idx;
-							minDist2 = d2;
-						}
-					}
+						update_closest( bsp_detail::segment_simplex_distance_squared( p, m_simplices[idx], cmp ), idx );
                 }
 
                 if(!is_leaf(node))
@@ -615,30 +840,12 @@ namespace geometrix {
 					if constexpr( is_point<T>::value )
 					{
 						auto dist = scalar_projection(as_vector(p), get_normal_vector(node)) - get_distance_to_origin(node);
-						auto dist2 = dist * dist;
-						auto orientation = calc_orientation(dist);
-
-						//! back
-						if (dist2 < minDist2 || orientation != plane_orientation::in_front_of_plane )
-							nodeStack.push(m_back[node]);
-
-						//! front
-						if (dist2 < minDist2 || orientation != plane_orientation::in_back_of_plane )
-							nodeStack.push(m_front[node]);
+						push_children(node, dist * dist < minDist2, calc_orientation(dist), nodeStack);
 					}
 					if constexpr( is_segment<T>::value )
 					{
 						auto dist = signed_segment_plane_distance( p, get_plane( node ) );
-						auto dist2 = dist * dist;
-						auto orientation = calc_orientation( dist );
-
-						//! back
-						if( dist2 < minDist2 || orientation != plane_orientation::in_front_of_plane )
-							nodeStack.push( m_back[node] );
-
-						//! front
-						if( dist2 < minDist2 || orientation != plane_orientation::in_back_of_plane )
-							nodeStack.push( m_front[node] );
+						push_children( node, dist * dist < minDist2, calc_orientation( dist ), nodeStack );
 					}
                 }
             }
@@ -646,6 +853,128 @@ namespace geometrix {
             return minDist2;
         }
 
+        //! Push the children of node which may hold a closer simplex. The side of the query is pushed last so it is searched first.
+        void push_children(index_type node, bool planeIsCloser, plane_orientation orientation, std::vector<index_type>& nodeStack) const
+        {
+            bool back = planeIsCloser || orientation != plane_orientation::in_front_of_plane;
+            bool front = planeIsCloser || orientation != plane_orientation::in_back_of_plane;
+            if (orientation == plane_orientation::in_back_of_plane)
+            {
+                if (front)
+                    nodeStack.push_back(m_front[node]);
+                if (back)
+                    nodeStack.push_back(m_back[node]);
+            }
+            else
+            {
+                if (back)
+                    nodeStack.push_back(m_back[node]);
+                if (front)
+                    nodeStack.push_back(m_front[node]);
+            }
+        }
+
+        //! Classify points[first, last) a packet at a time. When consecutive points mostly take the same path the branches of the
+        //! scalar traversal are predicted and it is faster than splitting packets. Long runs of points with the same classification
+        //! are taken as a sign of such coherence, so each packet is classified by the method suited to the runs of the one before it.
+        template <typename RandomAccessPointIterator, typename RandomAccessIterator, typename NumberComparisonPolicy>
+        void point_in_solid_space_range(RandomAccessPointIterator points, std::size_t first, std::size_t last, RandomAccessIterator out, const NumberComparisonPolicy& cmp, query_context& context) const
+        {
+            bool usePackets = false;
+            for (std::size_t i = first; i < last; i += default_packet_size)
+            {
+                std::size_t end = (std::min)(last, i + std::size_t(default_packet_size));
+                std::size_t runs = usePackets ? point_in_solid_space_packet(points, i, end, out, cmp, context) : point_in_solid_space_sequence(points, i, end, out, cmp);
+                usePackets = 4 * runs > end - i;
+            }
+        }
+
+        //! Classify points[first, last) in order by the scalar traversal. Returns the number of runs of points with the same classification.
+        template <typename RandomAccessPointIterator, typename RandomAccessIterator, typename NumberComparisonPolicy>
+        std::size_t point_in_solid_space_sequence(RandomAccessPointIterator points, std::size_t first, std::size_t last, RandomAccessIterator out, const NumberComparisonPolicy& cmp) const
+        {
+            std::size_t runs = 0;
+            auto previous = point_in_solid_classification::on_boundary;
+            for (auto i = first; i < last; ++i)
+            {
+                auto c = point_in_solid_space(m_root, points[i], cmp);
+                out[i] = c;
+                runs += c != previous;
+                previous = c;
+            }
+
+            return runs;
+        }
+
+        //! Classify points[first, last) by moving the packet down the tree. At each node the points are split into those in front
+        //! of the plane and those in back in one branch free pass from one index buffer into the other. Points on the plane are
+        //! finished by the scalar traversal from that node so that the results match it exactly. Returns the number of runs of
+        //! points with the same classification.
+        template <typename RandomAccessPointIterator, typename RandomAccessIterator, typename NumberComparisonPolicy>
+        std::size_t point_in_solid_space_packet(RandomAccessPointIterator points, std::size_t first, std::size_t last, RandomAccessIterator out, const NumberComparisonPolicy& cmp, query_context& context) const
+        {
+            std::size_t n = last - first;
+            context.m_points.resize(4 * n);
+            auto* buffers = context.m_points.data();
+            auto* onPlane = buffers + 2 * n;
+            auto* classes = buffers + 3 * n;//! the classification of each point.
+            std::iota(buffers, buffers + n, first);
+            auto& packets = context.m_packets;
+            packets.clear();
+            packets.push_back(packet_stack_item{ m_root, 0, n, 0 });
+            while (!packets.empty())
+            {
+                auto item = packets.back();
+                packets.pop_back();
+                const auto* src = buffers + item.buffer * n;
+                if (is_leaf(item.node))
+                {
+                    auto c = in_solid_classification(item.node);
+                    for (auto i = item.first; i < item.last; ++i)
+                    {
+                        out[src[i]] = c;
+                        classes[src[i] - first] = static_cast<std::size_t>(c);
+                    }
+                    continue;
+                }
+
+                auto* dst = buffers + (1 - item.buffer) * n;
+                auto normal = get_normal_vector(item.node);
+                auto d = get_distance_to_origin(item.node);
+                std::size_t front = item.first, back = item.last, on = 0;
+                for (auto i = item.first; i < item.last; ++i)
+                {
+                    auto index = src[i];
+                    auto dist = scalar_projection(as_vector(points[index]), normal) - d;
+                    auto zero = constants::zero<typename std::decay<decltype(dist)>::type>();
+                    bool isFront = cmp.greater_than(dist, zero);
+                    bool isBack = cmp.less_than(dist, zero);
+                    dst[front] = index;
+                    dst[back - 1] = index;
+                    onPlane[on] = index;
+                    front += isFront;
+                    back -= isBack;
+                    on += !(isFront || isBack);
+                }
+
+                for (std::size_t i = 0; i < on; ++i)
+                {
+                    auto c = point_in_solid_space(item.node, points[onPlane[i]], cmp);
+                    out[onPlane[i]] = c;
+                    classes[onPlane[i] - first] = static_cast<std::size_t>(c);
+                }
+                if (back != item.last)
+                    packets.push_back(packet_stack_item{ m_back[item.node], back, item.last, 1 - item.buffer });
+                if (item.first != front)
+                    packets.push_back(packet_stack_item{ m_front[item.node], item.first, front, 1 - item.buffer });
+            }
+
+            std::size_t runs = 1;
+            for (std::size_t i = 1; i < n; ++i)
+                runs += classes[i] != classes[i - 1];
+            return runs;
+        }
+
         template <typename Point, typename NumberComparisonPolicy>
         point_in_solid_classification point_in_solid_space_no_boundary(index_type node, const Point& p, const NumberComparisonPolicy& cmp) const
         {
@@ -662,6 +991,13 @@ namespace geometrix {
             return in_solid_classification(node);
         }
 
+        //! The simplices coplanar with the plane of node or none if node is undefined.
+        const index_vector& plane_simplices(index_type node) const
+        {
+            static const index_vector none;
+            return node != undefined_index::value ? m_indices[node] : none;
+        }
+
         template <typename Point, typename Vector, typename Indices, typename NumberComparisonPolicy>
         index_type find_closest_hit(const Point& p, const Vector& d, const Indices& sIndices, const NumberComparisonPolicy& cmp) const
         {
@@ -670,7 +1006,7 @@ namespace geometrix {
             index_type minIndex = undefined_index::value;
             for (auto i : sIndices)
             {
-                if (bsp_detail::ray_simplex_intersect(p, d, m_simplices[i], t, cmp) && t < minDist)
+                if (bsp_detail::ray_simplex_intersect(p, d, m_simplices[i], t, cmp) && (t < minDist || (t == minDist && i < minIndex)))
                 {
                     minDist = t;
                     minIndex = i;
@@ -683,17 +1019,17 @@ namespace geometrix {
         //! Intersect ray/segment R(t)=p+t*d, tmin <= t <= tmax, against bsp tree
         //! ’node’, returning distance along the ray thit of first intersection with a solid leaf, if any
         template <typename Point, typename Vector, typename NumberComparisonPolicy>
-        solid_bsp_ray_tracing_result<typename arithmetic_type_of<Point>::type> ray_intersection_impl(const Point& p, const Vector& d, bool onlyBorder, const NumberComparisonPolicy& cmp) const
+        solid_bsp_ray_tracing_result<typename arithmetic_type_of<Point>::type> ray_intersection_impl(const Point& p, const Vector& d, bool onlyBorder, const NumberComparisonPolicy& cmp, query_context& context) const
         {
             using length_t = typename arithmetic_type_of<Point>::type;
             auto tmax = (std::numeric_limits<length_t>::max)();
             auto tmin = constants::zero<length_t>();
 
-            using elem_t = std::tuple<index_type, length_t, std::set<index_type>/*, std::vector<simplex_type>*/>;
-            std::stack<elem_t> nodeStack;
+            auto& nodeStack = context.m_rays;
+            nodeStack.clear();
             auto node = m_root;
-            std::set<index_type> maxIndices, minIndices;
-            //std::vector<simplex_type> maxS, minS;
+            //! The nodes whose planes bound the current interval of the ray at tmin and tmax. Their coplanar simplices are the candidates for the hit.
+            index_type minPlane = undefined_index::value, maxPlane = undefined_index::value;
             while (1)
             {
                 if (!is_leaf(node))
@@ -713,11 +1049,8 @@ namespace geometrix {
                             {
                                 //! Straddling, push far side onto stack,then visit near side
                                 auto farNode = (1 ^ nearIndex) ? m_back[node] : m_front[node];
-                                nodeStack.push(std::make_tuple(farNode, tmax, std::move(maxIndices)/*, std::move(maxS)*/));
-
-                                maxIndices.insert(m_indices[node].begin(), m_indices[node].end());
-                                //using boost::adaptors::transformed;
-                                //boost::copy(node->indices | transformed([this](index_type i) { return m_simplices[i]; }), std::back_inserter(maxS));
+                                nodeStack.push_back(ray_stack_item{ farNode, tmax, maxPlane });
+                                maxPlane = node;
                                 tmax = t;
                             }
                             else
@@ -732,13 +1065,13 @@ namespace geometrix {
                     if (is_solid(node))
                     {
                         //! Look at geometry in sIndices and find the closest hit.
-						if (!minIndices.empty() || !onlyBorder)
+						if (!plane_simplices(minPlane).empty() || !onlyBorder)
 						{
-							auto sIndex = find_closest_hit(p, d, minIndices, cmp);
+							auto sIndex = find_closest_hit(p, d, plane_simplices(minPlane), cmp);
 							return solid_bsp_ray_tracing_result<length_t>(true, tmin, sIndex);
 						}
 
-						auto sIndex = find_closest_hit(p, d, maxIndices, cmp);
+						auto sIndex = find_closest_hit(p, d, plane_simplices(maxPlane), cmp);
 						return solid_bsp_ray_tracing_result<length_t>(true, tmax, sIndex);
                     }
 
@@ -746,10 +1079,11 @@ namespace geometrix {
                     if (nodeStack.empty())
                         break;
                     tmin = tmax;
-                    minIndices = std::move(maxIndices);
-                    //minS = maxS;
-                    std::tie(node, tmax, maxIndices/*, maxS*/) = nodeStack.top();
-                    nodeStack.pop();
+                    minPlane = maxPlane;
+                    node = nodeStack.back().node;
+                    tmax = nodeStack.back().tmax;
+                    maxPlane = nodeStack.back().plane_node;
+                    nodeStack.pop_back();
                 }
 
                 GEOMETRIX_ASSERT(node != undefined_index::value);
@@ -771,6 +1105,7 @@ namespace geometrix {
         std::vector<index_vector> m_indices;
         std::vector<simplex_type> m_simplices;
         std::vector<plane_type>   m_planes;
+        std::vector<aabb_type>    m_bounds;//! the bounds of the simplices under each node.
         index_type                m_root{ undefined_index::value };
     };
 
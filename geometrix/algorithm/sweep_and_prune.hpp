@@ -0,0 +1,571 @@
+//
+//! Copyright © 2026
+//! Brandon Kohn
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+#ifndef GEOMETRIX_SWEEP_AND_PRUNE_HPP
+#define GEOMETRIX_SWEEP_AND_PRUNE_HPP
+#pragma once
+
+#include <geometrix/algorithm/broad_phase_pair.hpp>
+#include <geometrix/primitive/axis_aligned_bounding_box.hpp>
+#include <geometrix/utility/assert.hpp>
+#include <geometrix/utility/prefetch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace geometrix {
+
+    //! \brief An incremental sweep and prune broad phase over axis aligned boxes.
+
+    //! The bounds of the proxies are kept as sorted arrays of endpoints on each axis. Changes made by insert, update and remove
+    //! are deferred until sweep which restores the order of the endpoints by insertion sort. When motion is coherent between
+    //! calls the arrays are nearly sorted so a sweep costs time linear in the number of proxies plus the number of endpoints
+    //! which pass each other. Each endpoint which passes another may start or end an overlap between two proxies so the
+    //! overlapping pairs are maintained from those swaps and the changes are reported as events. Each endpoint carries the
+    //! extent swept by its proxy on the other axes since the last sweep so that the swaps which cannot change an overlap are
+    //! rejected without leaving the array. Each proxy keeps the list of proxies which it overlaps so that a removed proxy ends
+    //! its pairs without a search. The endpoints of inserted proxies are merged into the arrays after the sort and their pairs
+    //! found by a scan of the first axis. Bulk insertions and removals are handled by sorting from scratch instead.
+    //! \code
+    //! sweep_and_prune<point2> sap;
+    //! auto id = sap.insert(make_aabb<point2>(s), index);
+    //! sap.update(id, make_aabb<point2>(moved));
+    //! std::vector<broad_phase_pair> added, removed;
+    //! sap.sweep(added, removed);
+    //! \endcode
+    template <typename Point, typename T = std::size_t>
+    class sweep_and_prune
+    {
+    public:
+
+        using value_type = T;
+        using point_type = Point;
+        using box_type = axis_aligned_bounding_box<Point>;
+        using length_type = typename arithmetic_type_of<Point>::type;
+        using proxy_id = std::uint32_t;
+
+        BOOST_STATIC_CONSTANT(std::size_t, dimension = dimension_of<Point>::value);
+        BOOST_STATIC_CONSTANT(std::size_t, default_rebuild_threshold = 64);
+
+        //! Construct an empty broad phase. A sweep after more than rebuildThreshold insertions and removals sorts the endpoints
+        //! from scratch and finds the pairs by a single sweep along the first axis rather than merging the new endpoints.
+        explicit sweep_and_prune(std::size_t rebuildThreshold = default_rebuild_threshold)
+            : m_rebuildThreshold(rebuildThreshold)
+        {}
+
+        //! The number of proxies including those inserted or removed since the last sweep.
+        std::size_t size() const { return m_size; }
+        bool        empty() const { return m_size == 0; }
+
+        //! Insert a proxy with bounds box carrying value. Returns the id of the proxy. Its overlaps are reported by the next sweep.
+        proxy_id insert(const box_type& box, const T& value)
+        {
+            proxy_id id;
+            if (m_free.empty())
+            {
+                id = static_cast<proxy_id>(m_proxies.size());
+                m_proxies.emplace_back(value);
+                m_stamps.push_back(m_sweeps);
+                for (std::size_t axis = 0; axis < dimension; ++axis)
+                {
+                    m_extents[axis].emplace_back();
+                    m_swept[axis].emplace_back();
+                }
+            }
+            else
+            {
+                id = m_free.back();
+                m_free.pop_back();
+                m_proxies[id].value = value;
+                m_proxies[id].alive = true;
+                m_stamps[id] = m_sweeps;
+            }
+
+            auto b = make_bounds(box);
+            for (std::size_t axis = 0; axis < dimension; ++axis)
+            {
+                m_extents[axis][id] = b[axis];
+                m_swept[axis][id] = b[axis];
+            }
+            m_inserted.push_back(id);
+            ++m_size;
+            ++m_changes;
+            return id;
+        }
+
+        //! Move the proxy id to bounds box. The change is reported by the next sweep.
+        void update(proxy_id id, const box_type& box)
+        {
+            GEOMETRIX_ASSERT(id < m_proxies.size() && m_proxies[id].alive);
+            set_bounds(id, make_bounds(box));
+        }
+
+        //! Remove the proxy id. The end of its overlaps is reported by the next sweep after which the id may be reused.
+        void remove(proxy_id id)
+        {
+            GEOMETRIX_ASSERT(id < m_proxies.size() && m_proxies[id].alive);
+            m_proxies[id].alive = false;
+            for (std::size_t axis = 0; axis < dimension; ++axis)
+                m_extents[axis][id] = removed_extent();
+            m_removed.push_back(id);
+            --m_size;
+            ++m_changes;
+        }
+
+        //! The bounds of the proxy id which must not have been removed.
+        box_type        get_bounds(proxy_id id) const { GEOMETRIX_ASSERT(id < m_proxies.size() && m_proxies[id].alive); return make_box(id, std::make_index_sequence<dimension>()); }
+        const T&        get_value(proxy_id id) const { GEOMETRIX_ASSERT(id < m_proxies.size()); return m_proxies[id].value; }
+        T&              get_value(proxy_id id) { GEOMETRIX_ASSERT(id < m_proxies.size()); return m_proxies[id].value; }
+
+        //! Sort the endpoints to the current bounds and report the sorted pairs of proxies which began and ceased to overlap since the last sweep.
+        void sweep(std::vector<broad_phase_pair>& added, std::vector<broad_phase_pair>& removed)
+        {
+            added.clear();
+            removed.clear();
+
+            //! Proxies removed since their insertion have no endpoints to merge.
+            m_inserted.erase(std::remove_if(m_inserted.begin(), m_inserted.end(), [this](proxy_id id) { return !m_proxies[id].alive; }), m_inserted.end());
+            end_removed_pairs(removed);
+            if (m_changes > m_rebuildThreshold)
+                rebuild(added, removed);
+            else
+            {
+                for (std::size_t axis = 0; axis < dimension; ++axis)
+                    sort_axis(axis, added, removed);
+                merge_inserted(added);
+            }
+            m_free.insert(m_free.end(), m_removed.begin(), m_removed.end());
+            m_removed.clear();
+            m_inserted.clear();
+            m_changes = 0;
+            ++m_sweeps;
+
+            std::sort(added.begin(), added.end());
+            std::sort(removed.begin(), removed.end());
+        }
+
+        //! Sort the endpoints to the current bounds discarding the events.
+        void sweep()
+        {
+            std::vector<broad_phase_pair> added, removed;
+            sweep(added, removed);
+        }
+
+        //! The number of overlapping pairs as of the last sweep.
+        std::size_t number_of_pairs() const { return m_numberOfPairs; }
+
+        //! Whether the proxies a and b overlapped as of the last sweep.
+        bool is_overlapping(proxy_id a, proxy_id b) const
+        {
+            GEOMETRIX_ASSERT(a < m_proxies.size());
+            const std::vector<proxy_id>& partners = m_proxies[a].partners;
+            return std::find(partners.begin(), partners.end(), b) != partners.end();
+        }
+
+        //! Get the sorted pairs of proxies which overlapped as of the last sweep.
+        void get_overlapping_pairs(std::vector<broad_phase_pair>& pairs) const
+        {
+            pairs.clear();
+            pairs.reserve(m_numberOfPairs);
+            for (std::size_t id = 0; id < m_proxies.size(); ++id)
+                for (proxy_id other : m_proxies[id].partners)
+                    if (id < other)
+                        pairs.emplace_back(static_cast<proxy_id>(id), other);
+            std::sort(pairs.begin(), pairs.end());
+        }
+
+        std::vector<broad_phase_pair> get_overlapping_pairs() const
+        {
+            std::vector<broad_phase_pair> pairs;
+            get_overlapping_pairs(pairs);
+            return pairs;
+        }
+
+    private:
+
+        struct proxy
+        {
+            explicit proxy(const T& value)
+                : value(value)
+            {}
+
+            T                     value;
+            bool                  alive{ true };
+            std::vector<proxy_id> partners;
+        };
+
+        //! The bounds of the proxies are kept apart from the proxies and by axis so that the sweep touches as little memory as
+        //! possible. Boxes are not kept at all as the bounds hold them.
+        struct interval
+        {
+            length_type lo() const { return ends[0]; }
+            length_type hi() const { return ends[1]; }
+
+            //! Indexed by whether the end is the maximum so that an endpoint reads its value without a branch which would fail
+            //! half the time.
+            std::array<length_type, 2> ends;
+        };
+
+        using bounds = std::array<interval, dimension>;
+
+        template <std::size_t... I>
+        static bounds make_bounds(const box_type& box, std::index_sequence<I...>)
+        {
+            return bounds{ { interval{ { { get<I>(box.get_lower_bound()), get<I>(box.get_upper_bound()) } } }... } };
+        }
+
+        static bounds make_bounds(const box_type& box)
+        {
+            return make_bounds(box, std::make_index_sequence<dimension>());
+        }
+
+        template <std::size_t... I>
+        box_type make_box(proxy_id id, std::index_sequence<I...>) const
+        {
+            return box_type(construct<point_type>(m_extents[I][id].lo()...), construct<point_type>(m_extents[I][id].hi()...));
+        }
+
+        //! Removed proxies are given an empty extent which marks their endpoints to be dropped by the next sweep.
+        static interval removed_extent()
+        {
+            return interval{ { { constants::infinity<length_type>(), constants::negative_infinity<length_type>() } } };
+        }
+
+        static bool is_removed(const interval& x) { return x.hi() < x.lo(); }
+
+        //! Set the bounds of the proxy id widening the extent which it has swept since the last sweep. The first change after a
+        //! sweep starts the swept extent from the bounds as of that sweep. A proxy which is not changed keeps a swept extent
+        //! which is wider than needed but still holds its bounds.
+        void set_bounds(proxy_id id, const bounds& b)
+        {
+            bool first = m_stamps[id] != m_sweeps;
+            m_stamps[id] = m_sweeps;
+            for (std::size_t axis = 0; axis < dimension; ++axis)
+            {
+                interval& extent = m_extents[axis][id];
+                interval& swept = m_swept[axis][id];
+                if (first)
+                    swept = extent;
+                swept.ends[0] = (std::min)(swept.lo(), b[axis].lo());
+                swept.ends[1] = (std::max)(swept.hi(), b[axis].hi());
+                extent = b[axis];
+            }
+        }
+
+        using other_coordinates = std::array<length_type, dimension - 1>;
+
+        struct endpoint
+        {
+            length_type       value;
+            proxy_id          id;
+            bool              is_max;
+            other_coordinates swept_lo;
+            other_coordinates swept_hi;
+
+            //! Minimum endpoints precede maximum endpoints at equal values so that touching boxes overlap.
+            bool operator <(const endpoint& rhs) const { return value < rhs.value || (!(rhs.value < value) && !is_max && rhs.is_max); }
+        };
+
+        //! Whether passing b by a may start or end an overlap. Proxies which begin to overlap do so at their current bounds and
+        //! proxies which cease to do so overlapped at their bounds as of the last sweep so both lie within the swept extents.
+        //! Nearly every crossing fails one of the tests at random so they are combined without branching.
+        static bool may_overlap(const endpoint& a, const endpoint& b)
+        {
+            bool result = (a.is_max != b.is_max) & (a.id != b.id);
+            for (std::size_t k = 0; k + 1 < dimension; ++k)
+                result &= (b.swept_lo[k] <= a.swept_hi[k]) & (a.swept_lo[k] <= b.swept_hi[k]);
+            return result;
+        }
+
+        bool overlaps(proxy_id a, proxy_id b) const
+        {
+            for (std::size_t axis = 0; axis < dimension; ++axis)
+            {
+                const interval& x = m_extents[axis][a];
+                const interval& y = m_extents[axis][b];
+                if (x.hi() < y.lo() || y.hi() < x.lo())
+                    return false;
+            }
+            return true;
+        }
+
+        //! Record that a and b overlap. Returns false if they already did.
+        bool link(proxy_id a, proxy_id b)
+        {
+            std::vector<proxy_id>& partners = m_proxies[a].partners;
+            if (std::find(partners.begin(), partners.end(), b) != partners.end())
+                return false;
+            partners.push_back(b);
+            m_proxies[b].partners.push_back(a);
+            ++m_numberOfPairs;
+            return true;
+        }
+
+        //! Record that a and b no longer overlap. Returns false if they did not.
+        bool unlink(proxy_id a, proxy_id b)
+        {
+            if (!erase_partner(a, b))
+                return false;
+            erase_partner(b, a);
+            --m_numberOfPairs;
+            return true;
+        }
+
+        bool erase_partner(proxy_id a, proxy_id b)
+        {
+            std::vector<proxy_id>& partners = m_proxies[a].partners;
+            auto it = std::find(partners.begin(), partners.end(), b);
+            if (it == partners.end())
+                return false;
+            *it = partners.back();
+            partners.pop_back();
+            return true;
+        }
+
+        //! Report and drop the pairs of the removed proxies including those between two removed proxies.
+        void end_removed_pairs(std::vector<broad_phase_pair>& removed)
+        {
+            for (proxy_id id : m_removed)
+            {
+                std::vector<proxy_id>& partners = m_proxies[id].partners;
+                for (proxy_id other : partners)
+                {
+                    erase_partner(other, id);
+                    removed.emplace_back(id, other);
+                }
+                m_numberOfPairs -= partners.size();
+                partners.clear();
+            }
+        }
+
+        //! Reads the bounds of the proxies on one axis into its endpoints.
+        class refresher
+        {
+        public:
+
+            refresher(const sweep_and_prune& sap, std::size_t axis)
+                : m_extents(sap.m_extents[axis].data())
+            {
+                for (std::size_t k = 0, other = 0; other < dimension; ++other)
+                    if (other != axis)
+                        m_swept[k++] = sap.m_swept[other].data();
+            }
+
+            //! Returns false if the proxy of e has been removed.
+            bool operator()(endpoint& e) const
+            {
+                const interval& x = m_extents[e.id];
+                if (is_removed(x))
+                    return false;
+                e.value = x.ends[e.is_max];
+                for (std::size_t k = 0; k + 1 < dimension; ++k)
+                {
+                    e.swept_lo[k] = m_swept[k][e.id].lo();
+                    e.swept_hi[k] = m_swept[k][e.id].hi();
+                }
+                return true;
+            }
+
+            //! Forced inline as the compiler may otherwise find that a call has no effect and drop it.
+            BOOST_FORCEINLINE void prefetch(const endpoint& e) const
+            {
+                geometrix::prefetch(m_extents + e.id);
+                for (std::size_t k = 0; k + 1 < dimension; ++k)
+                    geometrix::prefetch(m_swept[k] + e.id);
+            }
+
+        private:
+
+            const interval*                            m_extents;
+            std::array<const interval*, dimension - 1> m_swept;
+
+        };
+
+        //! Append the endpoints on one axis of the inserted proxies to endpoints.
+        void append_inserted(std::size_t axis, std::vector<endpoint>& endpoints) const
+        {
+            refresher refresh(*this, axis);
+            for (proxy_id id : m_inserted)
+            {
+                endpoint lo{ length_type(), id, false, {}, {} }, hi{ length_type(), id, true, {}, {} };
+                refresh(lo);
+                refresh(hi);
+                endpoints.push_back(lo);
+                endpoints.push_back(hi);
+            }
+        }
+
+        //! Merge the endpoints of the inserted proxies into the sorted arrays and add their pairs. A proxy which overlaps an
+        //! inserted one on the first axis has its minimum at or below the maximum of the inserted one and no further below its
+        //! minimum than the widest extent on that axis so only the endpoints between those values are tested.
+        void merge_inserted(std::vector<broad_phase_pair>& added)
+        {
+            if (m_inserted.empty())
+                return;
+
+            //! The merge runs from the back so that each endpoint is moved at most once.
+            std::vector<endpoint> inserted;
+            for (std::size_t axis = 0; axis < dimension; ++axis)
+            {
+                inserted.clear();
+                append_inserted(axis, inserted);
+                std::sort(inserted.begin(), inserted.end());
+
+                std::vector<endpoint>& endpoints = m_endpoints[axis];
+                auto size = static_cast<std::ptrdiff_t>(endpoints.size());
+                endpoints.resize(endpoints.size() + inserted.size());
+                auto first = endpoints.begin(), last = first + size, out = endpoints.end();
+                for (auto it = inserted.rbegin(); it != inserted.rend(); ++it)
+                {
+                    auto pos = std::upper_bound(first, last, *it);
+                    out = std::move_backward(pos, last, out);
+                    *--out = *it;
+                    last = pos;
+                }
+            }
+
+            //! Removed proxies have a negative width.
+            length_type widest = constants::zero<length_type>();
+            for (const interval& x : m_extents[0])
+                widest = (std::max)(widest, x.hi() - x.lo());
+
+            const std::vector<endpoint>& endpoints = m_endpoints[0];
+            for (proxy_id id : m_inserted)
+            {
+                const interval& x = m_extents[0][id];
+                auto it = std::lower_bound(endpoints.begin(), endpoints.end(), x.lo() - widest, [](const endpoint& e, const length_type& v) { return e.value < v; });
+                for (; it != endpoints.end() && !(x.hi() < it->value); ++it)
+                    if (!it->is_max && it->id != id && overlaps(id, it->id) && link(id, it->id))
+                        added.emplace_back(id, it->id);
+            }
+        }
+
+        //! Refresh the endpoints of one axis dropping those of removed proxies.
+        void refresh_axis(std::size_t axis)
+        {
+            refresher refresh(*this, axis);
+            std::vector<endpoint>& endpoints = m_endpoints[axis];
+            std::size_t size = 0;
+            for (endpoint e : endpoints)
+                if (refresh(e))
+                    endpoints[size++] = e;
+            endpoints.resize(size);
+        }
+
+        //! Sort all endpoints and find the overlapping pairs by sweeping the first axis. The events are the difference from the
+        //! previous pairs.
+        void rebuild(std::vector<broad_phase_pair>& added, std::vector<broad_phase_pair>& removed)
+        {
+            for (std::size_t axis = 0; axis < dimension; ++axis)
+            {
+                append_inserted(axis, m_endpoints[axis]);
+                refresh_axis(axis);
+                std::sort(m_endpoints[axis].begin(), m_endpoints[axis].end());
+            }
+
+            std::vector<broad_phase_pair> pairs;
+            std::vector<proxy_id> active;
+            std::vector<std::size_t> slot(m_proxies.size());
+            for (const endpoint& e : m_endpoints[0])
+            {
+                if (!e.is_max)
+                {
+                    for (proxy_id a : active)
+                        if (overlaps(a, e.id))
+                            pairs.emplace_back(a, e.id);
+                    slot[e.id] = active.size();
+                    active.push_back(e.id);
+                }
+                else
+                {
+                    std::size_t i = slot[e.id];
+                    active[i] = active.back();
+                    slot[active[i]] = i;
+                    active.pop_back();
+                }
+            }
+            std::sort(pairs.begin(), pairs.end());
+
+            std::vector<broad_phase_pair> previous;
+            get_overlapping_pairs(previous);
+            std::size_t nRemoved = removed.size(), nAdded = added.size();
+            std::set_difference(previous.begin(), previous.end(), pairs.begin(), pairs.end(), std::back_inserter(removed));
+            std::set_difference(pairs.begin(), pairs.end(), previous.begin(), previous.end(), std::back_inserter(added));
+            for (std::size_t i = nRemoved; i < removed.size(); ++i)
+                unlink(removed[i].first, removed[i].second);
+            for (std::size_t i = nAdded; i < added.size(); ++i)
+                link(added[i].first, added[i].second);
+        }
+
+        //! Refresh and sort the endpoints of one axis in a single pass dropping those of removed proxies. The sort never looks
+        //! past the endpoint which it is placing so each is refreshed as it is reached while the bounds of those further on are
+        //! prefetched.
+        void sort_axis(std::size_t axis, std::vector<broad_phase_pair>& added, std::vector<broad_phase_pair>& removed)
+        {
+            const std::size_t prefetch_distance = 32;
+            refresher refresh(*this, axis);
+            std::vector<endpoint>& endpoints = m_endpoints[axis];
+
+            std::size_t size = 0;
+            for (std::size_t i = 0, n = endpoints.size(); i < n; ++i)
+            {
+                if (i + prefetch_distance < n)
+                    refresh.prefetch(endpoints[i + prefetch_distance]);
+
+                endpoint e = endpoints[i];
+                if (!refresh(e))
+                    continue;
+
+                std::size_t j = size++;
+                for (; j > 0 && e < endpoints[j - 1]; --j)
+                {
+                    const endpoint& f = endpoints[j - 1];
+                    if (may_overlap(e, f))
+                    {
+                        if (!e.is_max)
+                        {
+                            //! A minimum moved below a maximum so the proxies now overlap on this axis.
+                            if (overlaps(e.id, f.id) && link(e.id, f.id))
+                                added.emplace_back(e.id, f.id);
+                        }
+                        else if (unlink(e.id, f.id))
+                        {
+                            //! A maximum moved below a minimum so the proxies are separated on this axis.
+                            removed.emplace_back(e.id, f.id);
+                        }
+                    }
+                    endpoints[j] = f;
+                }
+                endpoints[j] = e;
+            }
+            endpoints.resize(size);
+        }
+
+        std::array<std::vector<endpoint>, dimension> m_endpoints;
+        std::array<std::vector<interval>, dimension> m_extents;
+        std::array<std::vector<interval>, dimension> m_swept;
+        std::vector<std::uint32_t>                   m_stamps;
+        std::vector<proxy>                           m_proxies;
+        std::vector<proxy_id>                        m_free;
+        std::vector<proxy_id>                        m_inserted;
+        std::vector<proxy_id>                        m_removed;
+        std::size_t                                  m_numberOfPairs{ 0 };
+        std::size_t                                  m_size{ 0 };
+        std::size_t                                  m_changes{ 0 };
+        std::uint32_t                                m_sweeps{ 0 };
+        std::size_t                                  m_rebuildThreshold;
+
+    };
+
+}//namespace geometrix;
+
+#endif //! GEOMETRIX_SWEEP_AND_PRUNE_HPP
@@ -12,6 +12,8 @@
 #pragma once
 
 #include <geometrix/algorithm/mesh_2d.hpp>
+#include <geometrix/algorithm/mesh_search_context.hpp>
+#include <geometrix/utility/executor.hpp>
 #include <geometrix/tensor/vector.hpp>
 #include <geometrix/primitive/point.hpp>
 #include <geometrix/primitive/segment.hpp>
@@ -27,6 +29,12 @@
 #include <boost/optional.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/container/flat_set.hpp>
+#include <boost/range/value_type.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <vector>
 
 #define GEOMETRIX_DEBUG_VISIBLE_VERTICES_MESH_SEARCH 0
 
@@ -81,6 +89,16 @@ namespace geometrix {
 			vector_t    hi;
 		};
 		typedef mesh_search_item edge_item;
+		using context_type = mesh_search_context<edge_item>;
+
+		//! Search using context for the visited set and the found vertices. The context is reset for the search. Pass context.get_queue()
+		//! to mesh_2d::search to reuse its traversal stack as well. The vertices are then available from both the search and the context.
+		visible_vertices_mesh_search( const point_t& origin, std::size_t start, const mesh_t& mesh, context_type& context )
+			: visible_vertices_mesh_search( origin, start, mesh )
+		{
+			m_context = &context;
+			context.reset( mesh.get_number_triangles() );
+		}
 
 		edge_item get_start()
 		{
@@ -93,11 +111,12 @@ namespace geometrix {
 			bool allAround = get<0>( item.lo ) == constants::infinity<coordinate_type>() && get<0>( item.hi ) == constants::negative_infinity<coordinate_type>();
 
 			const auto& toIndices = m_mesh.get_triangle_indices( item.to );
+			auto&       vertices = get_vertex_buffer();
 			if( allAround )
 			{
-				m_vertices.push_back( toIndices[0] );
-				m_vertices.push_back( toIndices[1] );
-				m_vertices.push_back( toIndices[2] );
+				vertices.push_back( toIndices[0] );
+				vertices.push_back( toIndices[1] );
+				vertices.push_back( toIndices[2] );
 			}
 			else
 			{
@@ -111,7 +130,7 @@ namespace geometrix {
 					const auto& point = m_mesh.get_triangle_vertices( item.to )[i];
 					vector_t    vPoint = point - m_origin;
 					if( is_vector_between( item.lo, item.hi, vPoint, true, cmp ) )
-						m_vertices.push_back( toIndices[i] );
+						vertices.push_back( toIndices[i] );
 				}
 			}
 
@@ -175,6 +194,9 @@ namespace geometrix {
 			segment2 nHi{ m_origin, m_origin + vecHi };
 #endif
 			auto nItem = edge_item( item.to, next, vecLo, vecHi );
+			if( m_context )
+				return m_context->insert( nItem ) ? boost::make_optional( nItem ) : boost::none;
+
 			auto it = visited.lower_bound( nItem );
 			if( it != visited.end() && !visited.key_comp()( nItem, *it ) )
 			{
@@ -185,17 +207,107 @@ namespace geometrix {
 			return nItem;
 		}
 
-		const std::vector<std::size_t>& get_vertices() const { return m_vertices; }
+		const std::vector<std::size_t>& get_vertices() const { return m_context ? m_context->get_vertices() : m_vertices; }
 
 	private:
+		std::vector<std::size_t>& get_vertex_buffer() { return m_context ? m_context->get_vertices() : m_vertices; }
+
 		point_t                                      m_origin;
 		const mesh_t&                                m_mesh;
 		std::size_t                                  m_start;
 		std::vector<std::size_t>                     m_vertices;
 		boost::container::flat_set<mesh_search_item> visited;
 		comparison_policy                            m_cmp;
+		context_type*                                m_context{ nullptr };
 	};
 
+	//! \brief The vertices visible from each origin of a batch in CSR form. The vertices of origin i are vertices[offsets[i], offsets[i + 1]).
+	struct visible_vertices_batch_result
+	{
+		std::vector<std::size_t>   offsets;
+		std::vector<std::uint32_t> vertices;
+
+		//! The number of origins.
+		std::size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+		std::size_t          count( std::size_t origin ) const { return offsets[origin + 1] - offsets[origin]; }
+		const std::uint32_t* begin( std::size_t origin ) const { return vertices.data() + offsets[origin]; }
+		const std::uint32_t* end( std::size_t origin ) const { return vertices.data() + offsets[origin + 1]; }
+	};
+
+	namespace detail {
+		template <typename Mesh, typename Points, typename NumberComparisonPolicy, typename Executor>
+		inline visible_vertices_batch_result visible_vertices_batch_search( const Mesh& mesh, const Points& origins, const NumberComparisonPolicy& cmp, Executor& executor, std::size_t grainSize )
+		{
+			using point_t = typename boost::range_value<Points>::type;
+			using traits_t = visible_vertices_mesh_search_traits<typename arithmetic_type_of<point_t>::type, Mesh, NumberComparisonPolicy>;
+			using search_t = visible_vertices_mesh_search<traits_t>;
+
+			auto        first = std::begin( origins );
+			std::size_t n = static_cast<std::size_t>( std::distance( first, std::end( origins ) ) );
+			GEOMETRIX_ASSERT( mesh.get_number_vertices() < ( std::numeric_limits<std::uint32_t>::max )() );
+
+			visible_vertices_batch_result result;
+			result.offsets.assign( n + 1, 0 );
+			if( n == 0 )
+				return result;
+
+			if( grainSize == 0 )
+				grainSize = default_grain_size( n );
+			grainSize = ( std::min )( grainSize, n );
+
+			//! Each chunk of origins searches with its own context and collects its vertices in a private buffer. The buffers are
+			//! then copied in order into the result.
+			std::vector<std::vector<std::uint32_t>> chunkVertices( ( n + grainSize - 1 ) / grainSize );
+			parallel_for( executor, n, grainSize, [&]( std::size_t i, std::size_t last )
+			{
+				typename search_t::context_type context;
+				auto&                           vertices = chunkVertices[i / grainSize];
+				for( ; i < last; ++i )
+				{
+					auto triangle = mesh.find_triangle( first[i], cmp );
+					if( !triangle )
+						continue;
+
+					search_t search( first[i], *triangle, mesh, context );
+					mesh.search( search, context.get_queue() );
+					vertices.insert( vertices.end(), context.get_vertices().begin(), context.get_vertices().end() );
+					result.offsets[i + 1] = context.get_vertices().size();
+				}
+			} );
+
+			for( std::size_t i = 0; i < n; ++i )
+				result.offsets[i + 1] += result.offsets[i];
+
+			result.vertices.resize( result.offsets.back() );
+			parallel_for( executor, chunkVertices.size(), 1, [&]( std::size_t c, std::size_t last )
+			{
+				for( ; c < last; ++c )
+					std::copy( chunkVertices[c].begin(), chunkVertices[c].end(), result.vertices.begin() + result.offsets[c * grainSize] );
+			} );
+
+			return result;
+		}
+	}//! namespace detail;
+
+	//! Find the vertices of mesh visible from each of the origins. The search for each origin starts at the triangle found by
+	//! mesh.find_triangle( origin, cmp ). Origins outside the mesh see no vertices. The vertices of each origin are in the order
+	//! found by a visible_vertices_mesh_search.
+	template <typename Mesh, typename Points, typename NumberComparisonPolicy>
+	inline visible_vertices_batch_result visible_vertices_batch_search( const Mesh& mesh, const Points& origins, const NumberComparisonPolicy& cmp )
+	{
+		serial_executor executor;
+		return detail::visible_vertices_batch_search( mesh, origins, cmp, executor, ( std::numeric_limits<std::size_t>::max )() );
+	}
+
+	//! Search from chunks of grainSize origins (0 chooses a default) concurrently on the executor. Each chunk reuses one
+	//! mesh_search_context for its searches. The mesh must not be modified during the call. The result is identical to the serial version.
+	template <typename Mesh, typename Points, typename NumberComparisonPolicy, typename Executor, typename std::enable_if<is_executor<typename std::decay<Executor>::type>::value, int>::type = 0>
+	inline visible_vertices_batch_result visible_vertices_batch_search( const Mesh& mesh, const Points& origins, const NumberComparisonPolicy& cmp, Executor&& executor, std::size_t grainSize = 0 )
+	{
+		return detail::visible_vertices_batch_search( mesh, origins, cmp, executor, grainSize );
+	}
+
 } // namespace geometrix
 
 #endif // GEOMETRIX_VISIBLE_VERTICES_MESH_SEARCH_HPP
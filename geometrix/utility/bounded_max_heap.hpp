@@ -0,0 +1,107 @@
+//
+//! Copyright © 2026
+//! Brandon Kohn
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+#ifndef GEOMETRIX_UTILITY_BOUNDED_MAX_HEAP_HPP
+#define GEOMETRIX_UTILITY_BOUNDED_MAX_HEAP_HPP
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace geometrix {
+
+    //! \brief A max heap which retains at most capacity items with the smallest keys.
+    //! Used to accumulate the k best candidates of a branch and bound search where the largest retained key is the pruning bound.
+    template <typename Key, typename Value, typename Compare = std::less<Key>>
+    class bounded_max_heap
+    {
+    public:
+
+        using key_type = Key;
+        using value_type = Value;
+        using item_type = std::pair<Key, Value>;
+
+        //! The items are not reserved up front so that a capacity larger than the number of candidates, such as the maximum of
+        //! std::size_t to retain all of them, allocates only for the items pushed.
+        explicit bounded_max_heap(std::size_t capacity, const Compare& cmp = Compare())
+            : m_capacity(capacity)
+            , m_cmp(cmp)
+        {}
+
+        std::size_t size() const { return m_items.size(); }
+        std::size_t capacity() const { return m_capacity; }
+        bool empty() const { return m_items.empty(); }
+        bool full() const { return m_items.size() >= m_capacity; }
+
+        //! The largest retained key. Precondition: !empty().
+        const key_type& top_key() const { return m_items.front().first; }
+
+        //! Returns true if an item with the specified key would be retained.
+        bool accepts(const key_type& k) const
+        {
+            if (!full())
+                return true;
+            return m_capacity != 0 && m_cmp(k, top_key());
+        }
+
+        //! Add an item if it is among the best found so far. Returns true if the item was retained.
+        bool push(const key_type& k, const value_type& v)
+        {
+            if (!accepts(k))
+                return false;
+
+            if (full())
+            {
+                std::pop_heap(m_items.begin(), m_items.end(), item_compare(m_cmp));
+                m_items.pop_back();
+            }
+
+            m_items.emplace_back(k, v);
+            std::push_heap(m_items.begin(), m_items.end(), item_compare(m_cmp));
+            return true;
+        }
+
+        void clear() { m_items.clear(); }
+
+        //! Sort the items in ascending key order. The heap is left empty.
+        std::vector<item_type> release_sorted()
+        {
+            std::sort_heap(m_items.begin(), m_items.end(), item_compare(m_cmp));
+            std::vector<item_type> result;
+            result.swap(m_items);
+            return result;
+        }
+
+    private:
+
+        struct item_compare
+        {
+            item_compare(const Compare& cmp)
+                : m_cmp(cmp)
+            {}
+
+            bool operator()(const item_type& lhs, const item_type& rhs) const
+            {
+                return m_cmp(lhs.first, rhs.first);
+            }
+
+            const Compare& m_cmp;
+        };
+
+        std::vector<item_type> m_items;
+        std::size_t            m_capacity;
+        Compare                m_cmp;
+
+    };
+
+}//namespace geometrix;
+
+#endif//! GEOMETRIX_UTILITY_BOUNDED_MAX_HEAP_HPP
@@ -0,0 +1,174 @@
+//
+//! Copyright © 2026
+//! Brandon Kohn
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+#ifndef GEOMETRIX_UTILITY_EXECUTOR_HPP
+#define GEOMETRIX_UTILITY_EXECUTOR_HPP
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//! std::execution policies may be passed to the parallel algorithms in place of an executor when <execution> is available.
+//! Including <execution> may require linking the standard library's parallel backend (e.g. TBB with libstdc++), so policies
+//! are only supported when GEOMETRIX_USE_STD_EXECUTION_POLICIES is defined.
+#if defined(GEOMETRIX_USE_STD_EXECUTION_POLICIES)
+#include <execution>
+#if defined(__cpp_lib_execution)
+#define GEOMETRIX_HAS_EXECUTION_POLICIES
+#endif
+#endif
+
+//! Executors are the extension point used by the parallel algorithms in geometrix to schedule work.
+//! An executor is any object e for which e.submit(fn) schedules the nullary callable fn and returns a
+//! std::future<void> which becomes ready when fn completes (propagating any exception thrown by fn).
+//! A thread pool may be adapted by wrapping its enqueue operation in a std::packaged_task.
+//!
+//! Algorithms block on the returned futures from the calling thread. When the calling thread is itself a worker of the
+//! same pool, the pool must be able to make progress on queued tasks while a worker waits (e.g. by having more workers than
+//! nested waits or by running tasks inline on wait).
+namespace geometrix {
+
+    //! Runs submitted tasks immediately on the calling thread.
+    struct serial_executor
+    {
+        template <typename Fn>
+        std::future<void> submit(Fn&& fn) const
+        {
+            std::packaged_task<void()> task(std::forward<Fn>(fn));
+            auto result = task.get_future();
+            task();
+            return result;
+        }
+    };
+
+    //! Runs each submitted task on a new thread via std::async.
+    struct async_executor
+    {
+        template <typename Fn>
+        std::future<void> submit(Fn&& fn) const
+        {
+            return std::async(std::launch::async, std::forward<Fn>(fn));
+        }
+    };
+
+    template <typename T, typename EnableIf = void>
+    struct is_executor : std::false_type {};
+
+    template <typename T>
+    struct is_executor<T, decltype((void)std::declval<T&>().submit(std::declval<void(*)()>()))> : std::true_type {};
+
+#if defined(GEOMETRIX_HAS_EXECUTION_POLICIES)
+    template <typename T>
+    struct is_execution_policy : std::is_execution_policy<T> {};
+
+    //! Map a standard execution policy onto an executor. Sequenced execution runs inline; other policies run concurrently.
+    inline serial_executor make_policy_executor(const std::execution::sequenced_policy&)
+    {
+        return serial_executor();
+    }
+
+    template <typename ExecutionPolicy>
+    inline async_executor make_policy_executor(const ExecutionPolicy&, typename std::enable_if<is_execution_policy<ExecutionPolicy>::value>::type* = nullptr)
+    {
+        return async_executor();
+    }
+#else
+    template <typename T>
+    struct is_execution_policy : std::false_type {};
+#endif
+
+    //! The number of hardware threads or 1 if it cannot be determined.
+    inline std::size_t hardware_concurrency()
+    {
+        return (std::max)(std::thread::hardware_concurrency(), 1u);
+    }
+
+    //! Wait on all futures and rethrow the first exception encountered.
+    inline void wait_all(std::vector<std::future<void>>& futures)
+    {
+        std::exception_ptr pError;
+        for (auto& f : futures)
+        {
+            try
+            {
+                f.get();
+            }
+            catch (...)
+            {
+                if (!pError)
+                    pError = std::current_exception();
+            }
+        }
+
+        futures.clear();
+        if (pError)
+            std::rethrow_exception(pError);
+    }
+
+    //! Run a on the executor and b on the calling thread and wait for both.
+    template <typename Executor, typename Fn1, typename Fn2>
+    inline void fork_join(Executor& executor, Fn1&& a, Fn2&& b)
+    {
+        std::vector<std::future<void>> futures;
+        futures.emplace_back(executor.submit(std::forward<Fn1>(a)));
+        try
+        {
+            b();
+        }
+        catch (...)
+        {
+            futures.front().wait();
+            throw;
+        }
+        wait_all(futures);
+    }
+
+    //! Invoke fn(first, last) over consecutive sub-ranges of [0, n) holding at most grainSize items.
+    //! All chunks but the last are submitted to the executor; the last runs on the calling thread. Blocks until all chunks complete.
+    template <typename Executor, typename Fn>
+    inline void parallel_for(Executor& executor, std::size_t n, std::size_t grainSize, Fn&& fn)
+    {
+        grainSize = (std::max)(grainSize, std::size_t(1));
+        std::vector<std::future<void>> futures;
+        futures.reserve(n / grainSize + 1);
+        try
+        {
+            for (std::size_t first = 0; first < n; first += grainSize)
+            {
+                std::size_t last = (std::min)(first + grainSize, n);
+                if (last == n)
+                    fn(first, last);
+                else
+                    futures.emplace_back(executor.submit([&fn, first, last]() { fn(first, last); }));
+            }
+        }
+        catch (...)
+        {
+            for (auto& f : futures)
+                f.wait();
+            throw;
+        }
+
+        wait_all(futures);
+    }
+
+    //! A grain size which divides n items into roughly tasksPerThread tasks for each hardware thread.
+    inline std::size_t default_grain_size(std::size_t n, std::size_t tasksPerThread = 4)
+    {
+        return (std::max)(n / (hardware_concurrency() * tasksPerThread), std::size_t(1));
+    }
+
+}//namespace geometrix;
+
+#endif//! GEOMETRIX_UTILITY_EXECUTOR_HPP
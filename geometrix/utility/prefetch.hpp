@@ -0,0 +1,36 @@
+//
+//! Copyright © 2026
+//! Brandon Kohn
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+#ifndef GEOMETRIX_UTILITY_PREFETCH_HPP
+#define GEOMETRIX_UTILITY_PREFETCH_HPP
+#pragma once
+
+#include <boost/config.hpp>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace geometrix {
+
+    //! Hint that the memory at p will be read soon. This does nothing where the compiler offers no such hint. It must be inlined
+    //! as the compiler may otherwise find that a call has no effect and drop it.
+    BOOST_FORCEINLINE void prefetch(const void* p)
+    {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(p);
+#else
+        (void)p;
+#endif
+    }
+
+}//namespace geometrix;
+
+#endif //! GEOMETRIX_UTILITY_PREFETCH_HPP
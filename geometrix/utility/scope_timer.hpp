@@ -9,12 +9,29 @@
 #ifndef GEOMETRIX_UTILITY_SCOPETIMER_HPP
 #define GEOMETRIX_UTILITY_SCOPETIMER_HPP
 
+#include <boost/config.hpp>
 #include <boost/preprocessor/cat.hpp>
-#include <boost/container/flat_map.hpp>
 
+#include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <cmath>
+#include <iosfwd>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define GEOMETRIX_HAS_RDTSC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define GEOMETRIX_HAS_RDTSC 1
+#endif
 
 #if !defined(GEOMETRIX_DISABLE_SCOPE_TIMERS)
 #define GEOMETRIX_SCOPE_TIMERS_ENABLED 1
@@ -90,54 +107,612 @@ namespace geometrix {
         };
 
 		using call_data = running_stat<std::uint64_t>;
-		class call_map : public boost::container::flat_map<std::string, call_data>
-		{
-		public:
 
-			typedef boost::container::flat_map<std::string, call_data> map_type;
+        //! Index of the most significant set bit of a non-zero value.
+        inline unsigned most_significant_bit(std::uint64_t x)
+        {
+#if defined(_MSC_VER) && defined(_M_X64)
+            unsigned long r;
+            _BitScanReverse64(&r, x);
+            return static_cast<unsigned>(r);
+#elif defined(__GNUC__) || defined(__clang__)
+            return 63u - static_cast<unsigned>(__builtin_clzll(x));
+#else
+            unsigned r = 0;
+            while (x >>= 1)
+                ++r;
+            return r;
+#endif
+        }
+
+        //! Durations are binned in a log-linear histogram with 4 buckets per power of two (a relative bucket width of at most 25%).
+        //! Values below 4ns have their own buckets.
+        static const std::size_t histogram_size = 252;
+
+        inline std::size_t histogram_bucket(std::uint64_t ns)
+        {
+            if (ns < 4)
+                return static_cast<std::size_t>(ns);
+            unsigned msb = most_significant_bit(ns);
+            return (msb - 1) * 4 + static_cast<std::size_t>((ns >> (msb - 2)) & 3);
+        }
+
+        //! The half open range [lower, upper) of durations binned in bucket b.
+        inline std::pair<double, double> histogram_bucket_range(std::size_t b)
+        {
+            if (b < 4)
+                return std::make_pair(static_cast<double>(b), static_cast<double>(b + 1));
+            unsigned msb = static_cast<unsigned>(b / 4 + 1);
+            double width = std::ldexp(1.0, static_cast<int>(msb) - 2);
+            double lower = (4 + b % 4) * width;
+            return std::make_pair(lower, lower + width);
+        }
+
+        //! Statistics for one key recorded by a single thread.
+        //! Only the owning thread writes an entry (with relaxed stores); snapshots read it concurrently, so the fields of
+        //! an entry which is being updated may be observed one sample apart.
+        struct call_entry
+        {
+            call_entry()
+                : name(nullptr)
+                , parent(nullptr)
+                , counts(0)
+                , total(0)
+                , min((std::numeric_limits<std::uint64_t>::max)())
+                , max(0)
+                , mean(0.0)
+                , m2(0.0)
+            {
+                for (auto& h : histogram)
+                    h.store(0, std::memory_order_relaxed);
+            }
+
+            BOOST_FORCEINLINE void push(std::uint64_t ns)
+            {
+                // Welford's update as in running_stat.
+                auto n = counts.load(std::memory_order_relaxed) + 1;
+                double x = static_cast<double>(ns);
+                double oldM = mean.load(std::memory_order_relaxed);
+                double newM = oldM + (x - oldM) / n;
+                m2.store(m2.load(std::memory_order_relaxed) + (x - oldM) * (x - newM), std::memory_order_relaxed);
+                mean.store(newM, std::memory_order_relaxed);
+                total.store(total.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+                if (ns < min.load(std::memory_order_relaxed))
+                    min.store(ns, std::memory_order_relaxed);
+                if (ns > max.load(std::memory_order_relaxed))
+                    max.store(ns, std::memory_order_relaxed);
+                auto& h = histogram[histogram_bucket(ns)];
+                h.store(h.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                counts.store(n, std::memory_order_relaxed);
+            }
+
+            const char*                name;
+            const call_entry*          parent;//! The enclosing scope's node when recording the call tree.
+            std::atomic<std::uint64_t> counts;
+            std::atomic<std::uint64_t> total;
+            std::atomic<std::uint64_t> min;
+            std::atomic<std::uint64_t> max;
+            std::atomic<double>        mean;
+            std::atomic<double>        m2;
+            std::atomic<std::uint64_t> histogram[histogram_size];
+        };
+
+        //! An append-only list of items in fixed size chunks so addresses are stable and the list may be traversed
+        //! from any thread while the owning thread appends.
+        template <typename T, std::size_t ChunkSize>
+        class chunked_list
+        {
+        public:
+
+            struct chunk
+            {
+                chunk()
+                    : size(0)
+                    , next(nullptr)
+                {}
+
+                T                        items[ChunkSize];
+                std::atomic<std::size_t> size;
+                std::atomic<chunk*>      next;
+            };
+
+            chunked_list()
+                : m_first(nullptr)
+                , m_last(nullptr)
+            {}
+
+            ~chunked_list()
+            {
+                chunk* c = m_first.load(std::memory_order_relaxed);
+                while (c)
+                {
+                    chunk* next = c->next.load(std::memory_order_relaxed);
+                    delete c;
+                    c = next;
+                }
+            }
+
+            chunked_list(const chunked_list&) = delete;
+            chunked_list& operator=(const chunked_list&) = delete;
+
+            bool empty() const { return m_first.load(std::memory_order_acquire) == nullptr; }
+
+            //! Reserve the next item for initialization by the owning thread. It is visible to readers after publish().
+            T& next()
+            {
+                if (!m_last || m_last->size.load(std::memory_order_relaxed) == ChunkSize)
+                {
+                    chunk* c = new chunk;
+                    if (m_last)
+                        m_last->next.store(c, std::memory_order_release);
+                    else
+                        m_first.store(c, std::memory_order_release);
+                    m_last = c;
+                }
+
+                return m_last->items[m_last->size.load(std::memory_order_relaxed)];
+            }
+
+            void publish()
+            {
+                m_last->size.store(m_last->size.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            }
+
+            //! Visit each published item. May be called from any thread.
+            template <typename Visitor>
+            void for_each(Visitor&& visitor) const
+            {
+                for (const chunk* c = m_first.load(std::memory_order_acquire); c; c = c->next.load(std::memory_order_acquire))
+                {
+                    std::size_t n = c->size.load(std::memory_order_acquire);
+                    for (std::size_t i = 0; i < n; ++i)
+                        visitor(c->items[i]);
+                }
+            }
+
+        private:
+
+            std::atomic<chunk*> m_first;
+            chunk*              m_last;
+
+        };
+
+        //! The entries recorded by one thread keyed by name and parent node.
+        //! Keys are compared by address; a string literal used from several translation units may have several entries
+        //! which are merged by name in snapshots.
+        class call_entry_table
+        {
+        public:
+
+            call_entry_table()
+                : m_table(16, nullptr)
+                , m_size(0)
+            {}
+
+            BOOST_FORCEINLINE call_entry& find_or_insert(const char* name, const call_entry* parent = nullptr)
+            {
+                std::size_t mask = m_table.size() - 1;
+                std::size_t i = hash(name, parent) & mask;
+                while (call_entry* e = m_table[i])
+                {
+                    if (e->name == name && e->parent == parent)
+                        return *e;
+                    i = (i + 1) & mask;
+                }
+
+                return insert(name, parent, i);
+            }
+
+            template <typename Visitor>
+            void for_each(Visitor&& visitor) const
+            {
+                m_entries.for_each(std::forward<Visitor>(visitor));
+            }
+
+        private:
+
+            static std::size_t hash(const char* name, const call_entry* parent)
+            {
+                auto h = (static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(name)) ^ (static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(parent)) << 1)) * 0x9E3779B97F4A7C15ull;
+                return static_cast<std::size_t>(h ^ (h >> 32));
+            }
+
+            call_entry& insert(const char* name, const call_entry* parent, std::size_t slot)
+            {
+                call_entry& e = m_entries.next();
+                e.name = name;
+                e.parent = parent;
+                m_entries.publish();
+
+                m_table[slot] = &e;
+                if (2 * ++m_size > m_table.size())
+                    rehash();
+                return e;
+            }
+
+            void rehash()
+            {
+                std::vector<call_entry*> table(2 * m_table.size(), nullptr);
+                std::size_t mask = table.size() - 1;
+                for (call_entry* e : m_table)
+                {
+                    if (!e)
+                        continue;
+                    std::size_t i = hash(e->name, e->parent) & mask;
+                    while (table[i])
+                        i = (i + 1) & mask;
+                    table[i] = e;
+                }
+                m_table.swap(table);
+            }
+
+            chunked_list<call_entry, 16> m_entries;
+            std::vector<call_entry*>     m_table;
+            std::size_t                  m_size;
+
+        };
+
+        //! A completed scope recorded for trace export. Times are in nanoseconds.
+        struct trace_event
+        {
+            const char*   name;
+            std::uint64_t start;
+            std::uint64_t duration;
+        };
+
+        //! The call data recorded by one thread.
+        class thread_call_data
+        {
+        public:
+
+            thread_call_data()
+                : m_current(nullptr)
+                , m_id(0)
+            {}
+
+            thread_call_data(const thread_call_data&) = delete;
+            thread_call_data& operator=(const thread_call_data&) = delete;
+
+            //! Flat statistics keyed by name.
+            call_entry_table& flat() { return m_flat; }
+            const call_entry_table& flat() const { return m_flat; }
 
-			static call_map& instance();
-			void write() const;
+            //! Call tree statistics keyed by name and enclosing node.
+            const call_entry_table& tree() const { return m_tree; }
 
-			call_map() {}
-			~call_map();
+            const chunked_list<trace_event, 1024>& events() const { return m_events; }
 
-		};
-	}//! namespace scope_timer_detail
+            std::size_t id() const { return m_id; }
+            void set_id(std::size_t id) { m_id = id; }
 
-	class scope_timer
+            //! Enter the call tree node for name under the current node. Returns the enclosing node.
+            BOOST_FORCEINLINE call_entry* enter(const char* name)
+            {
+                call_entry* parent = m_current;
+                m_current = &m_tree.find_or_insert(name, parent);
+                return parent;
+            }
+
+            //! Record the duration of the current node and restore its parent.
+            BOOST_FORCEINLINE void leave(call_entry* parent, std::uint64_t ns)
+            {
+                m_current->push(ns);
+                m_current = parent;
+            }
+
+            BOOST_FORCEINLINE void record_event(const char* name, std::uint64_t start, std::uint64_t ns)
+            {
+                trace_event& e = m_events.next();
+                e.name = name;
+                e.start = start;
+                e.duration = ns;
+                m_events.publish();
+            }
+
+            //! Map a run-time name onto a stable key. Only the first use of a name on each thread takes a lock.
+            const char* intern(const std::string& name);
+
+        private:
+
+            call_entry_table                             m_flat;
+            call_entry_table                             m_tree;
+            chunked_list<trace_event, 1024>              m_events;
+            call_entry*                                  m_current;
+            std::size_t                                  m_id;
+            std::unordered_map<std::string, const char*> m_interned;
+
+        };
+
+        //! Owns the calling thread's call data and registers it with the call_map for its lifetime.
+        class thread_call_data_handle
+        {
+        public:
+            thread_call_data_handle();
+            ~thread_call_data_handle();
+
+            thread_call_data& get() { return *m_data; }
+
+        private:
+            std::unique_ptr<thread_call_data> m_data;
+        };
+
+        inline thread_call_data& this_thread_call_data()
+        {
+            static thread_local thread_call_data_handle handle;
+            return handle.get();
+        }
+
+        inline std::atomic<unsigned>& scope_timer_features_flags()
+        {
+            static std::atomic<unsigned> flags(0);
+            return flags;
+        }
+    }//! namespace scope_timer_detail
+
+    //! Optional data recorded by scope timers in addition to the flat statistics for each name.
+    enum scope_timer_feature : unsigned
+    {
+        scope_timer_call_tree = 1,   //! Statistics for each path of nested scopes.
+        scope_timer_trace_events = 2 //! Every completed scope for export as a Chrome trace. Memory grows with the number of scopes timed.
+    };
+
+    //! Set the features (a combination of scope_timer_feature flags) used by timers constructed after the call.
+    inline void set_scope_timer_features(unsigned features)
+    {
+        scope_timer_detail::scope_timer_features_flags().store(features, std::memory_order_relaxed);
+    }
+
+    inline unsigned get_scope_timer_features()
+    {
+        return scope_timer_detail::scope_timer_features_flags().load(std::memory_order_relaxed);
+    }
+
+    //! Aggregated timings for one scope name across all threads. Times are in seconds.
+    struct scope_timer_record
+    {
+        std::string                name;
+        std::uint64_t              counts;
+        double                     total_time;
+        double                     mean_time;
+        double                     standard_deviation;
+        double                     min_time;
+        double                     max_time;
+        std::vector<std::uint64_t> histogram;//! Counts binned by scope_timer_detail::histogram_bucket of the duration in nanoseconds.
+
+        //! Estimate the q-th quantile (0 <= q <= 1) of the durations from the histogram.
+        double percentile_time(double q) const
+        {
+            std::uint64_t n = 0;
+            for (auto c : histogram)
+                n += c;
+            if (n == 0)
+                return 0.0;
+
+            double rank = (std::max)(q * n, 1.0);
+            std::uint64_t cumulative = 0;
+            for (std::size_t b = 0; b < histogram.size(); ++b)
+            {
+                if (histogram[b] == 0)
+                    continue;
+                cumulative += histogram[b];
+                if (cumulative >= rank)
+                {
+                    auto range = scope_timer_detail::histogram_bucket_range(b);
+                    double f = (rank - (cumulative - histogram[b])) / histogram[b];
+                    double t = (range.first + f * (range.second - range.first)) * 1.0e-9;
+                    return (std::min)((std::max)(t, min_time), max_time);
+                }
+            }
+
+            return max_time;
+        }
+    };
+
+    //! A node of the call tree. Nodes are in depth first order; parent is the index of the enclosing node or npos for roots.
+    struct scope_timer_call_node
+    {
+        static const std::size_t npos = static_cast<std::size_t>(-1);
+
+        std::size_t        parent;
+        std::size_t        depth;
+        scope_timer_record stats;
+    };
+
+    namespace scope_timer_detail
+    {
+        //! The registry of per-thread call data. Statistics from threads which have exited are merged into the registry.
+        //! Results are written to CSV files (and a Chrome trace when trace events are enabled) at program exit.
+        class call_map
+        {
+        public:
+
+            static call_map& instance();
+
+            //! Write the flat statistics to geometrix_scope_timer_timings_<timestamp>.csv and, when recorded, the call tree
+            //! to geometrix_scope_timer_call_tree_<timestamp>.csv and the trace to geometrix_scope_timer_trace_<timestamp>.json.
+            void write() const;
+            void write(std::ostream& os) const;
+            void write_call_tree(std::ostream& os) const;
+
+            //! Write the recorded trace events in the Chrome trace event format (load with chrome://tracing or Perfetto).
+            void write_chrome_trace(std::ostream& os) const;
+
+            //! Merge the data of all threads by name. May be called while other threads are recording.
+            std::vector<scope_timer_record> snapshot() const;
+            std::vector<scope_timer_call_node> call_tree_snapshot() const;
+
+            void register_thread(thread_call_data* data);
+            void unregister_thread(std::unique_ptr<thread_call_data>& data);
+            const char* intern(const std::string& name);
+
+        private:
+
+            struct impl;
+
+            call_map();
+            ~call_map();
+
+            std::unique_ptr<impl> m_impl;
+
+        };
+
+        inline thread_call_data_handle::thread_call_data_handle()
+            : m_data(new thread_call_data)
+        {
+            call_map::instance().register_thread(m_data.get());
+        }
+
+        inline thread_call_data_handle::~thread_call_data_handle()
+        {
+            call_map::instance().unregister_thread(m_data);
+        }
+
+        inline const char* thread_call_data::intern(const std::string& name)
+        {
+            auto it = m_interned.find(name);
+            if (it != m_interned.end())
+                return it->second;
+            const char* key = call_map::instance().intern(name);
+            m_interned.emplace(name, key);
+            return key;
+        }
+    }//! namespace scope_timer_detail
+
+    //! Clock policy using std::chrono::steady_clock.
+    struct steady_clock_policy
+    {
+        using tick_type = std::uint64_t;
+
+        static tick_type now()
+        {
+            return static_cast<tick_type>(std::chrono::steady_clock::now().time_since_epoch().count());
+        }
+
+        static std::uint64_t to_nanoseconds(tick_type ticks)
+        {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::duration(ticks)).count());
+        }
+    };
+
+#if defined(GEOMETRIX_HAS_RDTSC)
+    //! Clock policy reading the time stamp counter. Requires an invariant TSC (constant rate across cores and power states).
+    //! The tick rate is calibrated against steady_clock on first use.
+    struct rdtsc_clock_policy
+    {
+        using tick_type = std::uint64_t;
+
+        static tick_type now()
+        {
+            return __rdtsc();
+        }
+
+        static std::uint64_t to_nanoseconds(tick_type ticks)
+        {
+            return static_cast<std::uint64_t>(ticks * nanoseconds_per_tick());
+        }
+
+        static double nanoseconds_per_tick()
+        {
+            static const double r = calibrate();
+            return r;
+        }
+
+    private:
+
+        static double calibrate()
+        {
+            using namespace std::chrono;
+            auto t0 = steady_clock::now();
+            auto c0 = __rdtsc();
+            while (steady_clock::now() - t0 < milliseconds(10));
+            auto t1 = steady_clock::now();
+            auto c1 = __rdtsc();
+            return duration<double, std::nano>(t1 - t0).count() / static_cast<double>(c1 - c0);
+        }
+    };
+#endif
+
+#if defined(GEOMETRIX_SCOPE_TIMER_USE_RDTSC) && defined(GEOMETRIX_HAS_RDTSC)
+    using default_scope_timer_clock = rdtsc_clock_policy;
+#else
+    using default_scope_timer_clock = steady_clock_policy;
+#endif
+
+	//! Records the time spent in a scope under a name.
+	//! Timings are accumulated per thread without locking; the first timer on a thread registers the thread.
+	template <typename ClockPolicy>
+	class basic_scope_timer
 	{
 	public:
-		
-		scope_timer(const std::string& functionName)
+
+		//! Key by a string literal (or other string with static storage duration). The key is compared by address so
+		//! nothing is allocated on entry or exit.
+		template <std::size_t N>
+		explicit basic_scope_timer(const char(&functionName)[N])
 			: m_function(functionName)
-            , t2{}
-			, t1(std::chrono::high_resolution_clock::now())
-		{}
+		{
+			start();
+		}
 
-		~scope_timer()
+		//! Key by a run-time string. The name is looked up in a per-thread table on each entry.
+		explicit basic_scope_timer(const std::string& functionName)
+			: m_function(scope_timer_detail::this_thread_call_data().intern(functionName))
 		{
-			using namespace scope_timer_detail;
-			t2 = std::chrono::high_resolution_clock::now();
-			std::uint64_t seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count();
-			call_map& callMap = call_map::instance();
-			callMap[m_function].push(seconds);
+			start();
 		}
 
+		~basic_scope_timer()
+		{
+			auto stop = ClockPolicy::now();
+			auto ns = ClockPolicy::to_nanoseconds(stop - m_start);
+			m_data->flat().find_or_insert(m_function).push(ns);
+			if (m_features & scope_timer_call_tree)
+				m_data->leave(m_parent, ns);
+			if (m_features & scope_timer_trace_events)
+				m_data->record_event(m_function, ClockPolicy::to_nanoseconds(m_start), ns);
+		}
+
+		basic_scope_timer(const basic_scope_timer&) = delete;
+		basic_scope_timer& operator=(const basic_scope_timer&) = delete;
+
 	private:
 
-		std::string m_function;
-		std::chrono::time_point<std::chrono::high_resolution_clock> t2;
-		std::chrono::time_point<std::chrono::high_resolution_clock> t1;
+		BOOST_FORCEINLINE void start()
+		{
+			m_data = &scope_timer_detail::this_thread_call_data();
+			m_features = get_scope_timer_features();
+			m_parent = (m_features & scope_timer_call_tree) ? m_data->enter(m_function) : nullptr;
+			m_start = ClockPolicy::now();
+		}
+
+		const char*                          m_function;
+		scope_timer_detail::thread_call_data* m_data;
+		scope_timer_detail::call_entry*      m_parent;
+		unsigned                             m_features;
+		typename ClockPolicy::tick_type      m_start;
 
 	};
+
+	using scope_timer = basic_scope_timer<default_scope_timer_clock>;
+
+	//! Aggregate the timings recorded so far on all threads, sorted by name.
+	inline std::vector<scope_timer_record> scope_timer_snapshot()
+	{
+		return scope_timer_detail::call_map::instance().snapshot();
+	}
+
+	//! Aggregate the call tree recorded so far on all threads (when scope_timer_call_tree is enabled).
+	inline std::vector<scope_timer_call_node> scope_timer_call_tree_snapshot()
+	{
+		return scope_timer_detail::call_map::instance().call_tree_snapshot();
+	}
 }//! namespace geometrix;
 
 #if( GEOMETRIX_SCOPE_TIMERS_ENABLED )
 #define GEOMETRIX_MEASURE_SCOPE_TIME( function_name ) \
     geometrix::scope_timer BOOST_PP_CAT(scope_timer_instance, __LINE__)( ( function_name ) );
 #else
-#define GEOMETRIX_MEASURE_SCOPE_TIME( function_name ) 
+#define GEOMETRIX_MEASURE_SCOPE_TIME( function_name )
 #endif
 
 #endif // GEOMETRIX_UTILITY_SCOPETIMER_HPP
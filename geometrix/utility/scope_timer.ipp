@@ -9,47 +9,332 @@
 #pragma once
 #include "scope_timer.hpp"
 #include <boost/format.hpp>
+#include <algorithm>
 #include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
 
 namespace geometrix {
 	namespace scope_timer_detail
 	{
+		//! Combines statistics by Chan's parallel form of Welford's algorithm.
+		struct call_accumulator
+		{
+			call_accumulator()
+				: counts(0)
+				, total(0)
+				, min((std::numeric_limits<std::uint64_t>::max)())
+				, max(0)
+				, mean(0.0)
+				, m2(0.0)
+				, histogram(histogram_size, 0)
+			{}
+
+			void merge(const call_entry& e)
+			{
+				auto n = e.counts.load(std::memory_order_relaxed);
+				if (n == 0)
+					return;
+				auto sum = counts + n;
+				double delta = e.mean.load(std::memory_order_relaxed) - mean;
+				mean += delta * n / sum;
+				m2 += e.m2.load(std::memory_order_relaxed) + delta * delta * (static_cast<double>(counts) * n / sum);
+				counts = sum;
+				total += e.total.load(std::memory_order_relaxed);
+				min = (std::min)(min, e.min.load(std::memory_order_relaxed));
+				max = (std::max)(max, e.max.load(std::memory_order_relaxed));
+				for (std::size_t b = 0; b < histogram_size; ++b)
+					histogram[b] += e.histogram[b].load(std::memory_order_relaxed);
+			}
+
+			void merge(const call_accumulator& a)
+			{
+				if (a.counts == 0)
+					return;
+				auto sum = counts + a.counts;
+				double delta = a.mean - mean;
+				mean += delta * a.counts / sum;
+				m2 += a.m2 + delta * delta * (static_cast<double>(counts) * a.counts / sum);
+				counts = sum;
+				total += a.total;
+				min = (std::min)(min, a.min);
+				max = (std::max)(max, a.max);
+				for (std::size_t b = 0; b < histogram_size; ++b)
+					histogram[b] += a.histogram[b];
+			}
+
+			scope_timer_record make_record(const std::string& name) const
+			{
+				const double conv = 1.0e-9;
+				double variance = counts > 1 ? m2 / (counts - 1) : 0.0;
+				return scope_timer_record{ name, counts, total * conv, mean * conv, std::sqrt(variance) * conv, counts ? min * conv : 0.0, max * conv, histogram };
+			}
+
+			std::uint64_t              counts;
+			std::uint64_t              total;
+			std::uint64_t              min;
+			std::uint64_t              max;
+			double                     mean;
+			double                     m2;
+			std::vector<std::uint64_t> histogram;
+		};
+
+		using call_path = std::vector<std::string>;
+
+		//! The names of the scopes enclosing a call tree node from the root down.
+		inline call_path make_call_path(const call_entry& e)
+		{
+			call_path path;
+			for (const call_entry* n = &e; n; n = n->parent)
+				path.emplace_back(n->name);
+			std::reverse(path.begin(), path.end());
+			return path;
+		}
+
+		struct call_map::impl
+		{
+			impl()
+				: next_id(1)
+			{}
+
+			template <typename Visitor>
+			void for_each_thread(Visitor&& visitor) const
+			{
+				for (const thread_call_data* data : threads)
+					visitor(*data);
+			}
+
+			std::mutex                                     mutex;
+			std::vector<thread_call_data*>                 threads;
+			std::map<std::string, call_accumulator>        retired;
+			std::map<call_path, call_accumulator>          retired_tree;
+			std::vector<std::unique_ptr<thread_call_data>> retired_events;
+			std::set<std::string>                          names;
+			std::size_t                                    next_id;
+		};
+
+		//! Writes the results when the program exits.
+		struct call_map_writer
+		{
+			call_map_writer(const call_map& m)
+				: m_map(m)
+			{}
+
+			~call_map_writer()
+			{
+				m_map.write();
+			}
+
+			const call_map& m_map;
+		};
+
 		inline call_map& call_map::instance()
 		{
-			static call_map theMap;
-			return theMap;
+			//! The map is never destroyed so threads which outlive static destruction may still unregister.
+			static call_map* theMap = new call_map;
+			static call_map_writer theWriter(*theMap);
+			return *theMap;
 		}
 
+		inline call_map::call_map()
+			: m_impl(new impl)
+		{}
+
 		inline call_map::~call_map()
+		{}
+
+		inline void call_map::register_thread(thread_call_data* data)
 		{
-			write();
+			std::lock_guard<std::mutex> lk(m_impl->mutex);
+			data->set_id(m_impl->next_id++);
+			m_impl->threads.push_back(data);
 		}
-		
-		inline void call_map::write() const
+
+		inline void call_map::unregister_thread(std::unique_ptr<thread_call_data>& data)
+		{
+			std::lock_guard<std::mutex> lk(m_impl->mutex);
+			data->flat().for_each([this](const call_entry& e)
+			{
+				m_impl->retired[e.name].merge(e);
+			});
+			data->tree().for_each([this](const call_entry& e)
+			{
+				m_impl->retired_tree[make_call_path(e)].merge(e);
+			});
+			m_impl->threads.erase(std::remove(m_impl->threads.begin(), m_impl->threads.end(), data.get()), m_impl->threads.end());
+
+			//! Trace events are kept until exit.
+			if (!data->events().empty())
+				m_impl->retired_events.push_back(std::move(data));
+		}
+
+		inline const char* call_map::intern(const std::string& name)
+		{
+			std::lock_guard<std::mutex> lk(m_impl->mutex);
+			return m_impl->names.insert(name).first->c_str();
+		}
+
+		inline std::vector<scope_timer_record> call_map::snapshot() const
+		{
+			std::map<std::string, call_accumulator> merged;
+			{
+				std::lock_guard<std::mutex> lk(m_impl->mutex);
+				merged = m_impl->retired;
+				m_impl->for_each_thread([&merged](const thread_call_data& data)
+				{
+					data.flat().for_each([&merged](const call_entry& e)
+					{
+						merged[e.name].merge(e);
+					});
+				});
+			}
+
+			std::vector<scope_timer_record> result;
+			result.reserve(merged.size());
+			for (const auto& item : merged)
+			{
+				if (item.second.counts != 0)
+					result.push_back(item.second.make_record(item.first));
+			}
+
+			return result;
+		}
+
+		inline std::vector<scope_timer_call_node> call_map::call_tree_snapshot() const
+		{
+			std::map<call_path, call_accumulator> merged;
+			{
+				std::lock_guard<std::mutex> lk(m_impl->mutex);
+				merged = m_impl->retired_tree;
+				m_impl->for_each_thread([&merged](const thread_call_data& data)
+				{
+					data.tree().for_each([&merged](const call_entry& e)
+					{
+						merged[make_call_path(e)].merge(e);
+					});
+				});
+			}
+
+			//! Paths sort lexicographically so each node follows its parent; a stack of open ancestors gives the parent index.
+			std::vector<scope_timer_call_node> result;
+			result.reserve(merged.size());
+			std::vector<std::size_t> ancestors;
+			for (const auto& item : merged)
+			{
+				const call_path& path = item.first;
+				std::size_t depth = path.size() - 1;
+				ancestors.resize(depth);
+				std::size_t parent = depth > 0 ? ancestors.back() : scope_timer_call_node::npos;
+				ancestors.push_back(result.size());
+				result.push_back(scope_timer_call_node{ parent, depth, item.second.make_record(path.back()) });
+			}
+
+			return result;
+		}
+
+		inline void call_map::write(std::ostream& os) const
+		{
+			os << "Function Name,Counts,Total Time(s),Mean Time(s),Std.Dev(s),Min Time(s),Max Time(s),P50 Time(s),P90 Time(s),P99 Time(s)" << std::endl;
+			for (const auto& item : snapshot())
+				os << "\"" << item.name << "\"," << item.counts << "," << item.total_time << "," << item.mean_time << "," << item.standard_deviation << "," << item.min_time << "," << item.max_time << "," << item.percentile_time(0.5) << "," << item.percentile_time(0.9) << "," << item.percentile_time(0.99) << std::endl;
+		}
+
+		inline void call_map::write_call_tree(std::ostream& os) const
+		{
+			os << "Depth,Call Path,Counts,Total Time(s),Mean Time(s),Std.Dev(s),Min Time(s),Max Time(s),P50 Time(s),P90 Time(s),P99 Time(s),Parent Fraction" << std::endl;
+			auto nodes = call_tree_snapshot();
+			std::vector<std::string> paths(nodes.size());
+			for (std::size_t i = 0; i < nodes.size(); ++i)
+			{
+				const auto& node = nodes[i];
+				const auto& item = node.stats;
+				paths[i] = node.parent != scope_timer_call_node::npos ? paths[node.parent] + "/" + item.name : item.name;
+				double parentFraction = node.parent != scope_timer_call_node::npos && nodes[node.parent].stats.total_time > 0 ? item.total_time / nodes[node.parent].stats.total_time : 1.0;
+				os << node.depth << ",\"" << paths[i] << "\"," << item.counts << "," << item.total_time << "," << item.mean_time << "," << item.standard_deviation << "," << item.min_time << "," << item.max_time << "," << item.percentile_time(0.5) << "," << item.percentile_time(0.9) << "," << item.percentile_time(0.99) << "," << parentFraction << std::endl;
+			}
+		}
+
+		inline void write_json_string(std::ostream& os, const char* s)
 		{
-			if (!empty())
+			os << '"';
+			for (; *s; ++s)
 			{
-			    auto timestamp = std::chrono::system_clock::now().time_since_epoch().count();
-				std::string outputFile = str(boost::format("geometrix_scope_timer_timings_%1%.csv") % timestamp);
-				std::ofstream ofs(outputFile.c_str());
-				ofs << "Function Name,Counts,Total Time(s),Mean Time(s),Std.Dev(s)" << std::endl;
-				
-                const double conv = 1.0e-9;
-				for (const auto& item : *this)
+				switch (*s)
 				{
-                    auto& stat = item.second;
-					auto counts = stat.counts();
-					auto totalTime = stat.sum() * conv;
-					double avgTime = stat.mean() * conv;
-                    double stdDev = stat.standard_deviation() * conv;
-					ofs << "\"" << item.first << "\"," << counts << "," << totalTime << "," << avgTime << "," << stdDev << std::endl;
+				case '"': os << "\\\""; break;
+				case '\\': os << "\\\\"; break;
+				case '\n': os << "\\n"; break;
+				case '\r': os << "\\r"; break;
+				case '\t': os << "\\t"; break;
+				default:
+					if (static_cast<unsigned char>(*s) < 0x20)
+						os << str(boost::format("\\u%04x") % static_cast<int>(*s));
+					else
+						os << *s;
 				}
-				ofs.flush();
-				ofs.close();
+			}
+			os << '"';
+		}
+
+		inline void call_map::write_chrome_trace(std::ostream& os) const
+		{
+			std::lock_guard<std::mutex> lk(m_impl->mutex);
+
+			std::vector<const thread_call_data*> threads(m_impl->threads.begin(), m_impl->threads.end());
+			for (const auto& data : m_impl->retired_events)
+				threads.push_back(data.get());
+
+			//! Timestamps are written relative to the first event in microseconds.
+			std::uint64_t origin = (std::numeric_limits<std::uint64_t>::max)();
+			for (const thread_call_data* data : threads)
+				data->events().for_each([&origin](const trace_event& e) { origin = (std::min)(origin, e.start); });
+
+			os << "{\"traceEvents\":[";
+			bool first = true;
+			for (const thread_call_data* data : threads)
+			{
+				auto tid = data->id();
+				data->events().for_each([&](const trace_event& e)
+				{
+					os << (first ? "\n" : ",\n") << "{\"name\":";
+					write_json_string(os, e.name);
+					os << ",\"cat\":\"geometrix\",\"ph\":\"X\",\"ts\":" << str(boost::format("%.3f") % ((e.start - origin) * 1.0e-3)) << ",\"dur\":" << str(boost::format("%.3f") % (e.duration * 1.0e-3)) << ",\"pid\":1,\"tid\":" << tid << "}";
+					first = false;
+				});
+			}
+			os << "\n],\"displayTimeUnit\":\"ns\"}" << std::endl;
+		}
+
+		inline void call_map::write() const
+		{
+			auto timestamp = std::chrono::system_clock::now().time_since_epoch().count();
+			if (!snapshot().empty())
+			{
+				std::ofstream ofs(str(boost::format("geometrix_scope_timer_timings_%1%.csv") % timestamp).c_str());
+				write(ofs);
+			}
+
+			if (!call_tree_snapshot().empty())
+			{
+				std::ofstream ofs(str(boost::format("geometrix_scope_timer_call_tree_%1%.csv") % timestamp).c_str());
+				write_call_tree(ofs);
+			}
+
+			bool hasEvents = false;
+			{
+				std::lock_guard<std::mutex> lk(m_impl->mutex);
+				hasEvents = !m_impl->retired_events.empty();
+				m_impl->for_each_thread([&hasEvents](const thread_call_data& data) { hasEvents = hasEvents || !data.events().empty(); });
+			}
+
+			if (hasEvents)
+			{
+				std::ofstream ofs(str(boost::format("geometrix_scope_timer_trace_%1%.json") % timestamp).c_str());
+				write_chrome_trace(ofs);
 			}
 		}
 
 	}//! namespace scope_timer_detail;
 }//! namespace geometrix;
 
-
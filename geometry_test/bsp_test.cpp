@@ -240,6 +240,54 @@ TEST_F(node_bsptree2d_fixture, ClassifyPolyline)
     }
 }
 
+TEST_F(node_bsptree2d_fixture, compact_node_bsp_tree_matches_node_bsp_tree)
+{
+    using namespace geometrix;
+    using compact_bsp2 = compact_node_bsp_tree_2d<segment2>;
+    auto pgon = polygon2 { { 1098.47527107, 1178.48809441 }, { 1071.39171392, 1185.84823745 }, { 1059.99795823, 1189.00357638 }, { 1049.91310331, 1191.87260701 }, { 1041.04481327, 1194.50296442 }, { 1033.30075223, 1196.94228366 }, { 1026.58858431, 1199.2381998 }, { 1020.81597365, 1201.43834793 }, { 1015.89058435, 1203.59036309 }, { 1011.72008055, 1205.74188038 }, { 1008.21212637, 1207.94053484 }, { 1005.27438592, 1210.23396156 }, { 1002.81452334, 1212.6697956 }, { 1000.74020273, 1215.29567203 }, { 998.959088237, 1218.15922592 }, { 997.378843969, 1221.30809234 }, { 995.907134052, 1224.78990635 }, { 994.451622609, 1228.65230303 }, { 992.919973761, 1232.94291745 }, { 993.292221797, 1237.59252211 }, { 993.702560876, 1241.76720346 }, { 994.228998352, 1245.50790274 }, { 994.94954158, 1248.85556122 }, { 995.942197916, 1251.85112014 }, { 997.284974713, 1254.53552075 }, { 999.055879328, 1256.94970431 }, { 1001.33291911, 1259.13461207 }, { 1004.19410143, 1261.13118529 }, { 1007.71743362, 1262.98036521 }, { 1011.98092305, 1264.72309309 }, { 1017.06257707, 1266.40031019 }, { 1023.04040304, 1268.05295775 }, { 1029.99240831, 1269.72197703 }, { 1037.99660023, 1271.44830928 }, { 1047.13098617, 1273.27289576 }, { 1057.47357347, 1275.23667771 }, { 1082.09538158, 1279.74559306 } };
+    auto segs = polygon_as_segment_range<segment2>(pgon);
+
+    auto bounds = get_bounds(pgon, cmp);
+    std::vector<point2> points(pgon.begin(), pgon.end());
+    for (std::size_t i = 0; i <= 40; ++i)
+        for (std::size_t j = 0; j <= 40; ++j)
+            points.emplace_back(std::get<e_xmin>(bounds) - 5. + i * (std::get<e_xmax>(bounds) - std::get<e_xmin>(bounds) + 10.) / 40., std::get<e_ymin>(bounds) - 5. + j * (std::get<e_ymax>(bounds) - std::get<e_ymin>(bounds) + 10.) / 40.);
+
+    auto check = [&](const bsp2& tree, const compact_bsp2& sut)
+    {
+        for (const auto& p : points)
+        {
+            EXPECT_EQ(tree.locate_point(p, cmp), sut.locate_point(p, cmp));
+
+            std::vector<segment2> expected, result;
+            tree.painters_traversal(p, [&expected](const segment2& s) { expected.push_back(s); }, cmp);
+            sut.painters_traversal(p, [&result](const segment2& s) { result.push_back(s); }, cmp);
+            ASSERT_EQ(expected.size(), result.size());
+            for (std::size_t i = 0; i < expected.size(); ++i)
+            {
+                EXPECT_TRUE(numeric_sequence_equals(expected[i].get_start(), result[i].get_start(), cmp));
+                EXPECT_TRUE(numeric_sequence_equals(expected[i].get_end(), result[i].get_end(), cmp));
+            }
+        }
+    };
+
+    {
+        auto selector = partition_policies::first_segment_selector_policy<segment2>();
+        bsp2 tree(segs, selector, cmp);
+        check(tree, compact_bsp2(segs, selector, cmp));
+        check(tree, tree.compact());
+    }
+
+    {
+        auto selector = partition_policies::scored_segment_selector_policy<segment2, decltype(cmp)>(cmp);
+        bsp2 tree(segs, selector, cmp);
+        compact_bsp2 sut(segs, selector, cmp);
+        EXPECT_EQ(pgon.size(), sut.get_coincident_edges().size());
+        check(tree, sut);
+        check(tree, tree.compact());
+    }
+}
+
 #include <geometrix/algorithm/hyperplane_partition_policies.hpp>
 TEST_F(node_bsptree2d_fixture, buildSolidLeafBSP_locate_point_with_interior_returns_einside)
 {
@@ -775,6 +823,113 @@ TEST_F(data_box_grid_solid_bsptree2d_fixture, test_min_distance_solid_bsp_segmen
     }
 }
 
+#include <geometrix/algorithm/distance/point_segment_distance.hpp>
+#include <random>
+TEST_F(data_box_grid_solid_bsptree2d_fixture, queries_with_reused_context_match_brute_force)
+{
+    using namespace geometrix;
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<> coord(-10.0, 35.0);
+    std::uniform_real_distribution<> angle(0.0, 2.0 * constants::pi<double>());
+    solid_bsp2::query_context context;
+    for (int i = 0; i < 500; ++i)
+    {
+        auto p = point2{ coord(gen), coord(gen) };
+
+        auto expected = (std::numeric_limits<double>::max)();
+        for (auto const& s : segs)
+            expected = (std::min)(expected, point_segment_distance_sqrd(p, std::get<0>(s)));
+
+        std::size_t idx, ctxIdx;
+        auto d2 = sut.get_min_distance_sqrd_to_solid(p, idx, cmp);
+        auto ctxD2 = sut.get_min_distance_sqrd_to_solid(p, ctxIdx, cmp, context);
+        EXPECT_TRUE(cmp.equals(expected, d2));
+        EXPECT_TRUE(cmp.equals(point_segment_distance_sqrd(p, std::get<0>(segs[idx])), d2));
+        EXPECT_EQ(d2, ctxD2);
+        EXPECT_EQ(idx, ctxIdx);
+
+        auto a = angle(gen);
+        auto ray = vector2{ std::cos(a), std::sin(a) };
+        auto result = sut.ray_intersection(p, ray, cmp);
+        auto ctxResult = sut.ray_intersection(p, ray, cmp, context);
+        EXPECT_EQ(static_cast<bool>(result), static_cast<bool>(ctxResult));
+        if (result && ctxResult)
+        {
+            EXPECT_EQ(result.intersection_distance(), ctxResult.intersection_distance());
+            EXPECT_EQ(result.get_data(), ctxResult.get_data());
+        }
+    }
+}
+
+TEST_F(data_box_grid_solid_bsptree2d_fixture, batched_point_in_solid_space_matches_scalar)
+{
+    using namespace geometrix;
+
+    //! A grid with a step of 0.25 puts many points exactly on the box edges.
+    std::vector<point2> points;
+    for (int i = 0; i < 160; ++i)
+        for (int j = 0; j < 160; ++j)
+            points.push_back(point2{ -7.0 + 0.25 * i, -7.0 + 0.25 * j });
+
+    //! Follow the ordered points with a shuffled copy so that both the scalar and the packet traversals are used.
+    std::vector<point2> shuffled(points);
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(42));
+    points.insert(points.end(), shuffled.begin(), shuffled.end());
+
+    std::vector<point_in_solid_classification> expected;
+    for (auto const& p : points)
+        expected.push_back(sut.point_in_solid_space(p, cmp));
+    EXPECT_NE(expected.end(), std::find(expected.begin(), expected.end(), point_in_solid_classification::on_boundary));
+
+    std::vector<point_in_solid_classification> serial(points.size()), parallel(points.size());
+    sut.point_in_solid_space(points, serial.begin(), cmp);
+    sut.point_in_solid_space(points, parallel.begin(), cmp, async_executor(), 1000);
+    EXPECT_EQ(expected, serial);
+    EXPECT_EQ(expected, parallel);
+}
+
+TEST_F(data_box_grid_solid_bsptree2d_fixture, parallel_sampled_build_matches_serial_build)
+{
+    using namespace geometrix;
+
+    using cmp_t = std::decay<decltype(cmp)>::type;
+    using extractor_t = first_of_tuple_simplex_extractor;
+    using selector_t = partition_policies::sampled_scored_selector_policy<extractor_t, cmp_t>;
+
+    //! Small samples and threshold so that the sampling and the splicing of concurrently built subtrees are exercised.
+    auto selector = selector_t(extractor_t(), cmp, 3, 16);
+    solid_bsp2 serial{ segs, selector, cmp, extractor_t() };
+    solid_bsp2 parallel{ segs, selector, cmp, extractor_t(), async_executor(), 8 };
+
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<> coord(-10.0, 35.0);
+    std::uniform_real_distribution<> angle(0.0, 2.0 * constants::pi<double>());
+    for (int i = 0; i < 500; ++i)
+    {
+        auto p = point2{ coord(gen), coord(gen) };
+        auto expected = sut.point_in_solid_space(p, cmp);
+        EXPECT_EQ(expected, serial.point_in_solid_space(p, cmp));
+        EXPECT_EQ(expected, parallel.point_in_solid_space(p, cmp));
+
+        std::size_t idx, parallelIdx;
+        auto d2 = serial.get_min_distance_sqrd_to_solid(p, idx, cmp);
+        EXPECT_EQ(d2, parallel.get_min_distance_sqrd_to_solid(p, parallelIdx, cmp));
+        EXPECT_EQ(idx, parallelIdx);
+
+        auto a = angle(gen);
+        auto ray = vector2{ std::cos(a), std::sin(a) };
+        auto result = serial.ray_intersection(p, ray, cmp);
+        auto parallelResult = parallel.ray_intersection(p, ray, cmp);
+        EXPECT_EQ(static_cast<bool>(result), static_cast<bool>(parallelResult));
+        if (result && parallelResult)
+        {
+            EXPECT_EQ(result.intersection_distance(), parallelResult.intersection_distance());
+            EXPECT_EQ(result.get_data(), parallelResult.get_data());
+        }
+    }
+}
+
 #include <geometrix/utility/scope_timer.ipp>
 TEST_F(data_box_grid_solid_bsptree2d_fixture, time_grid_bsp_raytrace)
 {
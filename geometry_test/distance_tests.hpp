@@ -438,6 +438,63 @@ BOOST_FIXTURE_TEST_CASE(polygon_distance_circular_lines_test, geometry_kernel_2d
     BOOST_CHECK(result == result_check);
 }
 
+#include <geometrix/utility/random_generator.hpp>
+BOOST_FIXTURE_TEST_CASE(prepared_point_sequence_distance_matches_brute_test, geometry_kernel_2d_fixture)
+{
+    using namespace geometrix;
+    random_real_generator<> rnd(1.0);
+
+    //! Star shaped polygons at random offsets; the first vertex is off the x axis so the closing segment is nearest along x.
+    auto make_star = [&rnd](const point2& center, std::size_t n)
+    {
+        auto pgon = polygon2{};
+        auto s = constants::two_pi<double>() / n;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            auto t = (i + 0.5) * s;
+            auto r = 1.0 + 0.5 * rnd();
+            pgon.emplace_back(center + r * vector2{ cos(t), sin(t) });
+        }
+        return pgon;
+    };
+
+    std::vector<polygon2> pgons;
+    pgons.push_back(make_star(point2{ 0., 0. }, 64));
+    pgons.push_back(make_star(point2{ 4., 0. }, 64));
+    for (std::size_t i = 0; i < 20; ++i)
+        pgons.push_back(make_star(point2{ 20. * rnd() - 10., 20. * rnd() - 10. }, 6 + 5 * i));
+
+    std::vector<prepared_polygon<polygon2>> prepared;
+    for (const auto& pgon : pgons)
+        prepared.emplace_back(pgon);
+
+    auto reference = make_prepared_polygon(pgons[0]);
+    for (std::size_t k = 1; k < pgons.size(); ++k)
+    {
+        auto expected = polygon_polygon_distance_sqrd_brute(pgons[0], pgons[k], cmp);
+        BOOST_CHECK_CLOSE(polygon_polygon_distance_sqrd(reference, prepared[k], cmp), expected, 1e-9);
+        BOOST_CHECK_CLOSE(polygon_polygon_distance_sqrd(pgons[0], pgons[k], cmp), expected, 1e-9);
+        BOOST_CHECK_CLOSE(polygon_polygon_distance(reference, prepared[k], cmp), std::sqrt(expected), 1e-9);
+
+        double s, t;
+        point2 c1, c2;
+        std::size_t i, j;
+        auto result = polygon_polygon_closest_point(reference, prepared[k], i, j, s, t, c1, c2, cmp);
+        BOOST_CHECK_CLOSE(result, expected, 1e-9);
+        BOOST_CHECK_CLOSE(point_point_distance_sqrd(c1, c2), expected, 1e-6);
+        BOOST_CHECK_CLOSE(point_segment_distance_sqrd(c1, pgons[0][i], pgons[0][(i + 1) % pgons[0].size()]) + 1.0, 1.0, 1e-9);
+        BOOST_CHECK_CLOSE(point_segment_distance_sqrd(c2, pgons[k][j], pgons[k][(j + 1) % pgons[k].size()]) + 1.0, 1.0, 1e-9);
+
+        polyline2 pline1(pgons[0].begin(), pgons[0].end()), pline2(pgons[k].begin(), pgons[k].end());
+        auto expectedLine = polyline_polyline_distance_sqrd_brute(pline1, pline2, cmp);
+        auto prepared1 = make_prepared_polyline(pline1);
+        auto prepared2 = make_prepared_polyline(pline2);
+        BOOST_CHECK_CLOSE(polyline_polyline_distance_sqrd(prepared1, prepared2, cmp), expectedLine, 1e-9);
+        BOOST_CHECK_CLOSE(polyline_polyline_closest_point(prepared1, prepared2, i, j, s, t, c1, c2, cmp), expectedLine, 1e-9);
+        BOOST_CHECK(j + 1 < pline2.size());
+    }
+}
+
 #include <geometrix/algorithm/distance/point_plane_closest_point.hpp>
 BOOST_FIXTURE_TEST_CASE(point_plane_closest_point_general_line_2D_case, geometry_kernel_2d_fixture)
 {
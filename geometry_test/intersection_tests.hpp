@@ -1343,4 +1343,323 @@ BOOST_FIXTURE_TEST_CASE(test_oriented_intersection, geometry_kernel_2d_units_fix
 
 }
 
+#include <geometrix/algorithm/dynamic_aabb_tree.hpp>
+#include <geometrix/algorithm/intersection/moving_sphere_sphere_intersection.hpp>
+#include <geometrix/utility/executor.hpp>
+#include <random>
+BOOST_FIXTURE_TEST_CASE(dynamic_aabb_tree_moving_circles_match_brute_force, geometry_kernel_2d_fixture)
+{
+    using namespace geometrix;
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> position(0.0, 40.0);
+    std::uniform_real_distribution<double> speed(-0.5, 0.5);
+    std::uniform_real_distribution<double> radius(0.1, 0.6);
+
+    std::size_t n = 500;
+    std::vector<circle2> circles;
+    std::vector<vector2> velocities;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        circles.emplace_back(point2(position(gen), position(gen)), radius(gen));
+        velocities.emplace_back(speed(gen), speed(gen));
+    }
+
+    //! The bounds of a circle swept over one tick.
+    auto swept_bounds = [&](std::size_t i)
+    {
+        auto& c = circles[i].get_center();
+        point2 d = c + velocities[i];
+        double r = circles[i].get_radius();
+        return aabb2(point2((std::min)(c[0], d[0]) - r, (std::min)(c[1], d[1]) - r), point2((std::max)(c[0], d[0]) + r, (std::max)(c[1], d[1]) + r));
+    };
+
+    //! Whether two circles touch within the tick.
+    auto collide = [&](std::size_t i, std::size_t j)
+    {
+        double t;
+        point2 q;
+        return moving_sphere_sphere_intersection(circles[i], circles[j], velocities[i], velocities[j], t, q, cmp) && t <= 1.0;
+    };
+
+    dynamic_aabb_tree<point2> tree(0.1);
+    std::vector<dynamic_aabb_tree<point2>::proxy_id> proxies;
+    for (std::size_t i = 0; i < n; ++i)
+        proxies.push_back(tree.insert(swept_bounds(i), i));
+    BOOST_CHECK_EQUAL(tree.size(), n);
+
+    async_executor executor;
+    std::size_t removed = n;
+    for (int tick = 0; tick < 20; ++tick)
+    {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (i == removed)
+                continue;
+            circles[i] = circle2(circles[i].get_center() + velocities[i], circles[i].get_radius());
+            tree.update(proxies[i], swept_bounds(i), velocities[i]);
+            BOOST_CHECK(tree.get_fat_bounds(proxies[i]).contains(swept_bounds(i)));
+        }
+
+        //! Drop one circle and bring back the previous one to exercise the free list.
+        if (removed != n)
+            proxies[removed] = tree.insert(swept_bounds(removed), removed);
+        removed = (tick * 37) % n;
+        tree.remove(proxies[removed]);
+
+        auto test = [&](std::uint32_t a, std::uint32_t b) { return collide(tree.get_value(a), tree.get_value(b)); };
+        auto candidates = tree.find_overlapping_pairs();
+        auto serial = narrow_phase(candidates, test);
+        auto parallel = narrow_phase(candidates, test, executor, 16);
+        BOOST_CHECK(serial == parallel);
+
+        std::vector<std::pair<std::size_t, std::size_t>> hits;
+        for (const auto& p : serial)
+            hits.emplace_back((std::min)(tree.get_value(p.first), tree.get_value(p.second)), (std::max)(tree.get_value(p.first), tree.get_value(p.second)));
+        std::sort(hits.begin(), hits.end());
+
+        std::vector<std::pair<std::size_t, std::size_t>> expected;
+        for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t j = i + 1; j < n; ++j)
+                if (i != removed && j != removed && collide(i, j))
+                    expected.emplace_back(i, j);
+
+        BOOST_CHECK(!expected.empty());
+        BOOST_CHECK(hits == expected);
+        BOOST_CHECK_EQUAL(tree.size(), n - 1);
+        BOOST_CHECK(tree.get_height() < 4 * 9);
+    }
+}
+
+#include <geometrix/algorithm/sweep_and_prune.hpp>
+#include <geometrix/algorithm/intersection/obb_obb_intersection.hpp>
+#include <set>
+BOOST_FIXTURE_TEST_CASE(sweep_and_prune_events_match_brute_force, geometry_kernel_2d_fixture)
+{
+    using namespace geometrix;
+
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> position(0.0, 40.0);
+    std::uniform_real_distribution<double> speed(-0.4, 0.4);
+    std::uniform_real_distribution<double> extent(0.1, 1.0);
+    std::uniform_real_distribution<double> angle(0.0, 6.28);
+
+    std::size_t n = 500;
+    std::vector<point2> centers;
+    std::vector<vector2> velocities;
+    std::vector<double> angles, halfwidths, halfheights;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        centers.emplace_back(position(gen), position(gen));
+        velocities.emplace_back(speed(gen), speed(gen));
+        angles.push_back(angle(gen));
+        halfwidths.push_back(extent(gen));
+        halfheights.push_back(extent(gen));
+    }
+
+    auto make_obb = [&](std::size_t i)
+    {
+        vector2 u(std::cos(angles[i]), std::sin(angles[i]));
+        return obb2(centers[i], u, left_normal(u), halfwidths[i], halfheights[i]);
+    };
+
+    auto bounds = [&](std::size_t i)
+    {
+        auto o = make_obb(i);
+        aabb2 box(o[0], o[0]);
+        for (std::size_t c = 1; c < 4; ++c)
+            box.expand(aabb2(o[c], o[c]));
+        return box;
+    };
+
+    //! rebuilt sorts from scratch on every sweep.
+    sweep_and_prune<point2> sap, rebuilt(0);
+    std::vector<sweep_and_prune<point2>::proxy_id> proxies;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        proxies.push_back(sap.insert(bounds(i), i));
+        rebuilt.insert(bounds(i), i);
+    }
+
+    std::vector<bool> alive(n, true);
+    std::set<std::pair<std::size_t, std::size_t>> tracked;
+    std::vector<broad_phase_pair> added, removed;
+    for (int tick = 0; tick < 30; ++tick)
+    {
+        if (tick > 0)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                centers[i] = centers[i] + velocities[i];
+                angles[i] += 0.05;
+                if (alive[i])
+                {
+                    sap.update(proxies[i], bounds(i));
+                    rebuilt.update(proxies[i], bounds(i));
+                }
+            }
+
+            //! Toggle a few proxies to exercise removal and reuse of ids.
+            for (std::size_t k = 0; k < 3; ++k)
+            {
+                std::size_t i = (tick * 53 + k * 101) % n;
+                if (alive[i])
+                {
+                    sap.remove(proxies[i]);
+                    rebuilt.remove(proxies[i]);
+                }
+                else
+                {
+                    proxies[i] = sap.insert(bounds(i), i);
+                    rebuilt.insert(bounds(i), i);
+                }
+                alive[i] = !alive[i];
+            }
+        }
+
+        sap.sweep(added, removed);
+        auto as_items = [&](const broad_phase_pair& p) { return std::make_pair((std::min)(sap.get_value(p.first), sap.get_value(p.second)), (std::max)(sap.get_value(p.first), sap.get_value(p.second))); };
+        for (const auto& p : removed)
+            BOOST_CHECK(tracked.erase(as_items(p)) == 1);
+        for (const auto& p : added)
+            BOOST_CHECK(tracked.insert(as_items(p)).second);
+
+        std::set<std::pair<std::size_t, std::size_t>> expected;
+        for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t j = i + 1; j < n; ++j)
+                if (alive[i] && alive[j] && bounds(i).intersects(bounds(j)))
+                    expected.insert(std::make_pair(i, j));
+
+        BOOST_CHECK(!expected.empty());
+        BOOST_CHECK(tracked == expected);
+        BOOST_CHECK_EQUAL(sap.number_of_pairs(), expected.size());
+        rebuilt.sweep();
+        BOOST_CHECK(rebuilt.get_overlapping_pairs() == sap.get_overlapping_pairs());
+
+        auto collide = [&](std::uint32_t a, std::uint32_t b) { return obb_obb_intersection(make_obb(sap.get_value(a)), make_obb(sap.get_value(b)), cmp); };
+        auto hits = narrow_phase(sap.get_overlapping_pairs(), collide);
+        std::size_t nHits = 0;
+        for (const auto& p : expected)
+            if (obb_obb_intersection(make_obb(p.first), make_obb(p.second), cmp))
+                ++nHits;
+        BOOST_CHECK_EQUAL(hits.size(), nHits);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(sweep_and_prune_remove_overlapping_pair_then_reuse_ids, geometry_kernel_2d_fixture)
+{
+    using namespace geometrix;
+
+    //! Keep the sweep incremental so the removed endpoints are sorted rather than rebuilt.
+    sweep_and_prune<point2> sap(1000);
+    std::vector<broad_phase_pair> added, removed;
+    auto a = sap.insert(aabb2(point2(0.0, 0.0), point2(2.0, 2.0)), 0);
+    auto b = sap.insert(aabb2(point2(1.0, 1.0), point2(3.0, 3.0)), 1);
+    auto c = sap.insert(aabb2(point2(10.0, 10.0), point2(11.0, 11.0)), 2);
+    sap.sweep(added, removed);
+    BOOST_CHECK_EQUAL(added.size(), 1);
+    BOOST_CHECK(sap.is_overlapping(a, b));
+
+    sap.remove(a);
+    sap.remove(b);
+    sap.sweep(added, removed);
+    BOOST_CHECK(added.empty());
+    BOOST_REQUIRE_EQUAL(removed.size(), 1);
+    BOOST_CHECK(removed[0] == broad_phase_pair(a, b));
+    BOOST_CHECK_EQUAL(sap.number_of_pairs(), 0);
+
+    //! The freed ids are reused for disjoint boxes which must not inherit the old pair.
+    auto d = sap.insert(aabb2(point2(20.0, 0.0), point2(21.0, 1.0)), 3);
+    auto e = sap.insert(aabb2(point2(30.0, 0.0), point2(31.0, 1.0)), 4);
+    BOOST_CHECK((d == a && e == b) || (d == b && e == a));
+    sap.sweep(added, removed);
+    BOOST_CHECK(added.empty());
+    BOOST_CHECK(removed.empty());
+    BOOST_CHECK(!sap.is_overlapping(d, e));
+    BOOST_CHECK_EQUAL(sap.number_of_pairs(), 0);
+
+    sap.update(e, aabb2(point2(20.5, 0.5), point2(22.0, 2.0)));
+    sap.sweep(added, removed);
+    BOOST_CHECK_EQUAL(added.size(), 1);
+    BOOST_CHECK(removed.empty());
+    BOOST_CHECK(sap.is_overlapping(d, e));
+    BOOST_CHECK(!sap.is_overlapping(c, d));
+}
+
+#include <chrono>
+//! 100k boxes from 1 to 3 wide spread over a square 1000 wide moving no more than 0.01 on each axis per frame. A sweep must
+//! fit in a frame at 60Hz. Debug builds run the same density with fewer boxes and only check the pairs.
+BOOST_FIXTURE_TEST_CASE(sweep_and_prune_coherent_motion_timing, geometry_kernel_2d_fixture)
+{
+    using namespace geometrix;
+
+#ifdef NDEBUG
+    std::size_t n = 100000;
+#else
+    std::size_t n = 2000;
+#endif
+    double world = 1000.0 * std::sqrt(n / 100000.0);
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> position(0.0, world);
+    std::uniform_real_distribution<double> speed(-0.01, 0.01);
+    std::uniform_real_distribution<double> extent(0.5, 1.5);
+
+    std::vector<point2> centers;
+    std::vector<vector2> velocities;
+    std::vector<double> halfwidths;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        centers.emplace_back(position(gen), position(gen));
+        velocities.emplace_back(speed(gen), speed(gen));
+        halfwidths.push_back(extent(gen));
+    }
+
+    auto bounds = [&](std::size_t i)
+    {
+        vector2 h(halfwidths[i], halfwidths[i]);
+        return aabb2(centers[i] - h, centers[i] + h);
+    };
+
+    sweep_and_prune<point2> sap;
+    std::vector<sweep_and_prune<point2>::proxy_id> proxies;
+    for (std::size_t i = 0; i < n; ++i)
+        proxies.push_back(sap.insert(bounds(i), i));
+    sap.sweep();
+
+    std::size_t frames = 60, events = 0;
+    std::vector<double> times;
+    std::vector<broad_phase_pair> added, removed;
+    for (std::size_t frame = 0; frame < frames; ++frame)
+    {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            centers[i] = centers[i] + velocities[i];
+            sap.update(proxies[i], bounds(i));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        {
+            GEOMETRIX_MEASURE_SCOPE_TIME("sweep_and_prune_coherent_motion");
+            sap.sweep(added, removed);
+        }
+        times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        events += added.size() + removed.size();
+    }
+
+    BOOST_CHECK(events > 0);
+    sweep_and_prune<point2> rebuilt(0);
+    for (std::size_t i = 0; i < n; ++i)
+        rebuilt.insert(bounds(i), i);
+    rebuilt.sweep();
+    BOOST_CHECK(rebuilt.get_overlapping_pairs() == sap.get_overlapping_pairs());
+
+#ifdef NDEBUG
+    //! The median is checked so that a frame stalled by another process does not fail the test.
+    std::sort(times.begin(), times.end());
+    double median = times[frames / 2];
+    BOOST_TEST_MESSAGE("sweep_and_prune: " << n << " proxies " << sap.number_of_pairs() << " pairs " << median << " ms median sweep " << times.back() << " ms slowest");
+    BOOST_CHECK_LT(median, 1000.0 / 60.0);
+#endif
+}
+
 #endif //GEOMETRIX_INTERSECTION_TESTS_HPP
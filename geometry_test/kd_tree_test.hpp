@@ -19,6 +19,7 @@
 #include <geometrix/algorithm/euclidean_distance.hpp>
 #include <geometrix/algorithm/kd_tree.hpp>
 #include <geometrix/algorithm/median_partitioning_strategy.hpp>
+#include <geometrix/algorithm/flat_kd_tree.hpp>
 
 #include <set>
 
@@ -236,4 +237,445 @@ BOOST_AUTO_TEST_CASE( TestKDTreeNearest3d )
     BOOST_CHECK( compare.equals( distanceA, distanceB ) );
 }
 
+template <typename Point>
+struct collect_visitor
+{
+    collect_visitor( std::vector<Point>& points )
+        : m_points( points )
+    {}
+
+    void operator()( const Point& p ) const
+    {
+        m_points.push_back( p );
+    }
+
+    std::vector<Point>& m_points;
+};
+
+//! Compare the flat layout against a brute force range query for several bucket sizes.
+BOOST_AUTO_TEST_CASE( TestFlatKDTree2d )
+{
+    using namespace geometrix;
+
+    typedef point_double_2d point_2d;
+
+    std::vector< point_2d > polygon;
+    random_real_generator< boost::mt19937 > rnd(10.0);
+    fraction_tolerance_comparison_policy<double> compare(1e-10);
+    for( std::size_t i=0;i < 1000; ++i )
+        polygon.push_back( point_2d( rnd(), rnd() ) );
+
+    //! Add some duplicates to exercise splits on equal coordinates.
+    for( std::size_t i=0;i < 50; ++i )
+        polygon.push_back( point_2d( 2.5, 2.5 ) );
+
+    lexicographical_comparer< fraction_tolerance_comparison_policy<double> > lexCompare( compare );
+    axis_aligned_bounding_box< point_2d > range( point_2d( 1.0, 2.0 ), point_2d( 5.0, 7.5 ) );
+
+    std::vector< point_2d > expected;
+    for( const auto& p : polygon )
+        if( range.intersects( p, compare ) )
+            expected.push_back( p );
+    std::sort( expected.begin(), expected.end(), lexCompare );
+
+    for( std::size_t bucketSize : { 1, 4, 8, 32, 2000 } )
+    {
+        flat_kd_tree< point_2d > tree( polygon, compare, bucketSize );
+        BOOST_CHECK( tree.size() == polygon.size() );
+
+        std::vector< point_2d > found;
+        tree.search( range, collect_visitor<point_2d>( found ), compare );
+        std::sort( found.begin(), found.end(), lexCompare );
+
+        BOOST_CHECK( found.size() == expected.size() );
+        BOOST_CHECK( std::equal( found.begin(), found.end(), expected.begin(), expected.end(), [&compare]( const point_2d& a, const point_2d& b ){ return numeric_sequence_equals( a, b, compare ); } ) );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( TestFlatKDTree3d )
+{
+    using namespace geometrix;
+
+    typedef point_double_3d point_3d;
+
+    std::vector< point_3d > polygon;
+    random_real_generator< boost::mt19937 > rnd(10.0);
+    fraction_tolerance_comparison_policy<double> compare(1e-10);
+    typedef std::multiset< point_3d, lexicographical_comparer< fraction_tolerance_comparison_policy<double> > > point_set;
+
+    point_set points( compare );
+    for( std::size_t i=0;i < 1000; ++i )
+    {
+        double x = rnd();
+        double y = rnd();
+        double z = rnd();
+        if( x <= 5.0 && y <= 5.0 && z <= 5.0 )
+        {
+            points.insert( point_3d( x, y, z ) );
+        }
+        polygon.push_back( point_3d( x, y, z ) );
+    }
+
+    flat_kd_tree< point_3d > tree( polygon, compare );
+
+    axis_aligned_bounding_box< point_3d > range( point_3d( 0.0, 0.0, 0.0 ), point_3d( 5.0, 5.0, 5.0 ) );
+
+    std::vector< point_3d > found;
+    tree.search( range, collect_visitor<point_3d>( found ), compare );
+    BOOST_CHECK( found.size() == points.size() );
+
+    point_visitor< point_set > visitor( points );
+    tree.search( range, visitor, compare );
+    BOOST_CHECK( points.empty() );
+}
+
+//! Check k nearest and radius queries against brute force on both tree layouts.
+template <typename Tree>
+void check_nearest_and_radius_queries()
+{
+    using namespace geometrix;
+
+    typedef point_double_3d point_3d;
+
+    std::vector< point_3d > polygon;
+    random_real_generator< boost::mt19937 > rnd(10.0);
+    fraction_tolerance_comparison_policy<double> compare(1e-10);
+    for( std::size_t i=0;i < 2000; ++i )
+        polygon.push_back( point_3d( rnd(), rnd(), rnd() ) );
+
+    Tree tree( polygon, compare );
+
+    for( std::size_t q=0;q < 20; ++q )
+    {
+        point_3d p( rnd(), rnd(), rnd() );
+
+        std::vector< double > distances;
+        for( const auto& x : polygon )
+            distances.push_back( point_point_distance_sqrd( p, x ) );
+        std::sort( distances.begin(), distances.end() );
+
+        const std::size_t k = 7;
+        std::vector< point_3d > nearest = tree.nearest( p, k );
+        BOOST_CHECK( nearest.size() == k );
+        for( std::size_t i=0;i < nearest.size(); ++i )
+            BOOST_CHECK_CLOSE( point_point_distance_sqrd( p, nearest[i] ), distances[i], 1e-10 );
+
+        double r = 1.5;
+        std::size_t expected = std::count_if( distances.begin(), distances.end(), [r]( double d ){ return d <= r * r; } );
+        std::vector< point_3d > found;
+        tree.radius_search( p, r, collect_visitor<point_3d>( found ) );
+        BOOST_CHECK( found.size() == expected );
+        for( const auto& x : found )
+            BOOST_CHECK( point_point_distance_sqrd( p, x ) <= r * r );
+    }
+
+    BOOST_CHECK( tree.nearest( polygon[0], 0 ).empty() );
+    BOOST_CHECK( tree.nearest( polygon[0], polygon.size() + 10 ).size() == polygon.size() );
+
+    //! A k beyond the number of points returns all of them without reserving for k.
+    std::vector< point_3d > all;
+    BOOST_CHECK_NO_THROW( all = tree.nearest( polygon[0], (std::numeric_limits<std::size_t>::max)() ) );
+    BOOST_CHECK( all.size() == polygon.size() );
+}
+
+template <typename Point>
+struct median_kd_tree : geometrix::kd_tree<Point>
+{
+    template <typename PointSequence, typename NumberComparisonPolicy>
+    median_kd_tree( const PointSequence& points, const NumberComparisonPolicy& compare )
+        : geometrix::kd_tree<Point>( points, compare, geometrix::median_partitioning_strategy() )
+    {}
+};
+
+BOOST_AUTO_TEST_CASE( TestKDTreeNearestAndRadius )
+{
+    check_nearest_and_radius_queries< median_kd_tree< geometrix::point_double_3d > >();
+}
+
+BOOST_AUTO_TEST_CASE( TestFlatKDTreeNearestAndRadius )
+{
+    check_nearest_and_radius_queries< geometrix::flat_kd_tree< geometrix::point_double_3d > >();
+}
+
+//! A parallel build must produce the same tree as the serial build.
+BOOST_AUTO_TEST_CASE( TestKDTreeParallelBuildEquivalence )
+{
+    using namespace geometrix;
+
+    typedef point_double_3d point_3d;
+
+    std::vector< point_3d > polygon;
+    random_real_generator< boost::mt19937 > rnd(10.0);
+    fraction_tolerance_comparison_policy<double> compare(1e-10);
+    for( std::size_t i=0;i < 5000; ++i )
+        polygon.push_back( point_3d( rnd(), rnd(), rnd() ) );
+
+    //! Include duplicates so the median partition advances over equal coordinates.
+    for( std::size_t i=0;i < 100; ++i )
+        polygon.push_back( polygon[i % 10] );
+
+    kd_tree< point_3d > serialTree( polygon, compare, median_partitioning_strategy() );
+    kd_tree< point_3d > parallelTree( polygon, compare, median_partitioning_strategy(), async_executor(), 256 );
+    BOOST_CHECK( serialTree == parallelTree );
+
+    serial_executor serial;
+    kd_tree< point_3d > inlineTree( polygon, compare, median_partitioning_strategy(), serial, 256 );
+    BOOST_CHECK( serialTree == inlineTree );
+
+    std::vector< point_3d > other( polygon.begin() + 1, polygon.end() );
+    kd_tree< point_3d > otherTree( other, compare, median_partitioning_strategy() );
+    BOOST_CHECK( serialTree != otherTree );
+
+    for( std::size_t bucketSize : { 1, 8 } )
+    {
+        flat_kd_tree< point_3d > serialFlat( polygon, compare, bucketSize );
+        flat_kd_tree< point_3d > parallelFlat( polygon, compare, async_executor(), bucketSize, 256 );
+        BOOST_CHECK( serialFlat == parallelFlat );
+    }
+}
+
+//! Batched range queries must match brute force and be independent of the executor.
+BOOST_AUTO_TEST_CASE( TestFlatKDTreeBatchSearch )
+{
+    using namespace geometrix;
+
+    typedef point_double_2d point_2d;
+
+    std::vector< point_2d > polygon;
+    random_real_generator< boost::mt19937 > rnd(10.0);
+    fraction_tolerance_comparison_policy<double> compare(1e-10);
+    for( std::size_t i=0;i < 5000; ++i )
+        polygon.push_back( point_2d( rnd(), rnd() ) );
+
+    std::vector< axis_aligned_bounding_box< point_2d > > ranges;
+    for( std::size_t i=0;i < 500; ++i )
+    {
+        double x = rnd(), y = rnd();
+        double w = 0.01 * rnd(), h = 0.1 * rnd();
+        ranges.emplace_back( point_2d( x, y ), point_2d( x + w, y + h ) );
+    }
+    ranges.emplace_back( point_2d( -1.0, -1.0 ), point_2d( 11.0, 11.0 ) );
+    ranges.emplace_back( point_2d( 20.0, 20.0 ), point_2d( 21.0, 21.0 ) );
+
+    flat_kd_tree< point_2d > tree( polygon, compare );
+    kd_tree_batch_result result = tree.batch_search( ranges );
+    BOOST_REQUIRE( result.size() == ranges.size() );
+
+    for( std::size_t q=0;q < ranges.size(); ++q )
+    {
+        std::vector< std::uint32_t > expected;
+        for( std::uint32_t i=0;i < polygon.size(); ++i )
+            if( ranges[q].intersects( polygon[i] ) )
+                expected.push_back( i );
+
+        std::vector< std::uint32_t > found( result.begin( q ), result.end( q ) );
+        std::sort( found.begin(), found.end() );
+        BOOST_CHECK( found == expected );
+    }
+
+    kd_tree_batch_result parallelResult = tree.batch_search( ranges, async_executor(), 16 );
+    BOOST_CHECK( parallelResult.offsets == result.offsets );
+    BOOST_CHECK( parallelResult.indices == result.indices );
+
+#if defined(GEOMETRIX_HAS_EXECUTION_POLICIES)
+    kd_tree_batch_result policyResult = tree.batch_search( std::execution::par, ranges );
+    BOOST_CHECK( policyResult.offsets == result.offsets );
+    BOOST_CHECK( policyResult.indices == result.indices );
+#endif
+
+    BOOST_CHECK( tree.batch_search( std::vector< axis_aligned_bounding_box< point_2d > >() ).size() == 0 );
+}
+
+//! Batched range queries on a tree built with a tolerance wider than the spacing of the points must still be exact when a
+//! bound of the range lies at a split or just above it.
+BOOST_AUTO_TEST_CASE( TestFlatKDTreeBatchSearchAtSplits )
+{
+    using namespace geometrix;
+
+    typedef point_double_2d point_2d;
+
+    absolute_tolerance_comparison_policy<double> compare(0.5);
+    std::vector< point_2d > polygon;
+    for( std::size_t i=0;i < 64; ++i )
+        polygon.push_back( point_2d( 0.1 * ((i * 37) % 64), 0.1 * ((i * 11) % 64) ) );
+
+    std::vector< axis_aligned_bounding_box< point_2d > > ranges;
+    for( const auto& p : polygon )
+    {
+        double x = get<0>( p ), y = get<1>( p );
+        ranges.emplace_back( point_2d( x, -1.0 ), point_2d( 10.0, 10.0 ) );
+        ranges.emplace_back( point_2d( -1.0, -1.0 ), point_2d( x, 10.0 ) );
+        ranges.emplace_back( point_2d( -1.0, y ), point_2d( 10.0, 10.0 ) );
+        ranges.emplace_back( point_2d( -1.0, -1.0 ), point_2d( 10.0, y ) );
+        ranges.emplace_back( point_2d( x + 0.05, y + 0.05 ), point_2d( x + 0.45, y + 0.45 ) );
+        ranges.emplace_back( point_2d( x, y ), point_2d( x + 0.3, y + 0.3 ) );
+    }
+
+    for( std::size_t bucketSize : { 1, 2, 8 } )
+    {
+        flat_kd_tree< point_2d > tree( polygon, compare, bucketSize );
+        kd_tree_batch_result result = tree.batch_search( ranges );
+        BOOST_REQUIRE( result.size() == ranges.size() );
+
+        for( std::size_t q=0;q < ranges.size(); ++q )
+        {
+            std::vector< std::uint32_t > expected;
+            for( std::uint32_t i=0;i < polygon.size(); ++i )
+                if( ranges[q].intersects( polygon[i] ) )
+                    expected.push_back( i );
+
+            std::vector< std::uint32_t > found( result.begin( q ), result.end( q ) );
+            std::sort( found.begin(), found.end() );
+            BOOST_CHECK( found == expected );
+        }
+    }
+}
+
+#include <geometrix/algorithm/aabb_tree.hpp>
+#include <geometrix/algorithm/distance/point_segment_distance.hpp>
+#include <geometrix/primitive/segment.hpp>
+
+//! aabb_tree queries must match brute force over the item bounds for both split strategies and the parallel build must match the serial one.
+BOOST_AUTO_TEST_CASE( TestAABBTree2d )
+{
+    using namespace geometrix;
+
+    typedef point_double_2d point_2d;
+    typedef vector_double_2d vector_2d;
+    typedef segment< point_2d > segment_2d;
+    typedef axis_aligned_bounding_box< point_2d > box_2d;
+
+    random_real_generator< boost::mt19937 > rnd(10.0);
+    fraction_tolerance_comparison_policy<double> compare(1e-10);
+    std::vector< segment_2d > segments;
+    for( std::size_t i=0;i < 3000; ++i )
+    {
+        point_2d a( rnd(), rnd() );
+        segments.emplace_back( a, point_2d( get<0>( a ) + 0.05 * rnd(), get<1>( a ) + 0.05 * rnd() ) );
+    }
+
+    std::vector< std::uint32_t > indices( segments.size() );
+    std::iota( indices.begin(), indices.end(), 0 );
+    auto bounds = [&segments]( std::uint32_t i ) { return make_aabb<point_2d>( segments[i] ); };
+
+    for( aabb_tree_split split : { aabb_tree_split::median, aabb_tree_split::sah } )
+    {
+        aabb_tree< std::uint32_t, point_2d > tree( indices, bounds, split );
+        BOOST_CHECK( tree.size() == segments.size() );
+
+        aabb_tree< std::uint32_t, point_2d > parallelTree( indices, bounds, async_executor(), split, aabb_tree< std::uint32_t, point_2d >::default_leaf_size, 64 );
+        BOOST_REQUIRE( parallelTree.get_nodes().size() == tree.get_nodes().size() );
+        BOOST_CHECK( parallelTree.get_items() == tree.get_items() );
+        for( std::size_t i=0;i < tree.get_nodes().size(); ++i )
+        {
+            BOOST_CHECK( parallelTree.get_nodes()[i].first == tree.get_nodes()[i].first );
+            BOOST_CHECK( parallelTree.get_nodes()[i].count == tree.get_nodes()[i].count );
+        }
+
+        for( std::size_t q=0;q < 200; ++q )
+        {
+            point_2d p( rnd(), rnd() );
+            point_2d p2( get<0>( p ) + 0.5 * rnd() - 0.25, get<1>( p ) + 0.5 * rnd() - 0.25 );
+            box_2d range( point_2d( (std::min)( get<0>( p ), get<0>( p2 ) ), (std::min)( get<1>( p ), get<1>( p2 ) ) ), point_2d( (std::max)( get<0>( p ), get<0>( p2 ) ), (std::max)( get<1>( p ), get<1>( p2 ) ) ) );
+            vector_2d d = normalize( vector_2d( p2 - p ) );
+
+            std::vector< std::uint32_t > expectedBox, expectedSegment, expectedRay, foundBox, foundSegment, foundRay;
+            double expectedT = constants::infinity<double>();
+            for( std::uint32_t i=0;i < segments.size(); ++i )
+            {
+                box_2d b = bounds( i );
+                if( b.intersects( range ) )
+                    expectedBox.push_back( i );
+                if( segment_aabb_intersection( p, p2, b ) )
+                    expectedSegment.push_back( i );
+                double t;
+                point_2d x;
+                if( ray_aabb_intersection( p, d, b, t, x, compare ) )
+                {
+                    expectedRay.push_back( i );
+                    expectedT = (std::min)( expectedT, t );
+                }
+            }
+
+            tree.search( range, [&foundBox]( std::uint32_t i ) { foundBox.push_back( i ); } );
+            tree.segment_search( p, p2, [&foundSegment]( std::uint32_t i ) { foundSegment.push_back( i ); } );
+            tree.ray_search( p, d, [&foundRay]( std::uint32_t i ) { foundRay.push_back( i ); }, compare );
+            std::sort( foundBox.begin(), foundBox.end() );
+            std::sort( foundSegment.begin(), foundSegment.end() );
+            std::sort( foundRay.begin(), foundRay.end() );
+            BOOST_CHECK( foundBox == expectedBox );
+            BOOST_CHECK( foundSegment == expectedSegment );
+            BOOST_CHECK( foundRay == expectedRay );
+
+            //! The first box hit along the ray.
+            double t = constants::infinity<double>();
+            const std::uint32_t* hit = tree.ray_cast( p, d, [&]( std::uint32_t i, double& ti )
+            {
+                point_2d x;
+                return ray_aabb_intersection( p, d, bounds( i ), ti, x, compare ).is_intersecting();
+            }, t, compare );
+            BOOST_CHECK( (hit != nullptr) == !expectedRay.empty() );
+            BOOST_CHECK( t == expectedT );
+
+            double expectedD2 = constants::infinity<double>();
+            for( const auto& s : segments )
+                expectedD2 = (std::min)( expectedD2, point_segment_distance_sqrd( p, s ) );
+            double d2 = constants::infinity<double>();
+            const std::uint32_t* nearest = tree.nearest( p, [&]( std::uint32_t i ) { return point_segment_distance_sqrd( p, segments[i] ); }, d2 );
+            BOOST_REQUIRE( nearest != nullptr );
+            BOOST_CHECK( d2 == expectedD2 );
+            BOOST_CHECK( point_segment_distance_sqrd( p, segments[*nearest] ) == expectedD2 );
+        }
+    }
+
+    std::vector< std::uint32_t > none;
+    aabb_tree< std::uint32_t, point_2d > empty( none, bounds );
+    double d2 = constants::infinity<double>();
+    BOOST_CHECK( empty.empty() );
+    BOOST_CHECK( empty.nearest( point_2d( 0., 0. ), [&]( std::uint32_t i ) { return point_segment_distance_sqrd( point_2d( 0., 0. ), segments[i] ); }, d2 ) == nullptr );
+}
+
+BOOST_AUTO_TEST_CASE( TestAABBTree3d )
+{
+    using namespace geometrix;
+
+    typedef point_double_3d point_3d;
+    typedef axis_aligned_bounding_box< point_3d > box_3d;
+
+    random_real_generator< boost::mt19937 > rnd(10.0);
+    std::vector< box_3d > boxes;
+    for( std::size_t i=0;i < 5000; ++i )
+    {
+        point_3d lo( rnd(), rnd(), rnd() );
+        boxes.emplace_back( lo, point_3d( get<0>( lo ) + 0.1 * rnd(), get<1>( lo ) + 0.1 * rnd(), get<2>( lo ) + 0.1 * rnd() ) );
+    }
+
+    //! Duplicates have coincident centroids and must still be placed in leaves.
+    for( std::size_t i=0;i < 50; ++i )
+        boxes.push_back( boxes[7] );
+
+    aabb_tree< box_3d, point_3d > tree( boxes, []( const box_3d& b ) { return b; } );
+    for( std::size_t q=0;q < 200; ++q )
+    {
+        point_3d lo( rnd(), rnd(), rnd() );
+        box_3d range( lo, point_3d( get<0>( lo ) + rnd() * 0.2, get<1>( lo ) + rnd() * 0.2, get<2>( lo ) + rnd() * 0.2 ) );
+
+        std::size_t expected = 0, found = 0;
+        double expectedD2 = constants::infinity<double>();
+        for( const auto& b : boxes )
+        {
+            if( b.intersects( range ) )
+                ++expected;
+            expectedD2 = (std::min)( expectedD2, aabb_aabb_distance_sqrd( range, b ) );
+        }
+
+        tree.search( range, [&found]( const box_3d& ) { ++found; } );
+        BOOST_CHECK( found == expected );
+
+        double d2 = constants::infinity<double>();
+        BOOST_CHECK( tree.nearest( range, [&range]( const box_3d& b ) { return aabb_aabb_distance_sqrd( range, b ); }, d2 ) != nullptr );
+        BOOST_CHECK( d2 == expectedD2 );
+    }
+}
+
 #endif //GEOMETRIX_KD_TREE_TEST_HPP
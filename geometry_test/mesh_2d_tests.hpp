@@ -130,5 +130,307 @@ BOOST_AUTO_TEST_CASE( TestMemoization )
     BOOST_CHECK( cache.size() == 2 );
 }
 
+namespace {
+    //! Reference adjacency built by pairing each directed edge with the triangles holding its reverse.
+    inline geometrix::triangle_adjacency_matrix_t reference_adjacency_matrix( const std::vector<std::array<std::size_t, 3>>& indices )
+    {
+        const std::size_t none = (std::numeric_limits<std::size_t>::max)();
+        geometrix::triangle_adjacency_matrix_t adjMatrix( indices.size(), { { none, none, none } } );
+        std::map<std::pair<std::size_t, std::size_t>, std::vector<std::pair<std::size_t, std::size_t>>> edges;
+        for( std::size_t i = 0; i < indices.size(); ++i )
+            for( std::size_t k = 0; k < 3; ++k )
+                edges[std::make_pair( indices[i][k], indices[i][( k + 1 ) % 3] )].emplace_back( i, k );
+
+        for( const auto& item : edges )
+        {
+            auto it = edges.find( std::make_pair( item.first.second, item.first.first ) );
+            if( it == edges.end() )
+                continue;
+            for( const auto& side : item.second )
+                adjMatrix[side.first][side.second] = it->second.back().first;
+        }
+
+        return adjMatrix;
+    }
+}
+
+BOOST_AUTO_TEST_CASE( TestMeshAdjacencyMatrix )
+{
+    using namespace geometrix;
+    typedef point_double_2d point2;
+
+    //! A grid of quads split into triangles.
+    const std::size_t n = 40;
+    std::vector<point2> points;
+    for( std::size_t j = 0; j <= n; ++j )
+        for( std::size_t i = 0; i <= n; ++i )
+            points.emplace_back( static_cast<double>( i ), static_cast<double>( j ) );
+
+    std::vector<std::size_t> iArray;
+    for( std::size_t j = 0; j < n; ++j )
+    {
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            std::size_t v0 = j * ( n + 1 ) + i, v1 = v0 + 1, v2 = v0 + n + 2, v3 = v0 + n + 1;
+            iArray.insert( iArray.end(), { v0, v1, v2, v0, v2, v3 } );
+        }
+    }
+
+    absolute_tolerance_comparison_policy<double> cmp( 1e-10 );
+    mesh_2d<double> mesh( points, iArray, cmp );
+    BOOST_REQUIRE( mesh.has_adjacency_matrix() );
+
+    std::vector<std::array<std::size_t, 3>> indices;
+    for( std::size_t i = 0; i < mesh.get_number_triangles(); ++i )
+        indices.push_back( mesh.get_triangle_indices( i ) );
+    auto expected = reference_adjacency_matrix( indices );
+    BOOST_CHECK( mesh.get_adjacency_matrix() == expected );
+
+    mesh_2d<double> deferred( points, iArray, cmp, mesh_adjacency_construction::deferred );
+    BOOST_CHECK( !deferred.has_adjacency_matrix() );
+    deferred.build_adjacency_matrix( async_executor() );
+    BOOST_REQUIRE( deferred.has_adjacency_matrix() );
+    BOOST_CHECK( deferred.get_adjacency_matrix() == expected );
+
+    //! Three triangles sharing the edge (0, 1) and a fourth with the reversed edge.
+    std::vector<std::array<std::size_t, 3>> nonManifold{ { { 0, 1, 2 } }, { { 0, 1, 3 } }, { { 1, 0, 4 } }, { { 1, 0, 5 } }, { { 2, 1, 6 } } };
+    BOOST_CHECK( make_triangle_adjacency_matrix( nonManifold ) == reference_adjacency_matrix( nonManifold ) );
+    BOOST_CHECK( make_triangle_adjacency_matrix( nonManifold, async_executor(), 1 ) == reference_adjacency_matrix( nonManifold ) );
+    BOOST_CHECK( make_triangle_adjacency_matrix( indices, async_executor(), 64 ) == expected );
+}
+
+
+BOOST_AUTO_TEST_CASE( TestCompressedTriangleCache )
+{
+    using namespace geometrix;
+    typedef point_double_2d point2;
+
+    std::vector<point2> points{point2( 0., 0. ), point2( 10., 0. ), point2( 20., 10. ), point2( 20., 20. ), point2( 10., 20. ), point2( 10., 10. ), point2( 0., 10. )};
+    std::vector<std::size_t> iArray{6, 1, 5, 6, 0, 1, 2, 5, 1, 4, 5, 2, 4, 2, 3};
+
+    absolute_tolerance_comparison_policy<double> cmp( 1e-10 );
+    mesh_2d<double> mesh( points, iArray, cmp );
+    mesh_2d<double, mesh_traits<compressed_triangle_cache<double>>> compressed( points, iArray, cmp );
+
+    const auto& cache = compressed.get_triangle_cache();
+    const auto& grid = *mesh.get_triangle_cache().get_grid();
+    const auto& gTraits = cache.get_traits();
+    BOOST_REQUIRE( gTraits.get_width() == grid.get_traits().get_width() && gTraits.get_height() == grid.get_traits().get_height() );
+    for( std::uint32_t i = 0; i < gTraits.get_width(); ++i )
+    {
+        for( std::uint32_t j = 0; j < gTraits.get_height(); ++j )
+        {
+            auto cell = cache.get_cell( i, j );
+            const auto& expected = grid.get_cell( i, j );
+            BOOST_CHECK( std::equal( cell.begin(), cell.end(), expected.begin(), expected.end() ) );
+        }
+    }
+
+    random_real_generator<> rnd( 20. );
+    for( int i = 0; i < 1000; ++i )
+    {
+        point2 p( rnd() - 1., rnd() - 1. );
+        BOOST_CHECK( mesh.find_triangle( p, cmp ) == compressed.find_triangle( p, cmp ) );
+    }
+    BOOST_CHECK( cache.find_indices( point2( -100., -100. ) ).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( TestTriangleCacheCellSizeAndParallelBuild )
+{
+    using namespace geometrix;
+    typedef point_double_2d point2;
+
+    //! A 1mm grid of quads split into triangles; unit cells would put every triangle in one cell.
+    const std::size_t n = 60;
+    const double scale = 1e-3;
+    std::vector<point2> points;
+    for( std::size_t j = 0; j <= n; ++j )
+        for( std::size_t i = 0; i <= n; ++i )
+            points.emplace_back( scale * i, scale * j );
+
+    std::vector<std::size_t> iArray;
+    for( std::size_t j = 0; j < n; ++j )
+    {
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            std::size_t v0 = j * ( n + 1 ) + i, v1 = v0 + 1, v2 = v0 + n + 2, v3 = v0 + n + 1;
+            iArray.insert( iArray.end(), { v0, v1, v2, v0, v2, v3 } );
+        }
+    }
+
+    absolute_tolerance_comparison_policy<double> cmp( 1e-12 );
+    mesh_2d<double> unitMesh( points, iArray, cmp );
+    std::vector<std::array<point2, 3>> trigs;
+    for( std::size_t i = 0; i < unitMesh.get_number_triangles(); ++i )
+        trigs.push_back( unitMesh.get_triangle_vertices( i ) );
+    double cellSize = triangle_grid_cell_size<double>( points, trigs, 4.0 );
+    BOOST_CHECK( cellSize > 0.25 * scale && cellSize < 4.0 * scale );
+
+    using cache_t = default_triangle_cache<double>;
+    using compressed_t = compressed_triangle_cache<double>;
+    cache_t serial( points, trigs, cellSize );
+    cache_t parallel( points, trigs, cellSize, async_executor(), 64 );
+    compressed_t compressedSerial( points, trigs, cellSize );
+    compressed_t compressedParallel( points, trigs, cellSize, async_executor(), 64 );
+
+    const auto& grid = *serial.get_grid();
+    const auto& gTraits = grid.get_traits();
+    BOOST_CHECK( gTraits.get_cell_size() == cellSize );
+    std::size_t maxPerCell = 0;
+    for( std::uint32_t i = 0; i < gTraits.get_width(); ++i )
+    {
+        for( std::uint32_t j = 0; j < gTraits.get_height(); ++j )
+        {
+            const auto& expected = grid.get_cell( i, j );
+            maxPerCell = (std::max)( maxPerCell, expected.size() );
+            BOOST_CHECK( parallel.get_grid()->get_cell( i, j ) == expected );
+            auto c0 = compressedSerial.get_cell( i, j );
+            auto c1 = compressedParallel.get_cell( i, j );
+            BOOST_CHECK( std::equal( c0.begin(), c0.end(), expected.begin(), expected.end() ) );
+            BOOST_CHECK( std::equal( c1.begin(), c1.end(), expected.begin(), expected.end() ) );
+        }
+    }
+    BOOST_CHECK( maxPerCell < 32 );
+
+    mesh_2d<double, mesh_traits<compressed_t>> mesh( points, iArray, cmp, [cellSize]( const auto& pts, const auto& ts ) { return compressed_t( pts, ts, cellSize, async_executor() ); } );
+    random_real_generator<> rnd( scale * n );
+    for( int i = 0; i < 1000; ++i )
+    {
+        point2 p( rnd(), rnd() );
+        BOOST_CHECK( unitMesh.find_triangle( p, cmp ) == mesh.find_triangle( p, cmp ) );
+    }
+}
+
+namespace {
+
+    //! A grid of unit quads split into triangles with every third quad in both directions left out as an obstacle.
+    template <typename Mesh = geometrix::mesh_2d<double>>
+    inline Mesh make_mesh_with_obstacles( std::size_t n )
+    {
+        using namespace geometrix;
+        std::vector<point_double_2d> points;
+        for( std::size_t j = 0; j <= n; ++j )
+            for( std::size_t i = 0; i <= n; ++i )
+                points.emplace_back( double( i ), double( j ) );
+
+        std::vector<std::size_t> iArray;
+        for( std::size_t j = 0; j < n; ++j )
+        {
+            for( std::size_t i = 0; i < n; ++i )
+            {
+                if( i % 3 == 1 && j % 3 == 1 )
+                    continue;
+                std::size_t v0 = j * ( n + 1 ) + i, v1 = v0 + 1, v2 = v0 + n + 2, v3 = v0 + n + 1;
+                iArray.insert( iArray.end(), { v0, v1, v2, v0, v2, v3 } );
+            }
+        }
+
+        return Mesh( points, iArray, absolute_tolerance_comparison_policy<double>( 1e-10 ) );
+    }
+
+}//! namespace;
+
+BOOST_AUTO_TEST_CASE( TestMeshSearchWithReusedContext )
+{
+    using namespace geometrix;
+    typedef point_double_2d point2;
+    using search_t = visible_vertices_mesh_search<visible_vertices_mesh_search_traits<double, mesh_2d<double>, absolute_tolerance_comparison_policy<double>>>;
+
+    absolute_tolerance_comparison_policy<double> cmp( 1e-10 );
+    auto mesh = make_mesh_with_obstacles( 15 );
+
+    search_t::context_type context;
+    mesh_search_context<mesh_search_edge_item<point2>> visitorContext;
+    random_real_generator<> rnd( 15. );
+    for( int i = 0; i < 200; ++i )
+    {
+        point2 origin( rnd(), rnd() );
+        auto triangle = mesh.find_triangle( origin, cmp );
+        if( !triangle )
+            continue;
+
+        search_t expected( origin, *triangle, mesh );
+        mesh.search( expected );
+
+        search_t search( origin, *triangle, mesh, context );
+        mesh.search( search, context.get_queue() );
+        BOOST_CHECK( search.get_vertices() == expected.get_vertices() );
+        BOOST_CHECK( context.get_vertices() == expected.get_vertices() );
+
+        auto v = visible_vertices_visitor<point2, mesh_2d<double>>( origin, mesh );
+        auto vExpected = visible_vertices_visitor<point2, mesh_2d<double>>( origin, mesh );
+        mesh.search( make_mesh_search( *triangle, origin, mesh, vExpected ) );
+        mesh.search( make_mesh_search( *triangle, origin, mesh, visitorContext, v ), visitorContext.get_queue() );
+        BOOST_CHECK( v.get_vertices() == vExpected.get_vertices() );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( TestVisibleVerticesBatchSearch )
+{
+    using namespace geometrix;
+    typedef point_double_2d point2;
+    using search_t = visible_vertices_mesh_search<visible_vertices_mesh_search_traits<double, mesh_2d<double>, absolute_tolerance_comparison_policy<double>>>;
+
+    absolute_tolerance_comparison_policy<double> cmp( 1e-10 );
+    auto mesh = make_mesh_with_obstacles( 15 );
+
+    //! Some origins lie outside the mesh or in the obstacles.
+    random_real_generator<> rnd( 17. );
+    std::vector<point2> origins;
+    for( int i = 0; i < 100; ++i )
+        origins.emplace_back( rnd() - 1., rnd() - 1. );
+
+    auto serial = visible_vertices_batch_search( mesh, origins, cmp );
+    auto parallel = visible_vertices_batch_search( mesh, origins, cmp, async_executor(), 7 );
+    BOOST_REQUIRE( serial.size() == origins.size() );
+    BOOST_CHECK( serial.offsets == parallel.offsets );
+    BOOST_CHECK( serial.vertices == parallel.vertices );
+
+    std::size_t nOutside = 0;
+    for( std::size_t i = 0; i < origins.size(); ++i )
+    {
+        std::vector<std::size_t> expected;
+        if( auto triangle = mesh.find_triangle( origins[i], cmp ) )
+        {
+            search_t search( origins[i], *triangle, mesh );
+            mesh.search( search );
+            expected = search.get_vertices();
+        }
+        else
+            ++nOutside;
+
+        BOOST_CHECK( std::equal( serial.begin( i ), serial.end( i ), expected.begin(), expected.end() ) );
+    }
+    BOOST_CHECK( nOutside > 0 );
+}
+
+BOOST_AUTO_TEST_CASE( TestVisibleVerticesBatchSearchSparseCache )
+{
+    using namespace geometrix;
+    typedef point_double_2d point2;
+    using mesh_t = mesh_2d<double, mesh_traits<triangle_grid_cache<double, sparse_grid_type_generator>>>;
+
+    absolute_tolerance_comparison_policy<double> cmp( 1e-10 );
+    auto mesh = make_mesh_with_obstacles<mesh_t>( 15 );
+
+    //! The cell inside the first obstacle holds no triangles so the sparse grid has no entry for it.
+    const auto& grid = *mesh.get_triangle_cache().get_grid();
+    point2 outside( 1.5, 1.5 );
+    BOOST_REQUIRE( grid.is_contained( outside ) );
+    BOOST_REQUIRE( grid.find_cell( outside ) == nullptr );
+
+    random_real_generator<> rnd( 17. );
+    std::vector<point2> origins{ outside };
+    for( int i = 0; i < 100; ++i )
+        origins.emplace_back( rnd() - 1., rnd() - 1. );
+
+    //! Lookups of empty cells from concurrent searches must not insert them.
+    auto serial = visible_vertices_batch_search( mesh, origins, cmp );
+    auto parallel = visible_vertices_batch_search( mesh, origins, cmp, async_executor(), 7 );
+    BOOST_CHECK( serial.offsets == parallel.offsets );
+    BOOST_CHECK( serial.vertices == parallel.vertices );
+    BOOST_CHECK( serial.count( 0 ) == 0 );
+    BOOST_CHECK( grid.find_cell( outside ) == nullptr );
+}
 
 #endif //GEOMETRIX_MESH_2D_TESTS_HPP
@@ -12,6 +12,7 @@
 #include "./3d_kernel_units_fixture.hpp"
 
 #include <geometrix/algorithm/orientation.hpp>
+#include <geometrix/algorithm/exact_predicates.hpp>
 #include <geometrix/algorithm/distance/point_line_distance.hpp>
 
 #include <geometrix/utility/utilities.hpp>
@@ -173,3 +174,68 @@ TEST_F(geometry_kernel_3d_units_fixture, collinear_test_3d_points_true_all_same)
     auto o = is_collinear( c, a, b, cmp );
 	EXPECT_TRUE( o );
 }
+
+TEST_F(geometry_kernel_2d_fixture, exact_orientation_agrees_with_tolerance_orientation_on_well_conditioned_input)
+{
+    using namespace geometrix;
+    exact_predicate_comparison_policy exact;
+
+    auto a = point2{ 0., 0. };
+    auto b = point2{ 4., 4. };
+    auto left = point2{ 1., 3. };
+    auto right = point2{ 3., 1. };
+    auto on = point2{ 2., 2. };
+
+    EXPECT_EQ(get_orientation(a, b, left, exact), oriented_left);
+    EXPECT_EQ(get_orientation(a, b, right, exact), oriented_right);
+    EXPECT_EQ(get_orientation(a, b, on, exact), oriented_collinear);
+    for (auto p : { left, right, on })
+    {
+        EXPECT_EQ(get_orientation(a, b, p, exact), get_orientation(a, b, p, cmp));
+        EXPECT_EQ(point_segment_orientation(p, a, b, exact), point_segment_orientation(p, a, b, cmp));
+        EXPECT_EQ(get_orientation(b - a, p - a, exact), get_orientation(b - a, p - a, cmp));
+        EXPECT_EQ(vector_vector_orientation(b - a, p - a, exact), vector_vector_orientation(b - a, p - a, cmp));
+    }
+}
+
+TEST_F(geometry_kernel_2d_fixture, exact_orientation_is_consistent_for_nearly_collinear_points)
+{
+    using namespace geometrix;
+    exact_predicate_comparison_policy exact;
+
+    //! Points on a grid of ulps around (0.5, 0.5) tested against the line through (12, 12) and (24, 24).
+    //! Floating point evaluation classifies these inconsistently; the exact predicate classifies by the diagonal.
+    auto b = point2{ 12., 12. };
+    auto c = point2{ 24., 24. };
+    auto ulp = std::ldexp(1.0, -53);
+    for (int i = 0; i < 64; ++i)
+    {
+        for (int j = 0; j < 64; ++j)
+        {
+            auto p = point2{ 0.5 + i * ulp, 0.5 + j * ulp };
+            auto expected = i == j ? oriented_collinear : (j > i ? oriented_left : oriented_right);
+            EXPECT_EQ(point_segment_orientation(p, b, c, exact), expected);
+            EXPECT_EQ(get_orientation(b, c, p, exact), expected);
+        }
+    }
+}
+
+TEST_F(geometry_kernel_2d_fixture, exact_point_in_circumcircle)
+{
+    using namespace geometrix;
+    exact_predicate_comparison_policy exact;
+
+    auto a = point2{ 1., 0. };
+    auto b = point2{ 0., 1. };
+    auto c = point2{ -1., 0. };
+
+    EXPECT_EQ(point_in_circumcircle(a, b, c, point2{ 0., 0. }, exact), point_circle_orientation::inside);
+    EXPECT_EQ(point_in_circumcircle(a, b, c, point2{ 0., -1. }, exact), point_circle_orientation::cocircular);
+    EXPECT_EQ(point_in_circumcircle(a, b, c, point2{ 2., 2. }, exact), point_circle_orientation::outside);
+    EXPECT_EQ(point_in_circumcircle(a, b, c, point2{ 0., 0. }, cmp), point_circle_orientation::inside);
+    EXPECT_EQ(point_in_circumcircle(a, b, c, point2{ 2., 2. }, cmp), point_circle_orientation::outside);
+
+    //! Just outside the unit circle by one ulp.
+    auto p = point2{ 0., -(1.0 + std::ldexp(1.0, -52)) };
+    EXPECT_EQ(point_in_circumcircle(a, b, c, p, exact), point_circle_orientation::outside);
+}
@@ -910,6 +910,338 @@ BOOST_FIXTURE_TEST_CASE(polyline_self_intersection_tests, geometry_kernel_2d_fix
 	}
 }
 
+#include <geometrix/utility/random_generator.hpp>
+namespace {
+
+	//! segment_segment_intersection reports a zero length segment as overlapping any collinear segment, even one it does not touch.
+	//! The sweep only considers segments whose bounds meet so the references skip pairs with disjoint bounds.
+	template <typename Point, typename NumberComparisonPolicy>
+	inline bool segment_bounds_overlap( const Point& a, const Point& b, const Point& c, const Point& d, const NumberComparisonPolicy& cmp )
+	{
+		using namespace geometrix;
+		auto overlap = [&cmp]( double a0, double a1, double b0, double b1 )
+		{
+			return !cmp.less_than( (std::max)( a0, a1 ), (std::min)( b0, b1 ) ) && !cmp.less_than( (std::max)( b0, b1 ), (std::min)( a0, a1 ) );
+		};
+		return overlap( get<0>( a ), get<0>( b ), get<0>( c ), get<0>( d ) ) && overlap( get<1>( a ), get<1>( b ), get<1>( c ), get<1>( d ) );
+	}
+
+	template <typename Polyline, typename NumberComparisonPolicy>
+	inline std::vector<std::tuple<std::size_t, std::size_t, geometrix::intersection_type>> brute_force_self_intersection( const Polyline& poly, const NumberComparisonPolicy& cmp )
+	{
+		using namespace geometrix;
+		typedef typename point_sequence_traits<Polyline>::point_type point_type;
+		std::vector<std::tuple<std::size_t, std::size_t, intersection_type>> result;
+		for (std::size_t i = 0; i + 2 < poly.size(); ++i)
+		{
+			for (std::size_t j = i + 1; (j + 1) < poly.size(); ++j)
+			{
+				if (!segment_bounds_overlap( poly[i], poly[i + 1], poly[j], poly[j + 1], cmp ))
+					continue;
+				point_type xPoints[2];
+				auto iType = segment_segment_intersection( poly[i], poly[i + 1], poly[j], poly[j + 1], xPoints, cmp );
+				if (iType != e_non_crossing && (j != i + 1 || iType == e_overlapping))
+					result.emplace_back( i, j, iType );
+			}
+		}
+		return result;
+	}
+
+	template <typename Polygon, typename NumberComparisonPolicy>
+	inline bool brute_force_is_polygon_simple( const Polygon& poly, const NumberComparisonPolicy& cmp )
+	{
+		using namespace geometrix;
+		typedef typename point_sequence_traits<Polygon>::point_type point_type;
+		std::size_t size = poly.size();
+		for (std::size_t i = 0; i < size; ++i)
+			for (std::size_t j = i + 2; j < size; ++j)
+				if ((j + 1) % size != i && segment_bounds_overlap( poly[i], poly[(i + 1) % size], poly[j], poly[(j + 1) % size], cmp ) && segment_segment_intersection( poly[i], poly[(i + 1) % size], poly[j], poly[(j + 1) % size], (point_type*)nullptr, cmp ) != e_non_crossing)
+					return false;
+		return true;
+	}
+
+}
+
+BOOST_FIXTURE_TEST_CASE(polyline_self_intersection_matches_brute_force, geometry_kernel_2d_fixture)
+{
+	using namespace geometrix;
+	random_real_generator<> rnd( 100.0 );
+
+	for (int trial = 0; trial < 50; ++trial)
+	{
+		//! Random walks with some repeated vertices and axis aligned steps to exercise the degenerate cases.
+		polyline2 poly{ point2{ 50., 50. } };
+		std::size_t n = 5 + trial * 4;
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			point2 p = poly.back();
+			double r = rnd();
+			if (r < 10.)
+				poly.push_back( p );
+			else if (r < 30.)
+				poly.push_back( point2{ get<0>( p ), std::floor( rnd() ) } );
+			else if (r < 50.)
+				poly.push_back( point2{ std::floor( rnd() ), get<1>( p ) } );
+			else
+				poly.push_back( point2{ rnd(), rnd() } );
+		}
+
+		auto expected = brute_force_self_intersection( poly, cmp );
+		std::vector<std::tuple<std::size_t, std::size_t, intersection_type>> found;
+		bool result = polyline_self_intersection( poly, [&found]( std::size_t i, std::size_t j, intersection_type iType, const point2&, const point2& ) { found.emplace_back( i, j, iType ); }, cmp );
+		BOOST_CHECK( found == expected );
+		BOOST_CHECK( result == !expected.empty() );
+		BOOST_CHECK( is_polyline_simple( poly, cmp ) == expected.empty() );
+
+		polygon2 pgon( poly.begin(), poly.end() );
+		BOOST_CHECK( is_polygon_simple( pgon, cmp ) == brute_force_is_polygon_simple( pgon, cmp ) );
+	}
+
+	//! A large polygon with a slightly crenellated boundary is simple; moving one vertex across the center makes it complex.
+	{
+		const std::size_t n = 50000;
+		polygon2 pgon;
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			double theta = constants::two_pi<double>() * i / n;
+			double radius = (i % 2) ? 10.0 : 10.001;
+			pgon.push_back( point2{ radius * std::cos( theta ), radius * std::sin( theta ) } );
+		}
+		BOOST_CHECK( is_polygon_simple( pgon, cmp ) );
+		BOOST_CHECK( is_polygon_simple_memoized( pgon, cmp ) );
+		polyline2 pline( pgon.begin(), pgon.end() );
+		BOOST_CHECK( is_polyline_simple( pline, cmp ) );
+
+		pgon[n / 2] = point2{ 12.0, 0.5 };
+		BOOST_CHECK( !is_polygon_simple( pgon, cmp ) );
+	}
+}
+
+#include <geometrix/algorithm/intersection/polyline_polyline_intersection.hpp>
+BOOST_FIXTURE_TEST_CASE(polyline_sets_intersect_matches_brute_force, geometry_kernel_2d_fixture)
+{
+	using namespace geometrix;
+	random_real_generator<> rnd( 100.0 );
+
+	auto random_walk = [&rnd]( std::size_t n )
+	{
+		polyline2 poly{ point2{ rnd(), rnd() } };
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			point2 p = poly.back();
+			double r = rnd();
+			if (r < 10.)
+				poly.push_back( p );
+			else if (r < 30.)
+				poly.push_back( point2{ get<0>( p ), std::floor( rnd() ) } );
+			else
+				poly.push_back( point2{ get<0>( p ) + (rnd() - 50.) / 5., get<1>( p ) + (rnd() - 50.) / 5. } );
+		}
+		return poly;
+	};
+
+	std::vector<polyline2> As, Bs;
+	for (std::size_t i = 0; i < 40; ++i)
+		As.push_back( random_walk( 1 + i % 20 ) );
+	for (std::size_t i = 0; i < 60; ++i)
+		Bs.push_back( random_walk( i % 30 ) );
+
+	typedef std::tuple<std::size_t, std::size_t, std::size_t, std::size_t, intersection_type> crossing;
+	std::vector<crossing> expected;
+	for (std::size_t a = 0; a < As.size(); ++a)
+		for (std::size_t i = 0; i + 1 < As[a].size(); ++i)
+			for (std::size_t b = 0; b < Bs.size(); ++b)
+				for (std::size_t j = 0; j + 1 < Bs[b].size(); ++j)
+				{
+					if (!segment_bounds_overlap( As[a][i], As[a][i + 1], Bs[b][j], Bs[b][j + 1], cmp ))
+						continue;
+					auto iType = segment_segment_intersection( As[a][i], As[a][i + 1], Bs[b][j], Bs[b][j + 1], (point2*)nullptr, cmp );
+					if (iType != e_non_crossing)
+						expected.emplace_back( a, i, b, j, iType );
+				}
+
+	std::vector<crossing> found;
+	auto visitor = [&found]( std::size_t a, std::size_t b, intersection_type iType, std::size_t i1, std::size_t j1, std::size_t i2, std::size_t j2, const point2&, const point2& )
+	{
+		BOOST_CHECK( j1 == i1 + 1 && j2 == i2 + 1 );
+		found.emplace_back( a, i1, b, i2, iType );
+		return false;
+	};
+	BOOST_CHECK( polyline_sets_intersect( As, Bs, visitor, cmp ) == !expected.empty() );
+	BOOST_CHECK( !expected.empty() );
+	BOOST_CHECK( found == expected );
+
+	found.clear();
+	BOOST_CHECK( polyline_sets_intersect( As, Bs, visitor, cmp, async_executor(), 3 ) == !expected.empty() );
+	BOOST_CHECK( found == expected );
+
+	//! Stop at the first crossing.
+	std::size_t count = 0;
+	BOOST_CHECK( polyline_sets_intersect( As, Bs, [&count]( std::size_t, std::size_t, intersection_type, std::size_t, std::size_t, std::size_t, std::size_t, const point2&, const point2& ) { return ++count > 0; }, cmp ) );
+	BOOST_CHECK( count == 1 );
+}
+
+#include <geometrix/algorithm/point_sequence/prepared_point_sequence.hpp>
+BOOST_FIXTURE_TEST_CASE(prepared_polygon_containment_matches_linear, geometry_kernel_2d_fixture)
+{
+	using namespace geometrix;
+	random_real_generator<> rnd( 1.0 );
+
+	for (std::size_t n : { 3, 4, 17, 100, 1000 })
+	{
+		//! Star shaped polygons with vertices on integer coordinates so that many queries land exactly on vertices and edges.
+		polygon2 pgon;
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			double theta = 2.0 * constants::pi<double>() * i / n;
+			double r = 20.0 + 80.0 * rnd();
+			pgon.push_back( point2{ std::round( r * std::cos( theta ) ), std::round( r * std::sin( theta ) ) } );
+		}
+
+		std::vector<point2> points;
+		for (std::size_t i = 0; i < 2000; ++i)
+			points.push_back( point2{ std::round( 220.0 * rnd() - 110.0 ), std::round( 220.0 * rnd() - 110.0 ) } );
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			points.push_back( pgon[i] );
+			points.push_back( point2{ 0.5 * (get<0>( pgon[i] ) + get<0>( pgon[(i + 1) % n] )), 0.5 * (get<1>( pgon[i] ) + get<1>( pgon[(i + 1) % n] )) } );
+		}
+
+		auto prepared = make_prepared_polygon( pgon );
+		BOOST_CHECK( prepared.number_of_rows() > 0 );
+		for (const auto& p : points)
+		{
+			BOOST_CHECK( point_in_polygon( p, prepared ) == point_in_polygon( p, pgon ) );
+			BOOST_CHECK( point_polygon_containment_or_on_border( p, prepared, cmp ) == point_polygon_containment_or_on_border( p, pgon, cmp ) );
+		}
+
+		std::vector<polygon_containment> expected, serial, parallel( points.size() );
+		for (const auto& p : points)
+			expected.push_back( point_polygon_containment_or_on_border( p, pgon, cmp ) );
+		prepared.containment( points, std::back_inserter( serial ), cmp );
+		prepared.containment( points, parallel.begin(), cmp, async_executor(), 100 );
+		BOOST_CHECK( serial == expected );
+		BOOST_CHECK( parallel == expected );
+	}
+}
+
+#include <geometrix/algorithm/polygon_index.hpp>
+BOOST_FIXTURE_TEST_CASE(polygon_index_queries_match_brute_force, geometry_kernel_2d_fixture)
+{
+	using namespace geometrix;
+	random_real_generator<> rnd( 1.0 );
+
+	//! Star shaped zones of various sizes on integer coordinates so that queries land on borders. Every third zone has a square hole.
+	auto make_star = [&rnd]( double cx, double cy, double radius, std::size_t n )
+	{
+		polygon2 pgon;
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			double theta = 2.0 * constants::pi<double>() * i / n;
+			double r = radius * (0.5 + 0.5 * rnd());
+			pgon.push_back( point2{ std::round( cx + r * std::cos( theta ) ), std::round( cy + r * std::sin( theta ) ) } );
+		}
+		return pgon;
+	};
+
+	std::vector<polygon_with_holes2> zones;
+	for (std::size_t i = 0; i < 500; ++i)
+	{
+		double cx = std::round( 1000.0 * rnd() ), cy = std::round( 1000.0 * rnd() ), radius = 10.0 + 60.0 * rnd();
+		polygon_with_holes2 zone( make_star( cx, cy, radius, i % 3 == 0 ? 8 + i % 8 : 3 + i % 12 ) );
+		if (i % 3 == 0)
+			zone.add_hole( polygon2{ point2{ cx - 1, cy - 1 }, point2{ cx - 1, cy + 1 }, point2{ cx + 1, cy + 1 }, point2{ cx + 1, cy - 1 } } );
+		zones.push_back( zone );
+	}
+
+	polygon_index<std::vector<polygon_with_holes2>> index( zones, 4 );
+	polygon_index<std::vector<polygon_with_holes2>> parallelIndex( zones, async_executor(), 4, 50 );
+	BOOST_CHECK( index.size() == zones.size() );
+	BOOST_CHECK( index.number_of_levels() == 6 );
+	for (std::size_t i = 0; i < zones.size(); ++i)
+		BOOST_CHECK( numeric_sequence_equals( index.get_bounds( i ).get_lower_bound(), parallelIndex.get_bounds( i ).get_lower_bound(), cmp ) );
+
+	auto sorted = []( std::vector<std::size_t> v ) { std::sort( v.begin(), v.end() ); return v; };
+
+	//! A box meets a zone when it meets the outer polygon and does not lie strictly inside a hole. The holes are squares so a box
+	//! lies strictly inside one when all its corners do.
+	auto box_meets_zone = [this]( const aabb2& box, const polygon_with_holes2& zone )
+	{
+		if (!polygon_aabb_intersection( zone.get_outer(), box ))
+			return false;
+		for (const auto& hole : zone.get_holes())
+		{
+			bool inside = true;
+			for (std::size_t c = 0; c < 4 && inside; ++c)
+				inside = point_polygon_containment_or_on_border( box[c], hole, cmp ) == polygon_containment::interior;
+			if (inside)
+				return false;
+		}
+		return true;
+	};
+	auto search_box = [&]( const aabb2& box )
+	{
+		std::vector<std::size_t> expected, found;
+		for (std::size_t i = 0; i < zones.size(); ++i)
+			if (box_meets_zone( box, zones[i] ))
+				expected.push_back( i );
+		index.search( box, [&found]( std::size_t i ) { found.push_back( i ); } );
+		found = sorted( found );
+		BOOST_CHECK( found == expected );
+		return found;
+	};
+
+	for (std::size_t q = 0; q < 2000; ++q)
+	{
+		point2 p{ std::round( 1100.0 * rnd() - 50.0 ), std::round( 1100.0 * rnd() - 50.0 ) };
+
+		std::vector<std::size_t> expected, expectedOnBorder, found, foundOnBorder;
+		for (std::size_t i = 0; i < zones.size(); ++i)
+		{
+			if (point_in_polygon( p, zones[i] ))
+				expected.push_back( i );
+			if (point_polygon_containment_or_on_border( p, zones[i], cmp ) != polygon_containment::exterior)
+				expectedOnBorder.push_back( i );
+		}
+		index.stab( p, [&found]( std::size_t i ) { found.push_back( i ); } );
+		index.stab( p, [&foundOnBorder]( std::size_t i ) { foundOnBorder.push_back( i ); }, cmp );
+		BOOST_CHECK( sorted( found ) == expected );
+		BOOST_CHECK( sorted( foundOnBorder ) == expectedOnBorder );
+		BOOST_CHECK( index.find_containing( p, cmp ) == expectedOnBorder );
+
+		point2 p2{ get<0>( p ) + 80.0 * rnd() - 40.0, get<1>( p ) + 80.0 * rnd() - 40.0 };
+		aabb2 box( point2{ (std::min)( get<0>( p ), get<0>( p2 ) ), (std::min)( get<1>( p ), get<1>( p2 ) ) }, point2{ (std::max)( get<0>( p ), get<0>( p2 ) ), (std::max)( get<1>( p ), get<1>( p2 ) ) } );
+		search_box( box );
+
+		segment2 seg( p, p2 );
+		std::vector<std::size_t> expectedSegment, foundSegment;
+		for (std::size_t i = 0; i < zones.size(); ++i)
+		{
+			auto crosses = [&]( const polygon2& ring ) { return segment_polygon_border_intersect( seg, ring, []( intersection_type, std::size_t, std::size_t, const point2&, const point2& ) { return true; }, cmp ); };
+			bool meets = crosses( zones[i].get_outer() ) || point_polygon_containment_or_on_border( p, zones[i], cmp ) != polygon_containment::exterior;
+			for (const auto& hole : zones[i].get_holes())
+				meets = meets || crosses( hole );
+			if (meets)
+				expectedSegment.push_back( i );
+		}
+		index.search( seg, [&foundSegment]( std::size_t i ) { foundSegment.push_back( i ); }, cmp );
+		BOOST_CHECK( sorted( foundSegment ) == expectedSegment );
+	}
+
+	//! A point in a hole is not in the zone but a point on the hole's border is on the zone's border.
+	const auto& zone = zones[0];
+	point2 centre{ get<0>( zone.get_holes()[0][0] ) + 1, get<1>( zone.get_holes()[0][0] ) + 1 };
+	BOOST_CHECK( !point_in_polygon( centre, zone ) );
+	BOOST_CHECK( point_polygon_containment_or_on_border( centre, zone, cmp ) == polygon_containment::exterior );
+	BOOST_CHECK( point_polygon_containment_or_on_border( zone.get_holes()[0][0], zone, cmp ) == polygon_containment::vertex );
+
+	//! A box strictly inside the hole misses the zone while one which reaches the hole's border meets it.
+	auto inHole = search_box( aabb2( point2{ get<0>( centre ) - 0.5, get<1>( centre ) - 0.5 }, point2{ get<0>( centre ) + 0.5, get<1>( centre ) + 0.5 } ) );
+	BOOST_CHECK( std::find( inHole.begin(), inHole.end(), 0 ) == inHole.end() );
+	auto onHoleBorder = search_box( aabb2( point2{ get<0>( centre ) - 1.0, get<1>( centre ) - 0.5 }, point2{ get<0>( centre ) + 0.5, get<1>( centre ) + 0.5 } ) );
+	BOOST_CHECK( std::find( onHoleBorder.begin(), onHoleBorder.end(), 0 ) != onHoleBorder.end() );
+}
+
 #include <geometrix/algorithm/point_sequence/polyline_offset.hpp>
 #include <iostream>
 BOOST_FIXTURE_TEST_CASE(polyline_offset_tests, geometry_kernel_2d_fixture)
@@ -26,6 +26,9 @@
 #include <geometrix/utility/ignore_unused_warnings.hpp>
 
 #include <iostream>
+#include <map>
+#include <random>
+#include <set>
 
 typedef geometrix::point_double_2d point2;
 typedef geometrix::vector_double_2d vector2;
@@ -147,6 +150,65 @@ BOOST_AUTO_TEST_CASE( TestBentleyOttmannSegmentIntersection )
 
 }
 
+BOOST_AUTO_TEST_CASE( TestBentleyOttmannMatchesBruteForce )
+{
+	using namespace geometrix;
+
+	typedef point_double_2d point_2d;
+	typedef segment<point_2d> segment_2d;
+	typedef std::pair<std::pair<double, double>, std::pair<double, double>> segment_key;
+
+	absolute_tolerance_comparison_policy<double> cmp( 1e-10 );
+	std::mt19937 gen( 42 );
+	std::uniform_real_distribution<double> coord( 0.0, 100.0 ), angle( 0.0, 6.283185307179586 ), length( 1.0, 10.0 );
+
+	std::vector<segment_2d> segments;
+	for( std::size_t i = 0; i < 1000; ++i )
+	{
+		point_2d a( coord( gen ), coord( gen ) );
+		double l = length( gen ), t = angle( gen );
+		segments.emplace_back( a, point_2d( get<0>( a ) + l * std::cos( t ), get<1>( a ) + l * std::sin( t ) ) );
+	}
+
+	//! The sweep copies and reorients the segments so identify them by their sorted end points.
+	auto make_key = []( const segment_2d& s )
+	{
+		auto a = std::make_pair( get<0>( s.get_start() ), get<1>( s.get_start() ) );
+		auto b = std::make_pair( get<0>( s.get_end() ), get<1>( s.get_end() ) );
+		return segment_key( (std::min)( a, b ), (std::max)( a, b ) );
+	};
+	std::map<segment_key, std::size_t> index;
+	for( std::size_t i = 0; i < segments.size(); ++i )
+		index[make_key( segments[i] )] = i;
+
+	std::set<std::pair<std::size_t, std::size_t>> expected, found;
+	for( std::size_t i = 0; i < segments.size(); ++i )
+	{
+		for( std::size_t j = i + 1; j < segments.size(); ++j )
+		{
+			point_2d xPoints[2];
+			if( segment_segment_intersection( segments[i], segments[j], xPoints, cmp ) != e_non_crossing )
+				expected.insert( std::make_pair( i, j ) );
+		}
+	}
+
+	auto visitor = [&]( const point_2d&, auto first, auto last )
+	{
+		for( auto it = first; it != last; ++it )
+		{
+			for( auto it2 = std::next( it ); it2 != last; ++it2 )
+			{
+				std::size_t i = index[make_key( **it )], j = index[make_key( **it2 )];
+				found.insert( std::make_pair( (std::min)( i, j ), (std::max)( i, j ) ) );
+			}
+		}
+	};
+	bentley_ottmann_segment_intersection( segments, visitor, cmp );
+
+	BOOST_CHECK( !expected.empty() );
+	BOOST_CHECK( expected == found );
+}
+
 BOOST_AUTO_TEST_CASE( TestIsSegmentInRange )
 {
 	using namespace geometrix;
@@ -16,8 +16,11 @@
 #include <geometrix/arithmetic/vector.hpp>
 #include <geometrix/algebra/algebra.hpp>
 #include <geometrix/utility/concept.hpp>
+#include <geometrix/utility/scope_timer.ipp>
 
 #include <iostream>
+#include <sstream>
+#include <thread>
 
 BOOST_AUTO_TEST_CASE( TestUtilityOperators )
 {
@@ -177,4 +180,118 @@ BOOST_AUTO_TEST_CASE(test_concept_all)
 	static_assert(geometrix::all_true<fusion_dimensionless_vector, geometrix::is_dimensionless<boost::mpl::_>>::value, "fusion_dimensionless_vector is dimensionless");
 }
 
+BOOST_AUTO_TEST_CASE(TestScopeTimerAggregatesAcrossThreads)
+{
+	using namespace geometrix;
+
+	auto find = [](const std::vector<scope_timer_record>& records, const std::string& name) -> const scope_timer_record*
+	{
+		for (const auto& r : records)
+			if (r.name == name)
+				return &r;
+		return nullptr;
+	};
+
+	const std::size_t nThreads = 4;
+	const std::size_t nCalls = 1000;
+	std::vector<std::thread> threads;
+	for (std::size_t i = 0; i < nThreads; ++i)
+	{
+		threads.emplace_back([=]()
+		{
+			std::string dynamicName = "utility_tests.dynamic";
+			for (std::size_t j = 0; j < nCalls; ++j)
+			{
+				{
+					GEOMETRIX_MEASURE_SCOPE_TIME("utility_tests.literal");
+				}
+				{
+					GEOMETRIX_MEASURE_SCOPE_TIME(dynamicName);
+				}
+			}
+		});
+	}
+
+	//! Snapshots may be taken while other threads record.
+	scope_timer_snapshot();
+
+	for (auto& t : threads)
+		t.join();
+
+	{
+		GEOMETRIX_MEASURE_SCOPE_TIME("utility_tests.literal");
+	}
+
+	auto records = scope_timer_snapshot();
+	auto literal = find(records, "utility_tests.literal");
+	auto dynamic = find(records, "utility_tests.dynamic");
+	BOOST_REQUIRE(literal != nullptr);
+	BOOST_REQUIRE(dynamic != nullptr);
+	BOOST_CHECK_EQUAL(literal->counts, nThreads * nCalls + 1);
+	BOOST_CHECK_EQUAL(dynamic->counts, nThreads * nCalls);
+	BOOST_CHECK(literal->min_time <= literal->mean_time && literal->mean_time <= literal->max_time);
+	BOOST_CHECK(literal->total_time >= literal->max_time);
+
+	std::stringstream ss;
+	scope_timer_detail::call_map::instance().write(ss);
+	BOOST_CHECK(ss.str().find("\"utility_tests.literal\"," + std::to_string(nThreads * nCalls + 1)) != std::string::npos);
+	BOOST_CHECK(literal->percentile_time(0.5) <= literal->percentile_time(0.99));
+	BOOST_CHECK(literal->min_time <= literal->percentile_time(0.0) && literal->percentile_time(1.0) <= literal->max_time);
+}
+
+BOOST_AUTO_TEST_CASE(TestScopeTimerCallTreeAndTrace)
+{
+	using namespace geometrix;
+
+	set_scope_timer_features(scope_timer_call_tree | scope_timer_trace_events);
+	auto work = []()
+	{
+		GEOMETRIX_MEASURE_SCOPE_TIME("utility_tests.outer");
+		for (int i = 0; i < 3; ++i)
+		{
+			GEOMETRIX_MEASURE_SCOPE_TIME("utility_tests.inner");
+			GEOMETRIX_MEASURE_SCOPE_TIME("utility_tests.leaf");
+		}
+	};
+
+	std::thread t(work);
+	work();
+	t.join();
+	set_scope_timer_features(0);
+
+	auto nodes = scope_timer_call_tree_snapshot();
+	std::size_t outer = scope_timer_call_node::npos, inner = scope_timer_call_node::npos, leaf = scope_timer_call_node::npos;
+	for (std::size_t i = 0; i < nodes.size(); ++i)
+	{
+		if (nodes[i].stats.name == "utility_tests.outer")
+			outer = i;
+		else if (nodes[i].stats.name == "utility_tests.inner")
+			inner = i;
+		else if (nodes[i].stats.name == "utility_tests.leaf")
+			leaf = i;
+	}
+
+	BOOST_REQUIRE(outer != scope_timer_call_node::npos && inner != scope_timer_call_node::npos && leaf != scope_timer_call_node::npos);
+	BOOST_CHECK(nodes[outer].parent == scope_timer_call_node::npos);
+	BOOST_CHECK_EQUAL(nodes[inner].parent, outer);
+	BOOST_CHECK_EQUAL(nodes[leaf].parent, inner);
+	BOOST_CHECK_EQUAL(nodes[leaf].depth, 2u);
+	BOOST_CHECK_EQUAL(nodes[outer].stats.counts, 2u);
+	BOOST_CHECK_EQUAL(nodes[leaf].stats.counts, 6u);
+	BOOST_CHECK(nodes[inner].stats.total_time <= nodes[outer].stats.total_time);
+
+	std::stringstream trace;
+	scope_timer_detail::call_map::instance().write_chrome_trace(trace);
+	std::string json = trace.str();
+	BOOST_CHECK(json.find("{\"traceEvents\":[") == 0);
+	std::size_t nLeafEvents = 0;
+	for (auto pos = json.find("\"utility_tests.leaf\""); pos != std::string::npos; pos = json.find("\"utility_tests.leaf\"", pos + 1))
+		++nLeafEvents;
+	BOOST_CHECK_EQUAL(nLeafEvents, 6u);
+
+	std::stringstream tree;
+	scope_timer_detail::call_map::instance().write_call_tree(tree);
+	BOOST_CHECK(tree.str().find("\"utility_tests.outer/utility_tests.inner/utility_tests.leaf\",6,") != std::string::npos);
+}
+
 #endif //GEOMETRIX_UTILITY_TESTS_HPP